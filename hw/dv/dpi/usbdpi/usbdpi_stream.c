@@ -22,6 +22,9 @@
       (uint8_t)((lfsr) << 1) ^ \
       ((((lfsr) >> 1) ^ ((lfsr) >> 2) ^ ((lfsr) >> 3) ^ ((lfsr) >> 7)) & 1U))
 
+// Advance the LFSR by four steps, using the lookup table
+#define LFSR_ADVANCE4(lfsr) LFSR_ADVANCE((uint8_t)(lfsr_words[lfsr] >> 24))
+
 // Stream signature words
 #define STREAM_SIGNATURE_HEAD 0x579EA01AU
 #define STREAM_SIGNATURE_TAIL 0x160AE975U
@@ -36,6 +39,23 @@ static const bool verbose = false;
 // Single letter prefix indicating the transfer type
 static const char xfr_sym[] = {'C', 'X', 'B', 'I'};
 
+// For each LFSR state, the next four bytes of LFSR output packed in little
+// endian order; this permits data to be generated and checked a word at a time
+static uint32_t lfsr_words[0x100U];
+
+// Populate the LFSR lookup table
+static void lfsr_words_init(void);
+
+// Generate LFSR output, returning the updated LFSR state
+static uint8_t lfsr_gen(uint8_t lfsr, uint8_t *dp, unsigned len);
+
+// Combine data with LFSR output, returning the updated LFSR state
+static uint8_t lfsr_combine(uint8_t lfsr, uint8_t *dp, const uint8_t *sp,
+                            unsigned len);
+
+// Number of data packets held by the stream, awaiting return to the device
+static inline unsigned stream_pkts(const usbdpi_stream_t *s);
+
 // Determine the next stream for which IN data packets shall be requested
 static inline unsigned in_stream_next(usbdpi_ctx_t *ctx);
 
@@ -48,15 +68,17 @@ static bool stream_data_check(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
                               bool accept);
 
 // Generate a data packet as if it had been received from the device
-static usbdpi_transfer_t *stream_data_gen(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
-                                          unsigned len);
+static void stream_data_gen(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
+                            unsigned len);
 
-// Check a data packet received from the test software (usbdev_stream_test)
-// and collect the data, combined with our LFSR-generated random stream,
-// for later transmission back to the device
-static usbdpi_transfer_t *stream_data_process(usbdpi_ctx_t *ctx,
-                                              usbdpi_stream_t *s,
-                                              usbdpi_transfer_t *rx);
+// Collect the data from a received packet, combined with our LFSR-generated
+// random stream, for later transmission back to the device
+static void stream_data_process(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
+                                usbdpi_transfer_t *rx);
+
+// Construct an OUT data packet from the oldest packet held by the stream
+static usbdpi_transfer_t *stream_data_send(usbdpi_ctx_t *ctx,
+                                           usbdpi_stream_t *s);
 
 // Check the stream signature
 static bool stream_sig_check(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
@@ -82,6 +104,54 @@ inline unsigned out_stream_next(usbdpi_ctx_t *ctx) {
   return id;
 }
 
+// Populate the LFSR lookup table
+void lfsr_words_init(void) {
+  for (unsigned idx = 0U; idx < 0x100U; idx++) {
+    uint8_t lfsr = (uint8_t)idx;
+    uint32_t w = 0U;
+    for (unsigned sh = 0U; sh < 32U; sh += 8U) {
+      w |= (uint32_t)lfsr << sh;
+      lfsr = LFSR_ADVANCE(lfsr);
+    }
+    lfsr_words[idx] = w;
+  }
+}
+
+// Generate LFSR output, returning the updated LFSR state
+uint8_t lfsr_gen(uint8_t lfsr, uint8_t *dp, unsigned len) {
+  while (len >= 4U) {
+    dp = set_le32(dp, lfsr_words[lfsr]);
+    lfsr = LFSR_ADVANCE4(lfsr);
+    len -= 4U;
+  }
+  while (len-- > 0U) {
+    *dp++ = lfsr;
+    lfsr = LFSR_ADVANCE(lfsr);
+  }
+  return lfsr;
+}
+
+// Combine data with LFSR output, returning the updated LFSR state
+uint8_t lfsr_combine(uint8_t lfsr, uint8_t *dp, const uint8_t *sp,
+                     unsigned len) {
+  while (len >= 4U) {
+    dp = set_le32(dp, get_le32(sp) ^ lfsr_words[lfsr]);
+    lfsr = LFSR_ADVANCE4(lfsr);
+    sp += 4;
+    len -= 4U;
+  }
+  while (len-- > 0U) {
+    *dp++ = *sp++ ^ lfsr;
+    lfsr = LFSR_ADVANCE(lfsr);
+  }
+  return lfsr;
+}
+
+// Number of data packets held by the stream, awaiting return to the device
+inline unsigned stream_pkts(const usbdpi_stream_t *s) {
+  return (uint8_t)(s->pkt_wr - s->pkt_rd);
+}
+
 // Initialize streaming state for the given number of streams
 bool streams_init(usbdpi_ctx_t *ctx, unsigned nstreams,
                   const uint8_t xfr_types[], bool retrieve, bool checking,
@@ -100,6 +170,9 @@ bool streams_init(usbdpi_ctx_t *ctx, unsigned nstreams,
            send ? 'Y' : 'N');
   }
 
+  // Prepare for word-at-a-time LFSR generation and checking
+  lfsr_words_init();
+
   // Remember the number of streams and initialize the arbitration of
   // IN and OUT traffic
   ctx->nstreams = nstreams;
@@ -129,12 +202,24 @@ bool streams_init(usbdpi_ctx_t *ctx, unsigned nstreams,
     // LFSR state for this byte stream
     ctx->stream[id].tst_lfsr = USBTST_LFSR_SEED(id);
     ctx->stream[id].dpi_lfsr = USBDPI_LFSR_SEED(id);
-    ctx->stream[id].dpi_rewind_lfsr = ctx->stream[id].dpi_lfsr;
     // LFSR-controlled packet retrying state
     ctx->stream[id].retry_lfsr = RETRY_LFSR_SEED(id);
     ctx->stream[id].nretries = 0U;
+    // Number of packets that may be held awaiting return to the device, and
+    // the number of consecutive packets per stream; Isochronous endpoints
+    // transfer at most a single packet per bus frame
+    ctx->stream[id].in_depth = (USBDPI_STREAM_IN_DEPTH < USBDPI_STREAM_MAX_PKTS)
+                                   ? USBDPI_STREAM_IN_DEPTH
+                                   : USBDPI_STREAM_MAX_PKTS;
+    ctx->stream[id].burst =
+        (xfr_types[id] == USB_TRANSFER_TYPE_ISOCHRONOUS || !USBDPI_STREAM_BURST)
+            ? 1U
+            : USBDPI_STREAM_BURST;
+    ctx->stream[id].in_run = 0U;
+    ctx->stream[id].out_run = 0U;
     // No received packets
-    ctx->stream[id].received = NULL;
+    ctx->stream[id].pkt_rd = 0U;
+    ctx->stream[id].pkt_wr = 0U;
   }
   return true;
 }
@@ -197,6 +282,14 @@ bool stream_data_check(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
         // Note: use a local copy of the LFSR so that we can check the data
         //       field even on those packets that we choose to reject
         uint8_t tst_lfsr = s->tst_lfsr;
+        // Check whole words against the lookup table, falling back to
+        // byte-by-byte checking for any mismatch so that every mismatched
+        // byte is reported
+        while (num_bytes >= 4U && get_le32(sp) == lfsr_words[tst_lfsr]) {
+          tst_lfsr = LFSR_ADVANCE4(tst_lfsr);
+          sp += 4;
+          num_bytes -= 4U;
+        }
         while (num_bytes-- > 0U) {
           uint8_t recvd = *sp++;
           if (recvd != tst_lfsr) {
@@ -225,57 +318,52 @@ bool stream_data_check(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
 }
 
 // Generate a data packet as if it had been received from the device
-usbdpi_transfer_t *stream_data_gen(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
-                                   unsigned len) {
+void stream_data_gen(usbdpi_ctx_t *ctx, usbdpi_stream_t *s, unsigned len) {
   // TODO: this code presesntly does not support Isochronous streams
-  usbdpi_transfer_t *tr = transfer_alloc(ctx);
-  if (tr) {
-    // Pretend that we have successfully received the packet with the correct
-    // data toggling...
-    uint8_t data = ctx->ep_in[s->ep_in].next_data;
-    ctx->ep_in[s->ep_in].next_data = DATA_TOGGLE_ADVANCE(data);
-    // ...and that the data is as expected
-    uint8_t *dp = transfer_data_start(tr, data, len);
-    for (unsigned idx = 0U; idx < len; idx++) {
-      dp[idx] = s->tst_lfsr;
-      s->tst_lfsr = LFSR_ADVANCE(s->tst_lfsr);
-    }
-    transfer_data_end(tr, dp + len);
-  }
-  return tr;
+  assert(stream_pkts(s) < s->in_depth);
+  assert(len <= USBDEV_MAX_PACKET_SIZE);
+
+  // Pretend that we have successfully received the packet with the correct
+  // data toggling...
+  uint8_t data = ctx->ep_in[s->ep_in].next_data;
+  ctx->ep_in[s->ep_in].next_data = DATA_TOGGLE_ADVANCE(data);
+
+  // ...and that the data is as expected, before combining it with our own
+  // LFSR-generated byte stream in readiness for return to the device
+  unsigned slot = s->pkt_wr & (USBDPI_STREAM_MAX_PKTS - 1U);
+  uint8_t *dp = s->ring[slot];
+  s->tst_lfsr = lfsr_gen(s->tst_lfsr, dp, len);
+  s->dpi_lfsr = lfsr_combine(s->dpi_lfsr, dp, dp, len);
+  s->pkt_len[slot] = (uint8_t)len;
+  s->pkt_wr++;
 }
 
-// Process a received data packet to produce a corresponding reply packet
-// by XORing our LFSR output with the received data
+// Process a received data packet to produce the data field of the
+// corresponding reply packet by XORing our LFSR output with the received data
 //
 // Note: for now we do this even if the received data mismatches because
 //       only the CPU software has the capacity to decide upon and report
 //       test status
-usbdpi_transfer_t *stream_data_process(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
-                                       usbdpi_transfer_t *rx) {
-  // Note: checkStreamData has already been called on this packet
+void stream_data_process(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
+                         usbdpi_transfer_t *rx) {
+  // Note: stream_data_check has already been called on this packet
   assert(rx);
+  assert(stream_pkts(s) < s->in_depth);
 
   // The byte count _includes_ the DATAx PID and the two CRC bytes
   unsigned num_bytes = transfer_length(rx);
   num_bytes -= 3u;
+  assert(num_bytes <= USBDEV_MAX_PACKET_SIZE);
 
-  // Data field within received packet
+  // Data field within received packet; this may be a Zero Length Packet
   const uint8_t *sp = transfer_data_field(rx);
-  if (!sp)
-    return NULL;
-
-  // Allocate a new buffer for the reply
-  usbdpi_transfer_t *reply = transfer_alloc(ctx);
-  assert(reply);
+  if (!sp && num_bytes) {
+    return;
+  }
 
-  // Construct OUT token packet to the target endpoint, using the
-  // appropriate DATAx PID
-  const uint8_t ep_out = s->ep_out;
-  transfer_token(reply, USB_PID_OUT, ctx->dev_address, ep_out);
-  uint8_t *dp =
-      transfer_data_start(reply, ctx->ep_out[ep_out].next_data, num_bytes);
-  assert(dp);
+  unsigned slot = s->pkt_wr & (USBDPI_STREAM_MAX_PKTS - 1U);
+  uint8_t *dp = s->ring[slot];
+  s->pkt_len[slot] = (uint8_t)num_bytes;
 
   // For Isochronous streams each packet commences with a signature that
   // specifies the packet sequence number and the device-side LFSR; we must
@@ -297,26 +385,43 @@ usbdpi_transfer_t *stream_data_process(usbdpi_ctx_t *ctx, usbdpi_stream_t *s,
     num_bytes -= SIZEOF_STREAM_SIGNATURE;
   }
 
-  // Keep a record of the LFSR, so that we may rewind in the event of a delivery
-  // failure
-  s->dpi_rewind_lfsr = s->dpi_lfsr;
+  // Simply XOR the two LFSR-generated streams together
+  if (verbose) {
+    printf("[usbdpi] S#%u: combining 0x%x byte(s) with LFSR 0x%02x\n", s->id,
+           num_bytes, s->dpi_lfsr);
+  }
+  s->dpi_lfsr = lfsr_combine(s->dpi_lfsr, dp, sp, num_bytes);
+  s->pkt_wr++;
+}
 
-  while (num_bytes-- > 0U) {
-    uint8_t recvd = *sp++;
+// Construct an OUT data packet from the oldest packet held by the stream
+usbdpi_transfer_t *stream_data_send(usbdpi_ctx_t *ctx, usbdpi_stream_t *s) {
+  assert(stream_pkts(s) > 0U);
 
-    // Simply XOR the two LFSR-generated streams together
-    *dp++ = recvd ^ s->dpi_lfsr;
-    if (verbose) {
-      printf("[usbdpi] 0x%02x <- 0x%02x ^ 0x%02x\n", *(dp - 1), recvd,
-             s->dpi_lfsr);
-    }
-    // Advance our local copy of the LFSR
-    s->dpi_lfsr = LFSR_ADVANCE(s->dpi_lfsr);
+  // Ensure that a buffer is available for constructing a transfer
+  usbdpi_transfer_t *tr = ctx->sending;
+  if (!tr) {
+    tr = transfer_alloc(ctx);
+    assert(tr);
+    ctx->sending = tr;
   }
 
-  transfer_data_end(reply, dp);
+  unsigned slot = s->pkt_rd & (USBDPI_STREAM_MAX_PKTS - 1U);
+  unsigned num_bytes = s->pkt_len[slot];
+
+  // Construct OUT token packet to the target endpoint, using the
+  // appropriate DATAx PID
+  const uint8_t ep_out = s->ep_out;
+  transfer_token(tr, USB_PID_OUT, ctx->dev_address, ep_out);
+  uint8_t *dp =
+      transfer_data_start(tr, ctx->ep_out[ep_out].next_data, num_bytes);
+  assert(dp);
 
-  return reply;
+  // The data field is retained in the ring until it has been accepted
+  memcpy(dp, s->ring[slot], num_bytes);
+  transfer_data_end(tr, dp + num_bytes);
+
+  return tr;
 }
 
 // Check the stream signature
@@ -430,27 +535,28 @@ void streams_service(usbdpi_ctx_t *ctx) {
       // another transmission
       uint32_t next_frame = ctx->frame_start + FRAME_INTERVAL;
       if ((next_frame - ctx->tick_bits) > min_time_left) {
-        unsigned id = out_stream_next(ctx);
+        // Continue with the current stream if it is part way through a burst
+        // and still has data to send
+        unsigned id = ctx->stream_out;
         usbdpi_stream_t *s = &ctx->stream[id];
+        if (!s->out_run || s->out_run >= s->burst || !stream_pkts(s)) {
+          id = out_stream_next(ctx);
+          s = &ctx->stream[id];
+          s->out_run = 0U;
+        }
         if (verbose) {
-          printf("[usbdpi] OUT considering #%u received %p send %u\n", id,
-                 s->received, s->send ? 1 : 0);
+          printf("[usbdpi] OUT considering #%u pkts %u send %u\n", id,
+                 stream_pkts(s), s->send ? 1 : 0);
         }
         // Default to 'nothing to send, try receiving'...
         ctx->hostSt = HS_STREAMIN;
 
         if (s->send) {
-          // Start by trying to transmit a data packet that we've received, if
-          // any
-          if (s->received) {
-            if (ctx->sending) {
-              transfer_release(ctx, ctx->sending);
-              ctx->sending = NULL;
-            }
-
-            // Scramble the oldest received packet with our LFSR-generated byte
-            // stream and send it to the device
-            usbdpi_transfer_t *reply = stream_data_process(ctx, s, s->received);
+          // Start by trying to transmit the oldest data packet that we've
+          // received, if any; this has already been scrambled with our
+          // LFSR-generated byte stream
+          if (stream_pkts(s)) {
+            usbdpi_transfer_t *reply = stream_data_send(ctx, s);
             if (reply) {
               ctx->bus_state = kUsbBulkOut;
               switch (s->xfr_type) {
@@ -473,13 +579,6 @@ void streams_service(usbdpi_ctx_t *ctx) {
               ctx->hostSt = HS_WAITACK;
             }
           }
-        } else {
-          // We're not sending anything - discard any received data
-          while (s->received) {
-            usbdpi_transfer_t *tr = s->received;
-            s->received = tr->next;
-            transfer_release(ctx, tr);
-          }
         }
       } else {
         // Wait until the next bus frame
@@ -489,13 +588,9 @@ void streams_service(usbdpi_ctx_t *ctx) {
 
     // Await acknowledgement of the packet that we just transmitted
     case HS_WAITACK: {
+      // Note: the packet that we just tried to send remains held by the
+      // stream until it has been accepted
       usbdpi_stream_t *s = &ctx->stream[ctx->stream_out];
-      if (ctx->sending) {
-        // Forget reference to the buffer we just tried to send; the received
-        // packet remains in the list of received buffers to try again later
-        transfer_release(ctx, ctx->sending);
-        ctx->sending = NULL;
-      }
 
       // Bulk transfer stream?
       bool bulk = false;
@@ -521,8 +616,9 @@ void streams_service(usbdpi_ctx_t *ctx) {
               // We may receive a NAK from the device if it is unable to receive
               // the packet right now
               case USB_PID_NAK:
-                // Rewind the LFSR in preparation for trying again
-                s->dpi_lfsr = s->dpi_rewind_lfsr;
+                // The packet shall simply be sent again later; move on to
+                // another stream
+                s->out_run = 0U;
                 // TODO: we should have counting code here to kill the test if
                 // transmission is rejected too many times; at present, however,
                 // we will try too rapidly and would give up too soon.
@@ -559,11 +655,9 @@ void streams_service(usbdpi_ctx_t *ctx) {
 
       if (accepted) {
         // Transmitted packet was accepted, so we can retire it...
-        usbdpi_stream_t *s = &ctx->stream[ctx->stream_out];
-        usbdpi_transfer_t *rx = s->received;
-        assert(rx);
-        s->received = rx->next;
-        transfer_release(ctx, rx);
+        assert(stream_pkts(s));
+        s->pkt_rd++;
+        s->out_run++;
         // No data toggling for Isochronous
         if (s->xfr_type != USB_TRANSFER_TYPE_ISOCHRONOUS) {
           uint8_t ep_out = s->ep_out;
@@ -587,13 +681,21 @@ void streams_service(usbdpi_ctx_t *ctx) {
       //        determines the maximum delay
       uint32_t next_frame = ctx->frame_start + FRAME_INTERVAL;
       if ((next_frame - ctx->tick_bits) > min_time_left) {
-        unsigned id = in_stream_next(ctx);
+        // Continue with the current stream if it is part way through a burst
+        unsigned id = ctx->stream_in;
         usbdpi_stream_t *s = &ctx->stream[id];
+        if (!s->in_run || s->in_run >= s->burst) {
+          id = in_stream_next(ctx);
+          s = &ctx->stream[id];
+          s->in_run = 0U;
+        }
         if (verbose) {
           printf("[usbdpi] IN considering #%u retrieve %u\n", id,
                  s->retrieve ? 1 : 0);
         }
-        if (s->retrieve) {
+        // Do not poll for more data than we can hold awaiting return to the
+        // device; the device will simply hold onto its data until we ask
+        if (s->retrieve && (!s->send || stream_pkts(s) < s->in_depth)) {
           // Ensure that a buffer is available for constructing a transfer
           usbdpi_transfer_t *tr = ctx->sending;
           if (!tr) {
@@ -625,10 +727,10 @@ void streams_service(usbdpi_ctx_t *ctx) {
           // We're not required to poll for IN data, but if we're sending we
           //   must still fake the reception of valid packet data because
           //   the sw test will be expecting valid data
-          if (s->send && !s->received) {
+          if (s->send && !s->retrieve && stream_pkts(s) < s->in_depth) {
             // For simplicity we just create max length packets
             const unsigned len = USBDEV_MAX_PACKET_SIZE;
-            s->received = stream_data_gen(ctx, s, len);
+            stream_data_gen(ctx, s, len);
           }
           ctx->hostSt = HS_STREAMOUT;
         }
@@ -751,22 +853,18 @@ void streams_service(usbdpi_ctx_t *ctx) {
 
             // Not yet handled this packet?
             if (rx) {
-              if (accept) {
-                // Collect the received packets in preparation for later
-                // transmission with modification back to the device
-                usbdpi_transfer_t *tr = s->received;
-                if (tr) {
-                  while (tr->next)
-                    tr = tr->next;
-                  tr->next = rx;
-                } else {
-                  s->received = rx;
-                }
-              } else {
-                transfer_release(ctx, rx);
+              // Collect the received data in preparation for later
+              // transmission with modification back to the device; the
+              // transfer descriptor itself is not retained
+              if (accept && s->send) {
+                stream_data_process(ctx, s, rx);
               }
+              transfer_release(ctx, rx);
             }
 
+            // Remain with this stream whilst it is supplying data
+            s->in_run = accept ? (uint8_t)(s->in_run + 1U) : 0U;
+
             // For non-isochronous transfers, we now ACK/NAK the data, and we
             // expect no further signatures if we've accepted the data.
             if (s->xfr_type != USB_TRANSFER_TYPE_ISOCHRONOUS) {
@@ -790,6 +888,7 @@ void streams_service(usbdpi_ctx_t *ctx) {
               ctx->hostSt = HS_ERROR;
             } else {
               // No data available
+              s->in_run = 0U;
               ctx->hostSt = HS_STREAMOUT;
             }
             break;
@@ -12,6 +12,22 @@
 // Forwards declaration of USBDPI context
 typedef struct usbdpi_ctx usbdpi_ctx_t;
 
+// Maximum number of data packets that may be held within a stream, awaiting
+// return to the device; must be a power of two
+#define USBDPI_STREAM_MAX_PKTS 0x20U
+
+// Default number of data packets that a stream may hold awaiting return to the
+// device; IN polling of the stream is suspended whilst this many are held
+#ifndef USBDPI_STREAM_IN_DEPTH
+#define USBDPI_STREAM_IN_DEPTH 8U
+#endif
+
+// Default number of consecutive IN/OUT data packets that may be transferred
+// on a non-Isochronous stream before moving on to the next stream
+#ifndef USBDPI_STREAM_BURST
+#define USBDPI_STREAM_BURST 2U
+#endif
+
 // Context for streaming data test (usbdev_stream_test)
 typedef struct usbdpi_stream {
   /**
@@ -75,14 +91,41 @@ typedef struct usbdpi_stream {
    */
   uint8_t nretries;
   /**
-   * LFSR state prior to the construction of the current OUT packet; this is
-   * so that we may easily rewind it in the event of a delivery failure, eg. NAK
+   * Maximum number of data packets held awaiting return to the device
+   * (at most USBDPI_STREAM_MAX_PKTS)
+   */
+  uint8_t in_depth;
+  /**
+   * Maximum number of consecutive IN/OUT data packets on this stream
+   */
+  uint8_t burst;
+  /**
+   * Number of consecutive IN data packets accepted on this stream
+   */
+  uint8_t in_run;
+  /**
+   * Number of consecutive OUT data packets accepted on this stream
+   */
+  uint8_t out_run;
+  /**
+   * Free-running index of the oldest packet awaiting return to the device
+   */
+  uint8_t pkt_rd;
+  /**
+   * Free-running index at which the next received packet shall be stored
+   */
+  uint8_t pkt_wr;
+  /**
+   * Lengths of the data fields of the held packets
    */
-  uint8_t dpi_rewind_lfsr;
+  uint8_t pkt_len[USBDPI_STREAM_MAX_PKTS];
   /**
-   * Linked-list of received transfers
+   * Ring of data fields awaiting return to the device; these have already been
+   * combined with our LFSR output, so that OUT packets are constructed
+   * directly from the ring and a delivery failure (eg. NAK) requires only that
+   * the packet be sent again
    */
-  usbdpi_transfer_t *received;
+  uint8_t ring[USBDPI_STREAM_MAX_PKTS][USBDEV_MAX_PACKET_SIZE];
 } usbdpi_stream_t;
 
 /**
@@ -2,13 +2,16 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <fstream>
 #include <getopt.h>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
 #include <svdpi.h>
+#include <vector>
 
 #include "Votbn_top_sim__Syms.h"
 #include "log_trace_listener.h"
@@ -96,8 +99,256 @@ class OtbnTraceUtil : public SimCtrlExtension {
   }
 };
 
+/**
+ * SimCtrlExtension that adds a '--otbn-loop-profile' command line option. If
+ * set, the activity of the loop controller is recorded throughout the
+ * simulation and, on completion, a report is written to the given file that
+ * ranks the loops by the number of cycles spent within them and suggests loop
+ * warp symbols that would remove the most cycles.
+ *
+ * Warping skips loop iterations, so it's only appropriate where the result
+ * of the program does not depend upon the skipped iterations (or the expected
+ * results account for them). The profiler can't know that, but it reports two
+ * hints: whether a loop always runs the same number of iterations, and whether
+ * every iteration takes the same number of cycles (suggesting that there's no
+ * data-dependent control flow in the loop body).
+ */
+class OtbnLoopProfiler : public SimCtrlExtension {
+ public:
+  virtual bool ParseCLIArguments(int argc, char **argv, bool &exit_app) {
+    const struct option long_options[] = {
+        {"otbn-loop-profile", required_argument, nullptr, 'p'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, no_argument, nullptr, 0}};
+
+    // Reset the command parsing index in-case other utils have already parsed
+    // some arguments
+    optind = 1;
+    while (1) {
+      int c = getopt_long(argc, argv, "-h", long_options, nullptr);
+      if (c == -1) {
+        break;
+      }
+
+      switch (c) {
+        case 0:
+        case 1:
+          break;
+        case 'p':
+          report_filename_ = optarg;
+          break;
+        case 'h':
+          PrintHelp();
+          break;
+      }
+    }
+
+    return true;
+  }
+
+  virtual void PostExec() {
+    if (report_filename_.empty()) {
+      return;
+    }
+    std::ofstream out(report_filename_);
+    if (!out) {
+      std::cerr << "ERROR: Failed to open loop profile file `"
+                << report_filename_ << "'." << std::endl;
+      return;
+    }
+    WriteReport(out);
+  }
+
+  bool Enabled() const { return !report_filename_.empty(); }
+
+  /**
+   * Sample the loop controller; called once per clock cycle, before any loop
+   * warp is applied.
+   */
+  template <typename LoopControllerT>
+  void Sample(const LoopControllerT *lc) {
+    uint64_t cycle = cycle_++;
+
+    if (lc->insn_valid_i) {
+      if (!insns_seen_) {
+        first_insn_cycle_ = cycle;
+        insns_seen_ = true;
+      }
+      last_insn_cycle_ = cycle;
+    }
+
+    // End of an iteration of the innermost loop. This must be handled before
+    // the loop is popped (current_loop_finish is set in the same cycle as the
+    // final iteration ends).
+    if (lc->current_loop_counter_dec && !active_.empty()) {
+      ActiveLoop &top = active_.back();
+      uint32_t iter_cycles = (uint32_t)(cycle + 1 - top.iter_start);
+      top.iter_start = cycle + 1;
+      top.iters++;
+      top.min_iter_cycles = std::min(top.min_iter_cycles, iter_cycles);
+      top.max_iter_cycles = std::max(top.max_iter_cycles, iter_cycles);
+    }
+
+    if (lc->current_loop_finish && !active_.empty()) {
+      Retire(active_.back(), cycle);
+      active_.pop_back();
+    }
+
+    if (lc->loop_start_req_i && lc->loop_start_commit_i) {
+      ActiveLoop l;
+      l.insn_addr = lc->insn_addr_i;
+      l.end_addr = lc->insn_addr_i + 4 * lc->loop_bodysize_i;
+      l.requested = lc->loop_iterations_i;
+      l.start = cycle;
+      l.iter_start = cycle + 1;
+      l.iters = 0;
+      l.min_iter_cycles = UINT32_MAX;
+      l.max_iter_cycles = 0;
+      l.depth = (unsigned)active_.size();
+      active_.push_back(l);
+    }
+  }
+
+ private:
+  // A loop that is currently executing.
+  struct ActiveLoop {
+    uint32_t insn_addr;
+    uint32_t end_addr;
+    uint32_t requested;
+    uint64_t start;
+    uint64_t iter_start;
+    uint32_t iters;
+    uint32_t min_iter_cycles;
+    uint32_t max_iter_cycles;
+    unsigned depth;
+  };
+
+  // Accumulated statistics for a loop, keyed by the address of its LOOP or
+  // LOOPI instruction.
+  struct LoopStats {
+    uint32_t end_addr;
+    unsigned depth;
+    uint64_t execs;
+    uint64_t iters;
+    uint64_t cycles;
+    uint32_t min_iters, max_iters;
+    uint32_t min_iter_cycles, max_iter_cycles;
+    // Set if the iteration count was changed by an existing loop warp.
+    bool warped;
+  };
+
+  void PrintHelp() {
+    std::cout << "Loop profiling utilities:\n\n"
+                 "--otbn-loop-profile=FILE\n"
+                 "  Write a profile of loop execution, together with\n"
+                 "  candidate loop warp symbols, to FILE\n\n";
+  }
+
+  void Retire(const ActiveLoop &l, uint64_t cycle) {
+    auto ins = stats_.insert({l.insn_addr, LoopStats()});
+    LoopStats &s = ins.first->second;
+    if (ins.second) {
+      s.end_addr = l.end_addr;
+      s.depth = l.depth;
+      s.execs = s.iters = s.cycles = 0;
+      s.min_iters = UINT32_MAX;
+      s.max_iters = 0;
+      s.min_iter_cycles = UINT32_MAX;
+      s.max_iter_cycles = 0;
+      s.warped = false;
+    }
+    s.execs++;
+    s.iters += l.iters;
+    s.cycles += cycle + 1 - l.start;
+    s.min_iters = std::min(s.min_iters, l.iters);
+    s.max_iters = std::max(s.max_iters, l.iters);
+    s.min_iter_cycles = std::min(s.min_iter_cycles, l.min_iter_cycles);
+    s.max_iter_cycles = std::max(s.max_iter_cycles, l.max_iter_cycles);
+    s.warped |= (l.iters != l.requested);
+  }
+
+  // Estimated number of cycles that a warp from the second iteration to the
+  // final iteration would remove, or zero if no such warp is suggested.
+  static uint64_t WarpSaving(const LoopStats &s) {
+    if (s.warped || s.min_iters != s.max_iters || s.min_iters < 3) {
+      return 0;
+    }
+    return (s.iters - 2 * s.execs) * (s.cycles / s.iters);
+  }
+
+  void WriteReport(std::ostream &os) const {
+    uint64_t total =
+        insns_seen_ ? (last_insn_cycle_ + 1 - first_insn_cycle_) : 0;
+
+    std::vector<std::pair<uint32_t, const LoopStats *>> ranked;
+    for (const auto &kv : stats_) {
+      ranked.push_back({kv.first, &kv.second});
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) {
+      return a.second->cycles > b.second->cycles;
+    });
+
+    os << "OTBN loop profile: " << std::dec << total << " cycles executing, "
+       << ranked.size() << " loop(s)\n\n"
+       << "Cycles are inclusive of any nested loops. Hints: I = constant "
+          "iteration count,\nC = constant cycles per iteration, W = iteration "
+          "count altered by an existing warp.\n\n"
+       << "   Loop       Body end   Depth      Execs   Iters (min/max)   "
+          "Cyc/iter (min/max)         Cycles       %  Hints\n";
+    for (const auto &r : ranked) {
+      const LoopStats &s = *r.second;
+      double pc = total ? (100.0 * s.cycles) / total : 0.0;
+      os << std::hex << std::setfill('0') << "   0x" << std::setw(8) << r.first
+         << " 0x" << std::setw(8) << s.end_addr << std::dec
+         << std::setfill(' ') << std::setw(6) << s.depth << std::setw(11)
+         << s.execs << std::setw(10) << s.min_iters << "/" << std::left
+         << std::setw(8) << s.max_iters << std::right << std::setw(12)
+         << s.min_iter_cycles << "/" << std::left << std::setw(8)
+         << s.max_iter_cycles << std::right << std::setw(15) << s.cycles
+         << std::fixed << std::setprecision(1) << std::setw(8) << pc << "  "
+         << (s.min_iters == s.max_iters ? "I" : "")
+         << (s.min_iter_cycles == s.max_iter_cycles ? "C" : "")
+         << (s.warped ? "W" : "") << "\n";
+    }
+
+    std::sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) {
+      return WarpSaving(*a.second) > WarpSaving(*b.second);
+    });
+
+    os << "\nCandidate loop warps, each skipping from the second iteration to "
+          "the last.\nPlace the label at the first instruction of the loop "
+          "body. Savings of nested\nloops are not additive.\n\n";
+    for (const auto &r : ranked) {
+      const LoopStats &s = *r.second;
+      uint64_t saving = WarpSaving(s);
+      if (!saving) {
+        break;
+      }
+      double pc = total ? (100.0 * saving) / total : 0.0;
+      uint32_t body = r.first + 4;
+      os << "  # Loop at 0x" << std::hex << std::setfill('0') << std::setw(8)
+         << r.first << std::dec << std::setfill(' ') << ": saves ~" << saving
+         << " cycles (" << std::fixed << std::setprecision(1) << pc << "%)"
+         << (s.min_iter_cycles == s.max_iter_cycles
+                 ? ""
+                 : "; iteration cycles vary, check for data dependence")
+         << "\n  _loop_warp_1_" << (s.min_iters - 1) << "_" << std::hex
+         << body << std::dec << ":\n";
+    }
+  }
+
+  std::string report_filename_;
+  uint64_t cycle_ = 0;
+  bool insns_seen_ = false;
+  uint64_t first_insn_cycle_ = 0;
+  uint64_t last_insn_cycle_ = 0;
+  std::vector<ActiveLoop> active_;
+  std::map<uint32_t, LoopStats> stats_;
+};
+
 static otbn_top_sim *verilator_top;
 static OtbnMemUtil otbn_memutil("TOP.otbn_top_sim");
+static OtbnLoopProfiler loop_profiler;
 
 int main(int argc, char **argv) {
   VerilatorMemUtil memutil(&otbn_memutil);
@@ -115,6 +366,7 @@ int main(int argc, char **argv) {
                  VerilatorSimCtrlFlags::ResetPolarityNegative);
   simctrl.RegisterExtension(&memutil);
   simctrl.RegisterExtension(&traceutil);
+  simctrl.RegisterExtension(&loop_profiler);
 
   std::cout << "Simulation of OTBN" << std::endl
             << "==================" << std::endl
@@ -239,6 +491,10 @@ extern "C" void OtbnTopApplyLoopWarp() {
   auto loop_controller =
       top.otbn_top_sim->u_otbn_core->u_otbn_controller->u_otbn_loop_controller;
 
+  if (loop_profiler.Enabled()) {
+    loop_profiler.Sample(loop_controller);
+  }
+
   // Track loop stack state.
   if (loop_controller->current_loop_finish) {
     assert(!loop_count_stack.empty());
@@ -0,0 +1,174 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/hardened_mmio.h"
+
+#include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/random_order.h"
+
+enum {
+  /**
+   * Number of words transferred per unrolled loop iteration.
+   */
+  kBlockWords = 4,
+};
+
+void hardened_mmio_order_init(hardened_mmio_order_t *order, size_t word_len,
+                              hardened_mmio_profile_t profile) {
+  order->start = 0;
+  order->len = word_len;
+  order->profile = profile;
+  if (launder32(profile) != kHardenedMmioProfileLinear && word_len > 0) {
+    order->start = random_order_random_word() % word_len;
+  }
+}
+
+size_t hardened_mmio_order_index(const hardened_mmio_order_t *order,
+                                 size_t i) {
+  size_t idx = order->start + i;
+  size_t idx_wrapped = idx - order->len;
+  // Select without branching on the (secret) starting word.
+  ct_bool32_t in_range = ct_sltu32(idx, order->len);
+  return ct_cmov32(in_range, idx, idx_wrapped);
+}
+
+// Check that the order is well-formed before touching any registers.
+OT_WARN_UNUSED_RESULT
+static status_t order_check(const hardened_mmio_order_t *order) {
+  switch (launder32(order->profile)) {
+    case kHardenedMmioProfileLinear:
+      HARDENED_CHECK_EQ(order->profile, kHardenedMmioProfileLinear);
+      break;
+    case kHardenedMmioProfileRandom:
+      HARDENED_CHECK_EQ(order->profile, kHardenedMmioProfileRandom);
+      break;
+    case kHardenedMmioProfileVerified:
+      HARDENED_CHECK_EQ(order->profile, kHardenedMmioProfileVerified);
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+  if (order->start != 0 && order->start >= order->len) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  return OTCRYPTO_OK;
+}
+
+// NOTE: The write and read loops below have the same structure, but the parts
+// that are shared between them are commented only in `write_range()`.
+
+/**
+ * Writes words `[begin, end)` of `src` and returns the number of words
+ * written.
+ *
+ * With `verify`, every written word is read back and XORed into `diff`.
+ */
+static size_t write_range(uint32_t dest_addr, const uint32_t *src,
+                          size_t begin, size_t end, hardened_bool_t verify,
+                          uint32_t *diff) {
+  size_t count = 0;
+  size_t i = begin;
+  for (; launderw(i) + kBlockWords <= end; i += kBlockWords) {
+    // Prevent the compiler from merging or reordering the blocks.
+    barrierw(i);
+    uint32_t addr = dest_addr + (uint32_t)(i * sizeof(uint32_t));
+    abs_mmio_write32(addr, src[i]);
+    abs_mmio_write32(addr + 1 * sizeof(uint32_t), src[i + 1]);
+    abs_mmio_write32(addr + 2 * sizeof(uint32_t), src[i + 2]);
+    abs_mmio_write32(addr + 3 * sizeof(uint32_t), src[i + 3]);
+    if (launder32(verify) == kHardenedBoolTrue) {
+      *diff |= abs_mmio_read32(addr) ^ src[i];
+      *diff |= abs_mmio_read32(addr + 1 * sizeof(uint32_t)) ^ src[i + 1];
+      *diff |= abs_mmio_read32(addr + 2 * sizeof(uint32_t)) ^ src[i + 2];
+      *diff |= abs_mmio_read32(addr + 3 * sizeof(uint32_t)) ^ src[i + 3];
+    }
+    // Redundant counter, checked against the length by the caller.
+    count = launderw(count) + kBlockWords;
+  }
+  for (; launderw(i) < end; ++i) {
+    uint32_t addr = dest_addr + (uint32_t)(i * sizeof(uint32_t));
+    abs_mmio_write32(addr, src[i]);
+    if (launder32(verify) == kHardenedBoolTrue) {
+      *diff |= abs_mmio_read32(addr) ^ src[i];
+    }
+    count = launderw(count) + 1;
+  }
+  HARDENED_CHECK_EQ(i, end);
+  return count;
+}
+
+/**
+ * Reads words `[begin, end)` into `dest` and returns the number of words
+ * read.
+ *
+ * With `verify`, every word is read twice and the difference is XORed into
+ * `diff`.
+ */
+static size_t read_range(uint32_t src_addr, uint32_t *dest, size_t begin,
+                         size_t end, hardened_bool_t verify, uint32_t *diff) {
+  size_t count = 0;
+  size_t i = begin;
+  for (; launderw(i) + kBlockWords <= end; i += kBlockWords) {
+    barrierw(i);
+    uint32_t addr = src_addr + (uint32_t)(i * sizeof(uint32_t));
+    dest[i] = abs_mmio_read32(addr);
+    dest[i + 1] = abs_mmio_read32(addr + 1 * sizeof(uint32_t));
+    dest[i + 2] = abs_mmio_read32(addr + 2 * sizeof(uint32_t));
+    dest[i + 3] = abs_mmio_read32(addr + 3 * sizeof(uint32_t));
+    if (launder32(verify) == kHardenedBoolTrue) {
+      *diff |= abs_mmio_read32(addr) ^ dest[i];
+      *diff |= abs_mmio_read32(addr + 1 * sizeof(uint32_t)) ^ dest[i + 1];
+      *diff |= abs_mmio_read32(addr + 2 * sizeof(uint32_t)) ^ dest[i + 2];
+      *diff |= abs_mmio_read32(addr + 3 * sizeof(uint32_t)) ^ dest[i + 3];
+    }
+    count = launderw(count) + kBlockWords;
+  }
+  for (; launderw(i) < end; ++i) {
+    uint32_t addr = src_addr + (uint32_t)(i * sizeof(uint32_t));
+    dest[i] = abs_mmio_read32(addr);
+    if (launder32(verify) == kHardenedBoolTrue) {
+      *diff |= abs_mmio_read32(addr) ^ dest[i];
+    }
+    count = launderw(count) + 1;
+  }
+  HARDENED_CHECK_EQ(i, end);
+  return count;
+}
+
+status_t hardened_mmio_write_block(uint32_t dest_addr, const uint32_t *src,
+                                   const hardened_mmio_order_t *order) {
+  HARDENED_TRY(order_check(order));
+  hardened_bool_t verify = order->profile == kHardenedMmioProfileVerified
+                               ? kHardenedBoolTrue
+                               : kHardenedBoolFalse;
+  uint32_t diff = 0;
+
+  // Write from the starting word to the end, then wrap around. This matches
+  // `hardened_mmio_order_index()`.
+  size_t count =
+      write_range(dest_addr, src, order->start, order->len, verify, &diff);
+  count += write_range(dest_addr, src, 0, order->start, verify, &diff);
+  HARDENED_CHECK_EQ(count, order->len);
+  HARDENED_CHECK_EQ(launder32(diff), 0);
+
+  return (status_t){.value = (int32_t)launder32((uint32_t)OTCRYPTO_OK.value)};
+}
+
+status_t hardened_mmio_read_block(uint32_t src_addr, uint32_t *dest,
+                                  const hardened_mmio_order_t *order) {
+  HARDENED_TRY(order_check(order));
+  hardened_bool_t verify = order->profile == kHardenedMmioProfileVerified
+                               ? kHardenedBoolTrue
+                               : kHardenedBoolFalse;
+  uint32_t diff = 0;
+
+  size_t count =
+      read_range(src_addr, dest, order->start, order->len, verify, &diff);
+  count += read_range(src_addr, dest, 0, order->start, verify, &diff);
+  HARDENED_CHECK_EQ(count, order->len);
+  HARDENED_CHECK_EQ(launder32(diff), 0);
+
+  return (status_t){.value = (int32_t)launder32((uint32_t)OTCRYPTO_OK.value)};
+}
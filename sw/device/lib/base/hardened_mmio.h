@@ -0,0 +1,131 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_BASE_HARDENED_MMIO_H_
+#define OPENTITAN_SW_DEVICE_LIB_BASE_HARDENED_MMIO_H_
+
+/**
+ * @file
+ * @brief Hardened block transfers between memory and memory-mapped windows.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Hardening profile of a block transfer.
+ *
+ * All profiles check the number of transferred words with a redundant
+ * counter. Values are chosen to have a large Hamming distance so that a fault
+ * cannot easily turn one profile into another.
+ */
+typedef enum hardened_mmio_profile {
+  /**
+   * Transfer the words in order. Only use this for data that is not secret.
+   */
+  kHardenedMmioProfileLinear = 0x5a3,
+  /**
+   * Start the transfer at a random word and wrap around, like
+   * `random_order_t`.
+   */
+  kHardenedMmioProfileRandom = 0x6c9,
+  /**
+   * Like `kHardenedMmioProfileRandom`, and additionally read every word back
+   * (for writes) or twice (for reads) and check that the values agree.
+   */
+  kHardenedMmioProfileVerified = 0x936,
+} hardened_mmio_profile_t;
+
+/**
+ * Traversal order of a block transfer.
+ *
+ * An order may be reused for several transfers of the same length to amortize
+ * the cost of drawing randomness, at the cost of all of them starting at the
+ * same word.
+ */
+typedef struct hardened_mmio_order {
+  /**
+   * Index of the first word to transfer.
+   */
+  size_t start;
+  /**
+   * Number of words to transfer.
+   */
+  size_t len;
+  /**
+   * Hardening profile of the transfer.
+   */
+  hardened_mmio_profile_t profile;
+} hardened_mmio_order_t;
+
+/**
+ * Initializes a traversal order for transfers of `word_len` words.
+ *
+ * For the randomized profiles, the starting word is drawn from
+ * `random_order_random_word()`, so the EDN must be initialized before calling
+ * this function.
+ *
+ * @param[out] order The order to initialize.
+ * @param word_len The number of words per transfer.
+ * @param profile Hardening profile of the transfers.
+ */
+void hardened_mmio_order_init(hardened_mmio_order_t *order, size_t word_len,
+                              hardened_mmio_profile_t profile);
+
+/**
+ * Returns the index of the `i`-th word transferred in the given order.
+ *
+ * This lets callers process the words in the same order as the hardware saw
+ * them, e.g. to compute a checksum.
+ *
+ * @param order The traversal order.
+ * @param i Position in the traversal, must be less than `order->len`.
+ * @return The word index.
+ */
+OT_WARN_UNUSED_RESULT
+size_t hardened_mmio_order_index(const hardened_mmio_order_t *order, size_t i);
+
+/**
+ * Writes a buffer to consecutive 32-bit registers.
+ *
+ * Unlike `hardened_memcpy()`, words are processed in blocks of four with one
+ * loop counter update per block, and the traversal order is drawn once per
+ * order rather than advanced per word.
+ *
+ * @param dest_addr Address of the first destination register.
+ * @param src The words to write.
+ * @param order Traversal order, length and hardening profile.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t hardened_mmio_write_block(uint32_t dest_addr, const uint32_t *src,
+                                   const hardened_mmio_order_t *order);
+
+/**
+ * Reads consecutive 32-bit registers into a buffer.
+ *
+ * See `hardened_mmio_write_block()`.
+ *
+ * @param src_addr Address of the first source register.
+ * @param[out] dest The buffer to read into.
+ * @param order Traversal order, length and hardening profile.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t hardened_mmio_read_block(uint32_t src_addr, uint32_t *dest,
+                                  const hardened_mmio_order_t *order);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_BASE_HARDENED_MMIO_H_
@@ -0,0 +1,135 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/hardened_mmio.h"
+
+#include <map>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+
+// NOTE: Like the hardened_memory tests, these tests do not verify hardening
+// measures; they check that every profile transfers the same data.
+
+namespace hardened_mmio_unittest {
+namespace {
+
+using ::testing::_;
+using ::testing::Invoke;
+
+uint32_t random_word = 0;
+
+// Provides the starting word of the randomized profiles.
+extern "C" uint32_t random_order_random_word() { return random_word; }
+
+constexpr uint32_t kBase = 0x40000000;
+
+constexpr hardened_mmio_profile_t kProfiles[] = {
+    kHardenedMmioProfileLinear,
+    kHardenedMmioProfileRandom,
+    kHardenedMmioProfileVerified,
+};
+
+class HardenedMmioTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ON_CALL(mmio_, Write32(_, _))
+        .WillByDefault(Invoke([this](uint32_t addr, uint32_t value) {
+          regs_[addr] = value;
+          writes_.push_back(addr);
+        }));
+    ON_CALL(mmio_, Read32(_)).WillByDefault(Invoke([this](uint32_t addr) {
+      return regs_[addr];
+    }));
+  }
+
+  std::vector<uint32_t> Pattern(size_t len) {
+    std::vector<uint32_t> words(len);
+    for (size_t i = 0; i < len; ++i) {
+      words[i] = 0x9e3779b9 * static_cast<uint32_t>(i + 1);
+    }
+    return words;
+  }
+
+  rom_test::NiceMockAbsMmio mmio_;
+  std::map<uint32_t, uint32_t> regs_;
+  std::vector<uint32_t> writes_;
+};
+
+TEST_F(HardenedMmioTest, RoundTrip) {
+  for (size_t len = 0; len <= 13; ++len) {
+    for (uint32_t rnd : {0u, 1u, 6u, 0xdeadbeefu}) {
+      for (hardened_mmio_profile_t profile : kProfiles) {
+        random_word = rnd;
+        regs_.clear();
+        std::vector<uint32_t> src = Pattern(len);
+        std::vector<uint32_t> dest(len);
+
+        hardened_mmio_order_t order;
+        hardened_mmio_order_init(&order, len, profile);
+        EXPECT_EQ(hardened_mmio_write_block(kBase, src.data(), &order).value,
+                  OTCRYPTO_OK.value);
+        for (size_t i = 0; i < len; ++i) {
+          EXPECT_EQ(regs_[kBase + i * sizeof(uint32_t)], src[i]);
+        }
+
+        EXPECT_EQ(hardened_mmio_read_block(kBase, dest.data(), &order).value,
+                  OTCRYPTO_OK.value);
+        EXPECT_EQ(dest, src);
+      }
+    }
+  }
+}
+
+TEST_F(HardenedMmioTest, WriteOrder) {
+  for (size_t len = 1; len <= 13; ++len) {
+    for (uint32_t rnd = 0; rnd < 2 * len; ++rnd) {
+      for (hardened_mmio_profile_t profile : kProfiles) {
+        random_word = rnd;
+        writes_.clear();
+        std::vector<uint32_t> src = Pattern(len);
+
+        hardened_mmio_order_t order;
+        hardened_mmio_order_init(&order, len, profile);
+        EXPECT_EQ(hardened_mmio_write_block(kBase, src.data(), &order).value,
+                  OTCRYPTO_OK.value);
+
+        // Every word is written exactly once, in the order reported by
+        // `hardened_mmio_order_index()`.
+        size_t start = profile == kHardenedMmioProfileLinear ? 0 : rnd % len;
+        EXPECT_EQ(order.start, start);
+        ASSERT_EQ(writes_.size(), len);
+        for (size_t i = 0; i < len; ++i) {
+          size_t idx = hardened_mmio_order_index(&order, i);
+          EXPECT_EQ(idx, (start + i) % len);
+          EXPECT_EQ(writes_[i], kBase + idx * sizeof(uint32_t));
+        }
+      }
+    }
+  }
+}
+
+TEST_F(HardenedMmioTest, BadOrder) {
+  uint32_t word = 0;
+  hardened_mmio_order_t order = {
+      .start = 0,
+      .len = 1,
+      .profile = static_cast<hardened_mmio_profile_t>(0),
+  };
+  EXPECT_EQ(hardened_mmio_write_block(kBase, &word, &order).value,
+            OTCRYPTO_BAD_ARGS.value);
+  EXPECT_EQ(hardened_mmio_read_block(kBase, &word, &order).value,
+            OTCRYPTO_BAD_ARGS.value);
+
+  order.profile = kHardenedMmioProfileRandom;
+  order.start = 1;
+  EXPECT_EQ(hardened_mmio_write_block(kBase, &word, &order).value,
+            OTCRYPTO_BAD_ARGS.value);
+  EXPECT_TRUE(writes_.empty());
+}
+
+}  // namespace
+}  // namespace hardened_mmio_unittest
@@ -0,0 +1,248 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/dma.h"
+
+#include "hw/top/dt/dma.h"
+#include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/multibits.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+#include "hw/top/dma_regs.h"  // Generated.
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('d', 'd', 'm')
+
+static const dt_dma_t kDmaDt = kDtDma;
+
+static inline uint32_t dma_base(void) {
+  return dt_dma_primary_reg_block(kDmaDt);
+}
+
+OT_ASSERT_ENUM_VALUE(DMA_SHA2_DIGEST_1_REG_OFFSET,
+                     DMA_SHA2_DIGEST_0_REG_OFFSET + 4);
+
+/**
+ * Returns the digest length in 32-bit words for the given mode.
+ *
+ * @param mode SHA-2 variant.
+ * @return Digest length in words, or 0 for an invalid mode.
+ */
+static size_t digest_wordlen(dma_sha2_mode_t mode) {
+  switch (mode) {
+    case kDmaSha2Mode256:
+      return 256 / 32;
+    case kDmaSha2Mode384:
+      return 384 / 32;
+    case kDmaSha2Mode512:
+      return 512 / 32;
+    default:
+      return 0;
+  }
+}
+
+enum {
+  /**
+   * STATUS bits that report the outcome of a transfer.
+   *
+   * Any of these being set before `dma_sha2` starts means that another user
+   * has not collected the result of its transfer yet.
+   */
+  kDmaStatusResultMask = (1u << DMA_STATUS_DONE_BIT) |
+                         (1u << DMA_STATUS_ABORTED_BIT) |
+                         (1u << DMA_STATUS_ERROR_BIT) |
+                         (1u << DMA_STATUS_CHUNK_DONE_BIT),
+  /**
+   * STATUS polls allowed per message word before the transfer is aborted.
+   *
+   * The DMA moves and hashes at least one word in the time the CPU takes for
+   * a few polls, so this is a generous bound that still guarantees progress.
+   */
+  kDmaSha2PollsPerWord = 16,
+  /**
+   * Fixed number of STATUS polls allowed on top of the per-word budget.
+   */
+  kDmaSha2PollsBase = 1024,
+};
+
+/**
+ * Configuration registers written by `dma_sha2`.
+ *
+ * They are saved before and restored after the transfer, so that a transfer
+ * another driver has configured but not started survives.
+ */
+static const uint32_t kDmaSha2ConfigRegs[] = {
+    DMA_SRC_ADDR_LO_REG_OFFSET,     DMA_SRC_ADDR_HI_REG_OFFSET,
+    DMA_DST_ADDR_LO_REG_OFFSET,     DMA_DST_ADDR_HI_REG_OFFSET,
+    DMA_SRC_CONFIG_REG_OFFSET,      DMA_DST_CONFIG_REG_OFFSET,
+    DMA_ADDR_SPACE_ID_REG_OFFSET,   DMA_CHUNK_DATA_SIZE_REG_OFFSET,
+    DMA_TOTAL_DATA_SIZE_REG_OFFSET, DMA_TRANSFER_WIDTH_REG_OFFSET,
+    DMA_CONTROL_REG_OFFSET,
+};
+
+/**
+ * Checks that nobody else is using the DMA.
+ *
+ * The DMA has no lock, so the DMA is considered free when it is not busy,
+ * its configuration is writable, no hardware-handshake transfer is armed (GO
+ * stays set for those) and no result of an earlier transfer is pending.
+ *
+ * @return kHardenedBoolTrue if the DMA is free.
+ */
+static hardened_bool_t dma_is_free(void) {
+  const uint32_t kBase = dma_base();
+  uint32_t status = abs_mmio_read32(kBase + DMA_STATUS_REG_OFFSET);
+  uint32_t control = abs_mmio_read32(kBase + DMA_CONTROL_REG_OFFSET);
+  uint32_t regwen = abs_mmio_read32(kBase + DMA_CFG_REGWEN_REG_OFFSET);
+  if (bitfield_bit32_read(status, DMA_STATUS_BUSY_BIT) ||
+      (status & kDmaStatusResultMask) != 0 ||
+      bitfield_bit32_read(control, DMA_CONTROL_GO_BIT) ||
+      launder32(regwen) != kMultiBitBool4True) {
+    return kHardenedBoolFalse;
+  }
+  HARDENED_CHECK_EQ(regwen, kMultiBitBool4True);
+  return kHardenedBoolTrue;
+}
+
+hardened_bool_t dma_sha2_usable(const uint8_t *data, size_t len) {
+  if (len < kDmaSha2MinMessageBytes || len % sizeof(uint32_t) != 0 ||
+      misalignment32_of((uintptr_t)data) != 0) {
+    return kHardenedBoolFalse;
+  }
+
+  uint32_t range_valid =
+      abs_mmio_read32(dma_base() + DMA_RANGE_VALID_REG_OFFSET);
+  if (!bitfield_bit32_read(range_valid, DMA_RANGE_VALID_RANGE_VALID_BIT)) {
+    return kHardenedBoolFalse;
+  }
+  return dma_is_free();
+}
+
+/**
+ * Waits for the running transfer to end, aborting it if it takes too long.
+ *
+ * @param len Message length in bytes.
+ * @return Final value of the STATUS register.
+ */
+static uint32_t dma_sha2_wait(size_t len) {
+  const uint32_t kBase = dma_base();
+  const uint32_t kEndMask = (1u << DMA_STATUS_DONE_BIT) |
+                            (1u << DMA_STATUS_ABORTED_BIT) |
+                            (1u << DMA_STATUS_ERROR_BIT);
+  size_t polls =
+      kDmaSha2PollsBase + len / sizeof(uint32_t) * kDmaSha2PollsPerWord;
+  uint32_t status = abs_mmio_read32(kBase + DMA_STATUS_REG_OFFSET);
+  while ((status & kEndMask) == 0 && polls > 0) {
+    --polls;
+    status = abs_mmio_read32(kBase + DMA_STATUS_REG_OFFSET);
+  }
+  if ((status & kEndMask) != 0) {
+    return status;
+  }
+
+  // Out of budget: abort. OT-internal transactions are guaranteed to
+  // complete, so the abort should finish quickly; it is bounded all the same.
+  abs_mmio_write32(kBase + DMA_CONTROL_REG_OFFSET,
+                   bitfield_bit32_write(0, DMA_CONTROL_ABORT_BIT, true));
+  polls = kDmaSha2PollsBase;
+  do {
+    status = abs_mmio_read32(kBase + DMA_STATUS_REG_OFFSET);
+  } while (!bitfield_bit32_read(status, DMA_STATUS_ABORTED_BIT) &&
+           polls-- > 0);
+  return status;
+}
+
+status_t dma_sha2(dma_sha2_mode_t mode, const uint8_t *data, size_t len,
+                  uint32_t *digest) {
+  size_t wordlen = digest_wordlen(mode);
+  if (wordlen == 0 || digest == NULL || data == NULL ||
+      len % sizeof(uint32_t) != 0 || misalignment32_of((uintptr_t)data) != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Never take over a DMA that someone else is using or has not yet read the
+  // result from. The caller falls back to the HMAC block.
+  if (launder32(dma_is_free()) != kHardenedBoolTrue) {
+    return OTCRYPTO_ASYNC_INCOMPLETE;
+  }
+  HARDENED_CHECK_EQ(dma_is_free(), kHardenedBoolTrue);
+
+  const uint32_t kBase = dma_base();
+  uint32_t saved[ARRAYSIZE(kDmaSha2ConfigRegs)];
+  for (size_t i = 0; i < ARRAYSIZE(kDmaSha2ConfigRegs); ++i) {
+    saved[i] = abs_mmio_read32(kBase + kDmaSha2ConfigRegs[i]);
+  }
+
+  // The DMA always writes the data it reads. Point it at a single scratch word
+  // without incrementing, so that the hash does not need a second buffer.
+  uint32_t scratch = 0;
+  abs_mmio_write32(kBase + DMA_SRC_ADDR_LO_REG_OFFSET,
+                   (uint32_t)(uintptr_t)data);
+  abs_mmio_write32(kBase + DMA_SRC_ADDR_HI_REG_OFFSET, 0);
+  abs_mmio_write32(kBase + DMA_DST_ADDR_LO_REG_OFFSET,
+                   (uint32_t)(uintptr_t)&scratch);
+  abs_mmio_write32(kBase + DMA_DST_ADDR_HI_REG_OFFSET, 0);
+  abs_mmio_write32(
+      kBase + DMA_SRC_CONFIG_REG_OFFSET,
+      bitfield_bit32_write(0, DMA_SRC_CONFIG_INCREMENT_BIT, true));
+  abs_mmio_write32(kBase + DMA_DST_CONFIG_REG_OFFSET, 0);
+
+  uint32_t asid = 0;
+  asid = bitfield_field32_write(asid, DMA_ADDR_SPACE_ID_SRC_ASID_FIELD,
+                                DMA_ADDR_SPACE_ID_SRC_ASID_VALUE_OT_ADDR);
+  asid = bitfield_field32_write(asid, DMA_ADDR_SPACE_ID_DST_ASID_FIELD,
+                                DMA_ADDR_SPACE_ID_DST_ASID_VALUE_OT_ADDR);
+  abs_mmio_write32(kBase + DMA_ADDR_SPACE_ID_REG_OFFSET, asid);
+
+  // One chunk covering the whole message; inline hashing needs 32-bit
+  // transactions.
+  abs_mmio_write32(kBase + DMA_CHUNK_DATA_SIZE_REG_OFFSET, len);
+  abs_mmio_write32(kBase + DMA_TOTAL_DATA_SIZE_REG_OFFSET, len);
+  abs_mmio_write32(kBase + DMA_TRANSFER_WIDTH_REG_OFFSET,
+                   DMA_TRANSFER_WIDTH_TRANSACTION_WIDTH_VALUE_FOUR_BYTE);
+
+  // Digest should be big-endian to match the HMAC driver.
+  uint32_t ctrl = 0;
+  ctrl = bitfield_field32_write(ctrl, DMA_CONTROL_OPCODE_FIELD, mode);
+  ctrl = bitfield_bit32_write(ctrl, DMA_CONTROL_DIGEST_SWAP_BIT, true);
+  ctrl = bitfield_bit32_write(ctrl, DMA_CONTROL_INITIAL_TRANSFER_BIT, true);
+  ctrl = bitfield_bit32_write(ctrl, DMA_CONTROL_GO_BIT, true);
+  abs_mmio_write32(kBase + DMA_CONTROL_REG_OFFSET, ctrl);
+
+  uint32_t status = dma_sha2_wait(len);
+
+  status_t result = OTCRYPTO_RECOV_ERR;
+  const uint32_t kEndMask = (1u << DMA_STATUS_DONE_BIT) |
+                            (1u << DMA_STATUS_ABORTED_BIT) |
+                            (1u << DMA_STATUS_ERROR_BIT) |
+                            (1u << DMA_STATUS_SHA2_DIGEST_VALID_BIT);
+  const uint32_t kSuccess =
+      (1u << DMA_STATUS_DONE_BIT) | (1u << DMA_STATUS_SHA2_DIGEST_VALID_BIT);
+  if (launder32(status & kEndMask) == kSuccess) {
+    HARDENED_CHECK_EQ(status & kEndMask, kSuccess);
+    size_t i = 0;
+    for (; launderw(i) < wordlen; ++i) {
+      digest[i] = abs_mmio_read32(kBase + DMA_SHA2_DIGEST_0_REG_OFFSET +
+                                  i * sizeof(uint32_t));
+    }
+    HARDENED_CHECK_EQ(i, wordlen);
+    result = OTCRYPTO_OK;
+  }
+
+  // Acknowledge only the result bits of this transfer; they were all clear
+  // before it started. Then put back the previous configuration (GO clear).
+  abs_mmio_write32(kBase + DMA_STATUS_REG_OFFSET,
+                   status & kDmaStatusResultMask);
+  for (size_t i = 0; i < ARRAYSIZE(kDmaSha2ConfigRegs); ++i) {
+    uint32_t value = saved[i];
+    if (kDmaSha2ConfigRegs[i] == DMA_CONTROL_REG_OFFSET) {
+      value = bitfield_bit32_write(value, DMA_CONTROL_GO_BIT, false);
+      value = bitfield_bit32_write(value, DMA_CONTROL_ABORT_BIT, false);
+    }
+    abs_mmio_write32(kBase + kDmaSha2ConfigRegs[i], value);
+  }
+  return result;
+}
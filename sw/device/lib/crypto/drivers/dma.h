@@ -0,0 +1,87 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_DMA_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_DMA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+#include "hw/top/dma_regs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  /**
+   * Smallest message that is worth handing to the DMA.
+   *
+   * Below this size, configuring the DMA and polling for completion costs
+   * about as much as feeding the HMAC FIFO from the CPU.
+   */
+  kDmaSha2MinMessageBytes = 4096,
+};
+
+/**
+ * SHA-2 variants supported by the DMA inline hashing engine.
+ */
+typedef enum dma_sha2_mode {
+  kDmaSha2Mode256 = DMA_CONTROL_OPCODE_VALUE_SHA256,
+  kDmaSha2Mode384 = DMA_CONTROL_OPCODE_VALUE_SHA384,
+  kDmaSha2Mode512 = DMA_CONTROL_OPCODE_VALUE_SHA512,
+} dma_sha2_mode_t;
+
+/**
+ * Checks whether a message can be hashed with `dma_sha2`.
+ *
+ * The DMA transfers 32-bit words when hashing inline, so the message must be
+ * word-aligned and a whole number of words long. It must also be at least
+ * `kDmaSha2MinMessageBytes` long. The DMA must be idle, and its enabled
+ * memory range must have been configured, because the DMA rejects every
+ * transfer until then.
+ *
+ * @param data Message to hash.
+ * @param len Message length in bytes.
+ * @return kHardenedBoolTrue if the DMA can hash the message.
+ */
+OT_WARN_UNUSED_RESULT
+hardened_bool_t dma_sha2_usable(const uint8_t *data, size_t len);
+
+/**
+ * Hashes a contiguous message in OpenTitan-internal memory with the DMA.
+ *
+ * The DMA reads the message and hashes it inline, writing the data to a
+ * single scratch word. The CPU only polls for completion. The caller must
+ * check `dma_sha2_usable` first.
+ *
+ * The digest is written in the same byte order as the HMAC driver produces.
+ *
+ * The DMA is shared and has no lock. This function does not start if the DMA
+ * is busy, has a hardware-handshake transfer armed or has a result that was
+ * not collected yet. It only acknowledges the STATUS bits of its own transfer
+ * and restores the configuration registers it overwrote. The completion poll
+ * is bounded; a transfer that does not finish in time is aborted.
+ *
+ * @param mode SHA-2 variant.
+ * @param data Message to hash; must be word-aligned.
+ * @param len Message length in bytes; must be a multiple of 4.
+ * @param[out] digest Buffer for the digest (256, 384 or 512 bits).
+ * @return `OTCRYPTO_OK` on success, `OTCRYPTO_ASYNC_INCOMPLETE` if the DMA is
+ * in use, `OTCRYPTO_RECOV_ERR` if the transfer failed or timed out; callers
+ * should then hash the message another way.
+ */
+OT_WARN_UNUSED_RESULT
+status_t dma_sha2(dma_sha2_mode_t mode, const uint8_t *data, size_t len,
+                  uint32_t *digest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_DMA_H_
@@ -11,6 +11,7 @@
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/msg_fifo.h"
 #include "sw/device/lib/crypto/drivers/rv_core_ibex.h"
 #include "sw/device/lib/crypto/impl/status.h"
 #include "sw/device/lib/crypto/include/integrity.h"
@@ -85,6 +86,11 @@ enum {
    * Let's take a large margin and consider that 200 loops are enough.
    */
   kNumIterTimeout = 200,
+  /* Depth of the message FIFO in 32-bit words (`MsgFifoDepth` in hmac.sv).
+   * The generated `HMAC_MSG_FIFO_SIZE_WORDS` is the size of the window, which
+   * is much larger than the FIFO behind it.
+   */
+  kHmacMsgFifoDepthWords = 32,
 };
 
 /**
@@ -327,28 +333,32 @@ static status_t hmac_context_wipe(hmac_ctx_t *ctx) {
  * @return Result of the operation.
  */
 static status_t msg_fifo_write(const uint8_t *message, size_t message_len) {
-  // TODO(#23191): Should we handle backpressure here?
-  // Begin by writing a one byte at a time until the data is aligned.
-  size_t i = 0;
+  // Read the FIFO depth once and write as much as fits, so that the writes
+  // never stall the bus on a full FIFO and STATUS is read once per burst.
   const uint32_t kBase = hmac_base();
-  for (; misalignment32_of((uintptr_t)(&message[i])) > 0 &&
-         launder32(i) < message_len;
-       i++) {
-    abs_mmio_write8(kBase + HMAC_MSG_FIFO_REG_OFFSET, message[i]);
-  }
-
-  // Write one word at a time as long as there is a full word available.
-  for (; launder32(i + sizeof(uint32_t)) <= message_len;
-       i += sizeof(uint32_t)) {
-    uint32_t next_word = read_32(&message[i]);
-    abs_mmio_write32(kBase + HMAC_MSG_FIFO_REG_OFFSET, next_word);
-  }
-
-  // For the last few bytes, we need to write one byte at a time again.
-  for (; launder32(i) < message_len; i++) {
-    abs_mmio_write8(kBase + HMAC_MSG_FIFO_REG_OFFSET, message[i]);
+  size_t i = 0;
+  uint32_t attempt_cnt = 0;
+  while (launder32(i) < message_len) {
+    uint32_t status = abs_mmio_read32(kBase + HMAC_STATUS_REG_OFFSET);
+    uint32_t depth =
+        bitfield_field32_read(status, HMAC_STATUS_FIFO_DEPTH_FIELD);
+    if (depth > kHmacMsgFifoDepthWords) {
+      return OTCRYPTO_FATAL_ERR;
+    }
+    size_t written = msg_fifo_burst_write(
+        kBase + HMAC_MSG_FIFO_REG_OFFSET, &message[i], message_len - i,
+        kHmacMsgFifoDepthWords - depth, sizeof(uint32_t));
+    if (written == 0) {
+      attempt_cnt++;
+      if (attempt_cnt >= kMsgFifoNumIterTimeout) {
+        return OTCRYPTO_FATAL_ERR;
+      }
+    } else {
+      attempt_cnt = 0;
+    }
+    i += written;
   }
-  // Check that the loops ran for the correct number of iterations.
+  // Check that the loop ran for the correct number of iterations.
   HARDENED_CHECK_EQ(i, message_len);
 
   return LAUNDERED_OTCRYPTO_OK;
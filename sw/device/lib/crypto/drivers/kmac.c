@@ -10,6 +10,7 @@
 #include "sw/device/lib/base/crc32.h"
 #include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/msg_fifo.h"
 #include "sw/device/lib/crypto/drivers/rv_core_ibex.h"
 #include "sw/device/lib/crypto/impl/status.h"
 #include "sw/device/lib/crypto/include/integrity.h"
@@ -377,6 +378,32 @@ static status_t wait_status_bit(uint32_t bit_position, bool bit_value) {
   }
 }
 
+/**
+ * Read the number of free entries in the message FIFO.
+ *
+ * Returns an error if the KMAC block reports a fatal fault or a recoverable
+ * control-update error, as `wait_status_bit` does.
+ *
+ * @param[out] free_entries Number of unoccupied message FIFO entries.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t msg_fifo_free_entries(size_t *free_entries) {
+  uint32_t reg = abs_mmio_read32(kmac_base() + KMAC_STATUS_REG_OFFSET);
+  if (bitfield_bit32_read(reg, KMAC_STATUS_ALERT_FATAL_FAULT_BIT)) {
+    return OTCRYPTO_FATAL_ERR;
+  }
+  if (bitfield_bit32_read(reg, KMAC_STATUS_ALERT_RECOV_CTRL_UPDATE_ERR_BIT)) {
+    return OTCRYPTO_RECOV_ERR;
+  }
+  uint32_t depth = bitfield_field32_read(reg, KMAC_STATUS_FIFO_DEPTH_FIELD);
+  if (depth > KMAC_PARAM_NUM_ENTRIES_MSG_FIFO) {
+    return OTCRYPTO_FATAL_ERR;
+  }
+  *free_entries = KMAC_PARAM_NUM_ENTRIES_MSG_FIFO - depth;
+  return OTCRYPTO_OK;
+}
+
 /**
  * Encode a given integer as byte array and return its size along with it.
  *
@@ -636,30 +663,28 @@ static status_t kmac_process_msg_blocks(
   abs_mmio_write32(kBase + KMAC_CMD_REG_OFFSET, cmd_reg);
   HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_ABSORB_BIT, 1));
 
-  // Begin by writing a one byte at a time until the data is aligned.
+  // Read the free space in the message FIFO once, then write that much of the
+  // message without polling STATUS in between.
+  const uint32_t kFifoAddr = kBase + KMAC_MSG_FIFO_REG_OFFSET;
   size_t i = 0;
-  for (; misalignment32_of((uintptr_t)(&message->data[i])) > 0 &&
-         i < message->len;
-       i++) {
-    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
-    abs_mmio_write8(kBase + KMAC_MSG_FIFO_REG_OFFSET, message->data[i]);
-  }
-
-  // Write one word at a time as long as there is a full word available.
-  for (; i + sizeof(uint32_t) <= message->len; i += sizeof(uint32_t)) {
-    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
-    uint32_t next_word = read_32(&message->data[i]);
-    abs_mmio_write32(kBase + KMAC_MSG_FIFO_REG_OFFSET, next_word);
-  }
-  // Check that the loops ran for the correct number of iterations.
-  HARDENED_CHECK_LT(message->len, i + sizeof(uint32_t));
-
-  // For the last few bytes, we need to write one byte at a time again.
-  for (; i < message->len; i++) {
-    HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
-    abs_mmio_write8(kmac_base() + KMAC_MSG_FIFO_REG_OFFSET, message->data[i]);
+  uint32_t attempt_cnt = 0;
+  while (launder32(i) < message->len) {
+    size_t free_entries;
+    HARDENED_TRY(msg_fifo_free_entries(&free_entries));
+    size_t written = msg_fifo_burst_write(kFifoAddr, &message->data[i],
+                                          message->len - i, free_entries,
+                                          KMAC_PARAM_NUM_BYTES_MSG_FIFO_ENTRY);
+    if (written == 0) {
+      attempt_cnt++;
+      if (attempt_cnt >= kMsgFifoNumIterTimeout) {
+        return OTCRYPTO_FATAL_ERR;
+      }
+    } else {
+      attempt_cnt = 0;
+    }
+    i += written;
   }
-  // Check that the loops ran for the correct number of iterations.
+  // Check that the loop ran for the correct number of iterations.
   HARDENED_CHECK_EQ(i, message->len);
 
   // If operation=KMAC, then we need to write `right_encode(digest->len)`
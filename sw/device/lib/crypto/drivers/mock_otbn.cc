@@ -0,0 +1,132 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/mock_otbn.h"
+
+#include <map>
+
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+/**
+ * Mock of the OTBN driver backed by a host-side model of DMEM.
+ *
+ * Enables on-host unit tests of the code that drives OTBN programs (e.g. the
+ * ECC drivers). No program is ever run: tests stage the outputs they expect
+ * with `test::mock_otbn::SetDmem()` and check what was read back.
+ */
+
+namespace test {
+namespace mock_otbn {
+namespace {
+
+struct State {
+  std::map<otbn_addr_t, uint32_t> dmem;
+  size_t dmem_words_read = 0;
+  size_t dmem_words_written = 0;
+  size_t execute_count = 0;
+  uint32_t instruction_count = 0;
+  uint32_t err_bits = 0;
+};
+
+State &state() {
+  static State *state = new State();
+  return *state;
+}
+
+status_t check_addr(otbn_addr_t addr) {
+  if (addr % sizeof(uint32_t) != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  return OTCRYPTO_OK;
+}
+
+}  // namespace
+
+void Reset() { state() = State(); }
+
+void SetDmem(otbn_addr_t addr, const uint32_t *src, size_t num_words) {
+  for (size_t i = 0; i < num_words; ++i) {
+    state().dmem[addr + i * sizeof(uint32_t)] = src[i];
+  }
+}
+
+uint32_t GetDmemWord(otbn_addr_t addr) {
+  auto it = state().dmem.find(addr);
+  return it == state().dmem.end() ? 0 : it->second;
+}
+
+void SetInstructionCount(uint32_t count) { state().instruction_count = count; }
+
+void SetErrBits(uint32_t err_bits) { state().err_bits = err_bits; }
+
+size_t DmemWordsRead() { return state().dmem_words_read; }
+
+size_t DmemWordsWritten() { return state().dmem_words_written; }
+
+size_t ExecuteCount() { return state().execute_count; }
+
+}  // namespace mock_otbn
+}  // namespace test
+
+extern "C" {
+
+status_t otbn_dmem_write(size_t num_words, const uint32_t *src,
+                         otbn_addr_t dest) {
+  HARDENED_TRY(test::mock_otbn::check_addr(dest));
+  test::mock_otbn::SetDmem(dest, src, num_words);
+  test::mock_otbn::state().dmem_words_written += num_words;
+  return OTCRYPTO_OK;
+}
+
+status_t otbn_dmem_set(size_t num_words, const uint32_t src, otbn_addr_t dest) {
+  HARDENED_TRY(test::mock_otbn::check_addr(dest));
+  for (size_t i = 0; i < num_words; ++i) {
+    test::mock_otbn::state().dmem[dest + i * sizeof(uint32_t)] = src;
+  }
+  test::mock_otbn::state().dmem_words_written += num_words;
+  return OTCRYPTO_OK;
+}
+
+status_t otbn_dmem_read(size_t num_words, otbn_addr_t src, uint32_t *dest) {
+  HARDENED_TRY(test::mock_otbn::check_addr(src));
+  for (size_t i = 0; i < num_words; ++i) {
+    dest[i] = test::mock_otbn::GetDmemWord(src + i * sizeof(uint32_t));
+  }
+  test::mock_otbn::state().dmem_words_read += num_words;
+  return OTCRYPTO_OK;
+}
+
+status_t otbn_execute(void) {
+  test::mock_otbn::state().execute_count++;
+  return OTCRYPTO_OK;
+}
+
+status_t otbn_busy_wait_for_done(void) {
+  if (test::mock_otbn::state().err_bits != 0) {
+    return OTCRYPTO_RECOV_ERR;
+  }
+  return OTCRYPTO_OK;
+}
+
+uint32_t otbn_err_bits_get(void) { return test::mock_otbn::state().err_bits; }
+
+uint32_t otbn_instruction_count_get(void) {
+  return test::mock_otbn::state().instruction_count;
+}
+
+status_t otbn_imem_sec_wipe(void) { return OTCRYPTO_OK; }
+
+status_t otbn_dmem_sec_wipe(void) {
+  test::mock_otbn::state().dmem.clear();
+  return OTCRYPTO_OK;
+}
+
+status_t otbn_set_ctrl_software_errs_fatal(bool enable) { return OTCRYPTO_OK; }
+
+status_t otbn_load_app(const otbn_app_t app) { return OTCRYPTO_OK; }
+
+status_t otbn_ensure_app(const otbn_app_t app) { return OTCRYPTO_OK; }
+
+}  // extern "C"
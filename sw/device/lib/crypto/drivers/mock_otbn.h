@@ -0,0 +1,73 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_MOCK_OTBN_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_MOCK_OTBN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/crypto/drivers/otbn.h"
+
+/**
+ * Controls for the on-host mock of the OTBN driver.
+ *
+ * The mock models DMEM as a sparse map of 32-bit words keyed by
+ * `otbn_addr_t`, so drivers that stage inputs and read back results can run
+ * on the host. It also counts the DMEM words transferred in each direction;
+ * tests use the counts to pin down how many words an operation reads back.
+ */
+
+namespace test {
+namespace mock_otbn {
+
+/**
+ * Clears DMEM, the access counters and the error and instruction counts.
+ */
+void Reset();
+
+/**
+ * Writes `num_words` words to the modelled DMEM without counting them.
+ *
+ * Used by tests to stage the results an OTBN program would produce.
+ */
+void SetDmem(otbn_addr_t addr, const uint32_t *src, size_t num_words);
+
+/**
+ * Reads a single word from the modelled DMEM without counting it.
+ */
+uint32_t GetDmemWord(otbn_addr_t addr);
+
+/**
+ * Sets the value returned by `otbn_instruction_count_get()`.
+ */
+void SetInstructionCount(uint32_t count);
+
+/**
+ * Sets the value returned by `otbn_err_bits_get()`.
+ *
+ * A non-zero value also makes `otbn_busy_wait_for_done()` fail.
+ */
+void SetErrBits(uint32_t err_bits);
+
+/**
+ * Number of DMEM words read through `otbn_dmem_read()` since the last reset.
+ */
+size_t DmemWordsRead();
+
+/**
+ * Number of DMEM words written through `otbn_dmem_write()` or
+ * `otbn_dmem_set()` since the last reset.
+ */
+size_t DmemWordsWritten();
+
+/**
+ * Number of `otbn_execute()` calls since the last reset.
+ */
+size_t ExecuteCount();
+
+}  // namespace mock_otbn
+}  // namespace test
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_MOCK_OTBN_H_
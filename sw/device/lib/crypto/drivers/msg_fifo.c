@@ -0,0 +1,52 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/msg_fifo.h"
+
+#include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/memory.h"
+
+size_t msg_fifo_burst_write(uint32_t fifo_addr, const uint8_t *data,
+                            size_t len, size_t free_entries,
+                            size_t entry_bytes) {
+  // Begin by writing one byte at a time until the data is aligned. Each of
+  // these writes takes a whole FIFO entry.
+  size_t i = 0;
+  for (; misalignment32_of((uintptr_t)(&data[i])) > 0 && launder32(i) < len &&
+         free_entries > 0;
+       i++, free_entries--) {
+    abs_mmio_write8(fifo_addr, data[i]);
+  }
+  if (misalignment32_of((uintptr_t)(&data[i])) > 0) {
+    return i;
+  }
+
+  // Write one word at a time as long as there is a full word available.
+  size_t words = (len - i) / sizeof(uint32_t);
+  size_t max_words = free_entries * (entry_bytes / sizeof(uint32_t));
+  if (words > max_words) {
+    words = max_words;
+  }
+  size_t end = i + words * sizeof(uint32_t);
+  for (; launder32(i) < end; i += sizeof(uint32_t)) {
+    abs_mmio_write32(fifo_addr, read_32(&data[i]));
+  }
+  HARDENED_CHECK_EQ(i, end);
+  if (launder32(i + sizeof(uint32_t)) <= len) {
+    // The FIFO is full; the trailing bytes are not reached yet.
+    return i;
+  }
+
+  // For the last few bytes, we need to write one byte at a time again. A
+  // partially filled entry is counted as used.
+  size_t words_per_entry = entry_bytes / sizeof(uint32_t);
+  free_entries -= (words + words_per_entry - 1) / words_per_entry;
+  for (; launder32(i) < len && free_entries > 0; i++, free_entries--) {
+    abs_mmio_write8(fifo_addr, data[i]);
+  }
+  HARDENED_CHECK_LE(i, len);
+
+  return i;
+}
@@ -0,0 +1,50 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_MSG_FIFO_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_MSG_FIFO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  /**
+   * Number of consecutive FIFO status reads without any free entry after which
+   * the drivers give up on the hash block.
+   */
+  kMsgFifoNumIterTimeout = 1000,
+};
+
+/**
+ * Writes a burst of message bytes to a hash block's message FIFO.
+ *
+ * The caller reads the number of free FIFO entries once and passes it as
+ * `free_entries`. This function writes as much of the message as fits in those
+ * entries without polling the block in between, so that none of the writes
+ * stall the bus.
+ *
+ * Leading and trailing bytes that are not word-aligned are written one at a
+ * time, and each of these writes is counted as a whole FIFO entry. Everything
+ * else is written as 32-bit words, `entry_bytes / 4` of them per entry.
+ *
+ * @param fifo_addr Address of the message FIFO window.
+ * @param data Message bytes still to be written.
+ * @param len Number of bytes in `data`.
+ * @param free_entries Number of free entries in the FIFO.
+ * @param entry_bytes Size of a FIFO entry in bytes, a non-zero multiple of 4.
+ * @return Number of bytes written.
+ */
+size_t msg_fifo_burst_write(uint32_t fifo_addr, const uint8_t *data,
+                            size_t len, size_t free_entries,
+                            size_t entry_bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_MSG_FIFO_H_
@@ -9,8 +9,8 @@
 #include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/base/crc32.h"
 #include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/hardened_mmio.h"
 #include "sw/device/lib/base/macros.h"
-#include "sw/device/lib/base/random_order.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/crypto/impl/status.h"
 
@@ -120,33 +120,28 @@ status_t otbn_dmem_write(size_t num_words, const uint32_t *src,
                          otbn_addr_t dest) {
   HARDENED_TRY(check_offset_len(dest, num_words, kOtbnDMemSizeBytes));
 
-  // Reset the LOAD_CHECKSUM register.
+  // Preserve the resident application tag (see `otbn_ensure_app`) and reset
+  // the LOAD_CHECKSUM register.
+  uint32_t resident =
+      abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   abs_mmio_write32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
 
   // Initialize the CRC.
   uint32_t ctx;
   crc32_init(&ctx);
 
-  // Setup the random order construct.
-  random_order_t order;
-  random_order_init(&order, num_words);
+  // Write the data in blocks, starting from a random word.
+  hardened_mmio_order_t order;
+  hardened_mmio_order_init(&order, num_words, kHardenedMmioProfileRandom);
+  HARDENED_TRY(hardened_mmio_write_block(
+      otbn_base() + OTBN_DMEM_REG_OFFSET + dest, src, &order));
 
+  // Replay the write order to compute the expected CRC.
   size_t count = 0;
-
   for (; launderw(count) < num_words; count = launderw(count) + 1) {
-    // The value obtained from `advance()` is laundered, to prevent
-    // implementation details from leaking across procedures.
-    size_t idx = launderw(random_order_advance(&order));
+    size_t idx = launderw(hardened_mmio_order_index(&order, count));
     size_t idx_word = idx * sizeof(uint32_t);
 
-    // Prevent the compiler from reordering the loop; this ensures a
-    // happens-before among indices consistent with `order`.
-    barrierw(idx);
-
-    // Perform the write.
-    abs_mmio_write32(otbn_base() + OTBN_DMEM_REG_OFFSET + dest + idx_word,
-                     src[idx]);
-
     // Update the CRC. According to the OTBN documentation, each CRC update
     // consists of 48-bit: {imem, idx, wdata}
     // imem: set to 0 for DMEM writes.
@@ -159,7 +154,6 @@ status_t otbn_dmem_write(size_t num_words, const uint32_t *src,
     memcpy(crc_data + sizeof(uint32_t), &offset, 2);
     crc32_add(&ctx, crc_data, sizeof(crc_data));
   }
-  RANDOM_ORDER_HARDENED_CHECK_DONE(order);
   HARDENED_CHECK_EQ(count, num_words);
 
   // Get the computed (expected) checksum, fetch the checksum from the OTBN
@@ -169,6 +163,8 @@ status_t otbn_dmem_write(size_t num_words, const uint32_t *src,
       abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   HARDENED_CHECK_EQ(checksum, checksum_expected);
 
+  abs_mmio_write32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET, resident);
+
   return OTCRYPTO_OK;
 }
 
@@ -178,25 +174,26 @@ status_t otbn_dmem_set(size_t num_words, const uint32_t src, otbn_addr_t dest) {
   // No need to randomize here, since all the values are the same.
   size_t i = 0;
   const uint32_t kBase = otbn_base();
+  uint32_t resident = abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   for (; launder32(i) < num_words; ++i) {
     abs_mmio_write32(kBase + OTBN_DMEM_REG_OFFSET + dest + i * sizeof(uint32_t),
                      src);
     HARDENED_CHECK_LT(i, num_words);
   }
   HARDENED_CHECK_EQ(i, num_words);
+
+  // Restore the resident application tag.
+  abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET, resident);
   return OTCRYPTO_OK;
 }
 
 status_t otbn_dmem_read(size_t num_words, otbn_addr_t src, uint32_t *dest) {
   HARDENED_TRY(check_offset_len(src, num_words, kOtbnDMemSizeBytes));
 
-  size_t i = 0;
-  const uint32_t kBase = otbn_base();
-  for (; launder32(i) < num_words; ++i) {
-    dest[i] = abs_mmio_read32(kBase + OTBN_DMEM_REG_OFFSET + src +
-                              i * sizeof(uint32_t));
-  }
-  HARDENED_CHECK_EQ(i, num_words);
+  hardened_mmio_order_t order;
+  hardened_mmio_order_init(&order, num_words, kHardenedMmioProfileLinear);
+  HARDENED_TRY(hardened_mmio_read_block(
+      otbn_base() + OTBN_DMEM_REG_OFFSET + src, dest, &order));
 
   return OTCRYPTO_OK;
 }
@@ -253,6 +250,8 @@ uint32_t otbn_instruction_count_get(void) {
 
 status_t otbn_imem_sec_wipe(void) {
   HARDENED_TRY(otbn_assert_idle());
+  // No application is resident once IMEM has been wiped.
+  abs_mmio_write32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
   abs_mmio_write32(otbn_base() + OTBN_CMD_REG_OFFSET, kOtbnCmdSecWipeImem);
   HARDENED_TRY(otbn_busy_wait_for_done());
   return OTCRYPTO_OK;
@@ -310,6 +309,54 @@ static status_t check_app_address_ranges(const otbn_app_t *app) {
   return OTCRYPTO_OK;
 }
 
+/**
+ * Recomputes the load checksum of the application resident in OTBN.
+ *
+ * The LOAD_CHECKSUM register only tells which image this driver loaded last;
+ * it does not change when IMEM is wiped or modified by other means. This
+ * function instead reads back all of IMEM and computes the checksum that
+ * `otbn_load_app` would produce with the resident instructions and the data
+ * segment of `app`, in the same write order. OTBN must be idle, since IMEM
+ * reads return zero otherwise.
+ *
+ * @param app The application expected to be resident.
+ * @return `kHardenedBoolTrue` if the checksum matches `app.checksum`.
+ */
+static hardened_bool_t resident_checksum_check(const otbn_app_t *app) {
+  const size_t imem_num_words = (size_t)(app->imem_end - app->imem_start);
+  const size_t data_num_words =
+      (size_t)(app->dmem_data_end - app->dmem_data_start);
+  const uint32_t imem_base = otbn_base() + OTBN_IMEM_REG_OFFSET;
+
+  // Each write adds the 48-bit value {imem, idx (15b), wdata} to the CRC.
+  uint32_t ctx;
+  crc32_init(&ctx);
+  char crc_data[6];
+  size_t i = 0;
+  for (; launderw(i) < imem_num_words; ++i) {
+    uint32_t word = abs_mmio_read32(imem_base + i * sizeof(uint32_t));
+    uint16_t idx = (uint16_t)(0x8000 | (i & 0x7FFF));
+    memcpy(crc_data, &word, sizeof(uint32_t));
+    memcpy(crc_data + sizeof(uint32_t), &idx, sizeof(idx));
+    crc32_add(&ctx, crc_data, sizeof(crc_data));
+  }
+  HARDENED_CHECK_EQ(i, imem_num_words);
+  for (i = 0; launderw(i) < data_num_words; ++i) {
+    uint16_t idx = (uint16_t)(((app->dmem_data_start_addr >> 2) + i) & 0x7FFF);
+    memcpy(crc_data, &app->dmem_data_start[i], sizeof(uint32_t));
+    memcpy(crc_data + sizeof(uint32_t), &idx, sizeof(idx));
+    crc32_add(&ctx, crc_data, sizeof(crc_data));
+  }
+  HARDENED_CHECK_EQ(i, data_num_words);
+
+  uint32_t checksum = crc32_finish(&ctx);
+  if (launder32(checksum) != app->checksum) {
+    return kHardenedBoolFalse;
+  }
+  HARDENED_CHECK_EQ(checksum, app->checksum);
+  return kHardenedBoolTrue;
+}
+
 status_t otbn_load_app(const otbn_app_t app) {
   HARDENED_TRY(check_app_address_ranges(&app));
 
@@ -356,13 +403,59 @@ status_t otbn_load_app(const otbn_app_t app) {
   }
   HARDENED_CHECK_EQ(i, data_num_words);
 
-  // Ensure that the checksum matches expectations.
+  // Ensure that the checksum matches expectations. On success the checksum
+  // remains in the LOAD_CHECKSUM register to identify the resident
+  // application; on failure it is cleared so that the image is not mistaken
+  // for any other.
   uint32_t checksum =
       abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   if (launder32(checksum) != app.checksum) {
+    abs_mmio_write32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
     return OTCRYPTO_FATAL_ERR;
   }
   HARDENED_CHECK_EQ(checksum, app.checksum);
 
   return OTCRYPTO_OK;
 }
+
+status_t otbn_ensure_app(const otbn_app_t app) {
+  HARDENED_TRY(check_app_address_ranges(&app));
+
+  // Ensure OTBN is idle.
+  HARDENED_TRY(otbn_assert_idle());
+
+  // The LOAD_CHECKSUM register identifies the resident application; if it
+  // does not match then fall back to loading the entire application.
+  uint32_t resident =
+      abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET);
+  if (launder32(resident) != app.checksum) {
+    return otbn_load_app(app);
+  }
+  HARDENED_CHECK_EQ(
+      abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET),
+      app.checksum);
+
+  // The tag alone does not prove that IMEM is intact. Reload if the last run
+  // ended with an error or if the checksum of the resident image does not
+  // match the application.
+  if (launder32(otbn_err_bits_get()) != kOtbnErrBitsNoError ||
+      launder32(resident_checksum_check(&app)) != kHardenedBoolTrue) {
+    return otbn_load_app(app);
+  }
+  HARDENED_CHECK_EQ(otbn_err_bits_get(), kOtbnErrBitsNoError);
+
+  // IMEM already holds the application, so only DMEM needs to be wiped and
+  // its data portion reloaded.
+  HARDENED_TRY(otbn_dmem_sec_wipe());
+
+  const size_t data_num_words =
+      (size_t)(app.dmem_data_end - app.dmem_data_start);
+  if (data_num_words > 0) {
+    // Writes are checked against a CRC computed in software, and the
+    // resident application tag is preserved.
+    HARDENED_TRY(otbn_dmem_write(data_num_words, app.dmem_data_start,
+                                 app.dmem_data_start_addr));
+  }
+
+  return OTCRYPTO_OK;
+}
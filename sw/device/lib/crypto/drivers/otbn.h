@@ -215,7 +215,12 @@ typedef struct otbn_app {
  * Uses inline assembly to force an absolute load.
  * This prevents the compiler from emitting PC-relative instructions
  * which would break position-independent code (PIC) for the binary blob.
+ *
+ * On the host, where there is no OTBN address space, the address is simply
+ * the (truncated) address of the symbol, which the mock OTBN driver uses to
+ * key its model of DMEM.
  */
+#ifdef OT_PLATFORM_RV32
 #define OTBN_ADDR_T_INIT(app_name, symbol_name)                                       \
   ({                                                                                  \
     uint32_t _otbn_addr;                                                              \
@@ -225,6 +230,10 @@ typedef struct otbn_app {
       : "=r"(_otbn_addr)); \
     _otbn_addr;                                                                       \
   })
+#else  // OT_PLATFORM_RV32
+#define OTBN_ADDR_T_INIT(app_name, symbol_name) \
+  ((otbn_addr_t)(uintptr_t)OTBN_SYMBOL_ADDR(app_name, symbol_name))
+#endif  // OT_PLATFORM_RV32
 
 /**
  * Write to OTBN's data memory (DMEM)
@@ -381,6 +390,37 @@ status_t otbn_set_ctrl_software_errs_fatal(bool enable);
  */
 status_t otbn_load_app(const otbn_app_t app);
 
+/**
+ * Ensures that the provided application is loaded into OTBN.
+ *
+ * If the application's IMEM image is already resident, only DMEM is wiped and
+ * the data segment reloaded; otherwise this is equivalent to `otbn_load_app`.
+ * This avoids rewriting IMEM when the same application is used repeatedly.
+ *
+ * The resident application is identified by the LOAD_CHECKSUM register, which
+ * holds the application checksum after a successful `otbn_load_app`. The
+ * driver preserves it across DMEM writes and clears it when IMEM is wiped.
+ * Code that writes OTBN memories without using this driver changes the
+ * register value, which causes the next call to perform a full load.
+ *
+ * The register is not a checksum of the current IMEM contents: it does not
+ * change when IMEM is wiped or modified without a bus write (e.g. by a
+ * hardware-initiated secure wipe or a fault). Before skipping the load, this
+ * function therefore also requires ERR_BITS to be clear, reads back all of
+ * IMEM and checks that the load checksum of the resident instructions and the
+ * application's data segment matches `app.checksum`. Any change to IMEM
+ * causes a full load.
+ *
+ * This function will return an error if called when OTBN is not idle.
+ *
+ * Because this function uses the OTBN secure wipe functionality, it will lock
+ * OTBN if the entropy complex is not initialized.
+ *
+ * @param app The application to load into OTBN.
+ * @return The result of the operation.
+ */
+status_t otbn_ensure_app(const otbn_app_t app);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,8 @@
 
 #include "hw/top/dt/otbn.h"
 #include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/crc32.h"
+#include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
 #include "sw/device/lib/crypto/impl/status.h"
@@ -20,6 +22,7 @@
 
 #define CMD_EXECUTE 0xd8
 #define CMD_SEC_WIPE_DMEM 0xc3
+#define CMD_SEC_WIPE_IMEM 0x1e
 
 OTTF_DEFINE_TEST_CONFIG();
 
@@ -54,6 +57,7 @@ static status_t run_negative_test(void) {
                               .dmem_data_start_addr = 0,
                               .checksum = 0};
   CHECK(otbn_load_app(bad_range_app).value == OTCRYPTO_BAD_ARGS.value);
+  CHECK(otbn_ensure_app(bad_range_app).value == OTCRYPTO_BAD_ARGS.value);
 
   // Force OTBN out of the IDLE state by manually triggering a Secure Wipe.
   abs_mmio_write32(otbn_base() + OTBN_CMD_REG_OFFSET, CMD_SEC_WIPE_DMEM);
@@ -74,6 +78,76 @@ static status_t run_negative_test(void) {
                                  .checksum = 0xDEADBEEF};
   CHECK(otbn_load_app(bad_checksum_app).value == OTCRYPTO_FATAL_ERR.value);
 
+  // A failed load must not leave the application marked as resident, so this
+  // performs (and fails) a full load too.
+  CHECK(abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET) !=
+        bad_checksum_app.checksum);
+  CHECK(otbn_ensure_app(bad_checksum_app).value == OTCRYPTO_FATAL_ERR.value);
+
+  return OTCRYPTO_OK;
+}
+
+// Two-instruction image for `run_ensure_app_test`; it is never executed.
+static const uint32_t kTinyImem[] = {0x00000013, 0x0000000b};
+
+/**
+ * Computes the LOAD_CHECKSUM value expected after loading `kTinyImem`.
+ *
+ * Each IMEM write adds the 48-bit value {imem=1, idx (15b), wdata} to the CRC.
+ */
+static uint32_t tiny_imem_checksum(void) {
+  uint32_t ctx;
+  crc32_init(&ctx);
+  for (uint16_t i = 0; i < ARRAYSIZE(kTinyImem); ++i) {
+    char crc_data[6];
+    uint16_t idx = 0x8000 | i;
+    memcpy(crc_data, &kTinyImem[i], sizeof(uint32_t));
+    memcpy(crc_data + sizeof(uint32_t), &idx, sizeof(idx));
+    crc32_add(&ctx, crc_data, sizeof(crc_data));
+  }
+  return crc32_finish(&ctx);
+}
+
+static status_t run_ensure_app_test(void) {
+  LOG_INFO("Running otbn_ensure_app tests.");
+
+  otbn_app_t app = {.imem_start = kTinyImem,
+                    .imem_end = kTinyImem + ARRAYSIZE(kTinyImem),
+                    .dmem_data_start = kTinyImem,
+                    .dmem_data_end = kTinyImem,
+                    .dmem_data_start_addr = 0,
+                    .checksum = tiny_imem_checksum()};
+  TRY(otbn_load_app(app));
+  TRY_CHECK(abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET) ==
+            app.checksum);
+
+  // Wipe IMEM behind the driver's back. LOAD_CHECKSUM still names the app, so
+  // `otbn_ensure_app` must notice the wipe from the IMEM contents and reload.
+  abs_mmio_write32(otbn_base() + OTBN_CMD_REG_OFFSET, CMD_SEC_WIPE_IMEM);
+  TRY(otbn_busy_wait_for_done());
+  TRY_CHECK(abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET) ==
+            app.checksum);
+
+  TRY(otbn_ensure_app(app));
+  for (size_t i = 0; i < ARRAYSIZE(kTinyImem); ++i) {
+    TRY_CHECK(abs_mmio_read32(otbn_base() + OTBN_IMEM_REG_OFFSET +
+                              i * sizeof(uint32_t)) == kTinyImem[i]);
+  }
+
+  // With IMEM intact, a second call keeps the image.
+  TRY(otbn_ensure_app(app));
+  TRY_CHECK(abs_mmio_read32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET) ==
+            app.checksum);
+
+  // Change a single instruction and restore the tag, as a fault could. The
+  // full checksum of the resident image must catch it.
+  abs_mmio_write32(otbn_base() + OTBN_IMEM_REG_OFFSET + sizeof(uint32_t),
+                   kTinyImem[1] ^ 1);
+  abs_mmio_write32(otbn_base() + OTBN_LOAD_CHECKSUM_REG_OFFSET, app.checksum);
+  TRY(otbn_ensure_app(app));
+  TRY_CHECK(abs_mmio_read32(otbn_base() + OTBN_IMEM_REG_OFFSET +
+                            sizeof(uint32_t)) == kTinyImem[1]);
+
   return OTCRYPTO_OK;
 }
 
@@ -83,6 +157,7 @@ bool test_main(void) {
   CHECK_STATUS_OK(entropy_complex_init(kHardenedBoolFalse));
 
   EXECUTE_TEST(result, run_negative_test);
+  EXECUTE_TEST(result, run_ensure_app_test);
 
   return status_ok(result);
 }
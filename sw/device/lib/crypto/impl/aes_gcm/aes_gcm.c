@@ -504,6 +504,155 @@ status_t aes_gcm_update_aad(aes_gcm_context_t *ctx,
   return OTCRYPTO_OK;
 }
 
+/**
+ * Runs GCTR and then GHASH over a chunk of encrypted-data input.
+ *
+ * This is the straightforward path: GCTR processes the entire chunk before
+ * GHASH absorbs the resulting ciphertext. Handles partial blocks on both ends
+ * and updates `ctx->input_len`.
+ *
+ * @param ctx AES-GCM context.
+ * @param input_len Number of input bytes.
+ * @param input Input data.
+ * @param output Output buffer (enough space for all full blocks).
+ * @param[out] bytes_written Number of output bytes written.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t aes_gcm_update_serial(aes_gcm_context_t *ctx, size_t input_len,
+                                      const uint8_t *input, uint8_t *output,
+                                      size_t *bytes_written) {
+  // Process any full blocks of input with GCTR to generate more ciphertext.
+  size_t partial_aes_block_len = ctx->input_len % kAesBlockNumBytes;
+  HARDENED_TRY(aes_gcm_gctr(ctx->key, &ctx->gctr_iv, partial_aes_block_len,
+                            &ctx->partial_aes_block, input_len, input,
+                            ctx->security_level, bytes_written, output));
+
+  // Accumulate any new ciphertext to the GHASH context. The ciphertext is the
+  // output for encryption, and the input for decryption.
+  if (ctx->is_encrypt == kHardenedBoolTrue) {
+    // Since we only generate ciphertext in full-block increments, no partial
+    // blocks are possible in this case.
+    if (*bytes_written % kGhashBlockNumBytes != 0) {
+      return OTCRYPTO_RECOV_ERR;
+    }
+    otcrypto_const_byte_buf_t written_buf =
+        OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, output, *bytes_written);
+    HARDENED_TRY(ghash_process_full_blocks(&ctx->ghash_ctx, /*partial_len=*/0,
+                                           &ctx->partial_ghash_block,
+                                           &written_buf));
+  } else if (ctx->is_encrypt == kHardenedBoolFalse) {
+    size_t partial_ghash_block_len = ctx->input_len % kGhashBlockNumBytes;
+    otcrypto_const_byte_buf_t input_buf =
+        OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, input, input_len);
+    HARDENED_TRY(ghash_process_full_blocks(&ctx->ghash_ctx,
+                                           partial_ghash_block_len,
+                                           &ctx->partial_ghash_block,
+                                           &input_buf));
+  } else {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  ctx->input_len += input_len;
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Runs GCTR and GHASH over full blocks with the two stages overlapped.
+ *
+ * Block i+1 is handed to the AES block before the CPU absorbs the ciphertext
+ * of block i into GHASH, so the hardware encrypts the next block while the
+ * software GHASH runs. All blocks of a run share one CTR-mode session instead
+ * of reconfiguring the AES block for every block.
+ *
+ * Only used at the low security level; the higher levels decrypt every block
+ * again to detect faults, which needs a separate AES operation per block.
+ *
+ * The hardware CTR mode increments the full 128-bit counter, whereas GCM's
+ * inc32 wraps within the last 32 bits, so a run stops where the last counter
+ * word would wrap and the next run restarts from the software-wrapped IV.
+ *
+ * Expects `ctx->input_len` to be block-aligned. Updates `ctx->gctr_iv` and the
+ * GHASH state, but not `ctx->input_len`.
+ *
+ * @param ctx AES-GCM context.
+ * @param num_blocks Number of full blocks to process.
+ * @param input Input data (`num_blocks` blocks).
+ * @param[out] output Output buffer (`num_blocks` blocks).
+ */
+OT_WARN_UNUSED_RESULT
+static status_t aes_gcm_update_pipelined(aes_gcm_context_t *ctx,
+                                         size_t num_blocks,
+                                         const uint8_t *input,
+                                         uint8_t *output) {
+  // Key must be intended for CTR mode.
+  if (ctx->key.mode != kAesCipherModeCtr) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (ctx->is_encrypt != kHardenedBoolTrue &&
+      ctx->is_encrypt != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  while (num_blocks > 0) {
+    // Find how many blocks can be processed before the counter word wraps. A
+    // difference of zero means the full 2^32 blocks are available.
+    uint32_t ctr = __builtin_bswap32(ctx->gctr_iv.data[kAesBlockNumWords - 1]);
+    uint32_t blocks_to_wrap = 0u - ctr;
+    size_t run_len = num_blocks;
+    if (blocks_to_wrap != 0 && run_len > blocks_to_wrap) {
+      run_len = blocks_to_wrap;
+    }
+
+    aes_block_t block_in;
+    aes_block_t block_out;
+    ghash_block_t ciphertext;
+    HARDENED_TRY(aes_encrypt_begin(ctx->key, &ctx->gctr_iv));
+    randomized_bytecopy(block_in.data, input, kAesBlockNumBytes);
+    HARDENED_TRY(aes_update(/*dest=*/NULL, &block_in));
+
+    size_t i = 0;
+    for (; launder32(i) < run_len; i++) {
+      // For decryption the ciphertext is the input; save it before the input
+      // block is reused.
+      if (ctx->is_encrypt == kHardenedBoolFalse) {
+        HARDENED_TRY(hardened_memcpy(ciphertext.data, block_in.data,
+                                     kAesBlockNumWords));
+      }
+
+      // Collect block i and feed block i+1, if any.
+      const aes_block_t *next = NULL;
+      if (i + 1 < run_len) {
+        randomized_bytecopy(block_in.data,
+                            input + ((i + 1) << kAesBlockLog2NumBytes),
+                            kAesBlockNumBytes);
+        next = &block_in;
+      }
+      HARDENED_TRY(aes_update(&block_out, next));
+      randomized_bytecopy(output + (i << kAesBlockLog2NumBytes),
+                          block_out.data, kAesBlockNumBytes);
+
+      // Absorb block i into GHASH while the AES block works on block i+1.
+      if (ctx->is_encrypt == kHardenedBoolTrue) {
+        HARDENED_TRY(hardened_memcpy(ciphertext.data, block_out.data,
+                                     kAesBlockNumWords));
+      }
+      HARDENED_TRY(ghash_process_block(&ctx->ghash_ctx, &ciphertext));
+    }
+    HARDENED_CHECK_EQ(i, run_len);
+    HARDENED_TRY(aes_end(NULL));
+
+    // Advance the counter as inc32 would have.
+    ctx->gctr_iv.data[kAesBlockNumWords - 1] =
+        __builtin_bswap32(ctr + (uint32_t)run_len);
+
+    input += run_len << kAesBlockLog2NumBytes;
+    output += run_len << kAesBlockLog2NumBytes;
+    num_blocks -= run_len;
+  }
+
+  return OTCRYPTO_OK;
+}
+
 status_t aes_gcm_update_encrypted_data(aes_gcm_context_t *ctx,
                                        const otcrypto_const_byte_buf_t *input,
                                        otcrypto_byte_buf_t *output,
@@ -538,36 +687,48 @@ status_t aes_gcm_update_encrypted_data(aes_gcm_context_t *ctx,
     }
   }
 
-  // Process any full blocks of input with GCTR to generate more ciphertext.
-  size_t partial_aes_block_len = ctx->input_len % kAesBlockNumBytes;
-  HARDENED_TRY(aes_gcm_gctr(ctx->key, &ctx->gctr_iv, partial_aes_block_len,
-                            &ctx->partial_aes_block, input->len, input->data,
-                            ctx->security_level, bytes_written, output->data));
+  if (launder32(ctx->security_level) == kOtcryptoKeySecurityLevelLow) {
+    HARDENED_CHECK_EQ(ctx->security_level, kOtcryptoKeySecurityLevelLow);
+    // Complete any partial block left over from a previous call first, so
+    // that the pipeline below starts on a block boundary.
+    size_t head_len = 0;
+    size_t written = 0;
+    size_t partial_len = ctx->input_len % kAesBlockNumBytes;
+    if (partial_len != 0) {
+      head_len = kAesBlockNumBytes - partial_len;
+      if (head_len > input->len) {
+        head_len = input->len;
+      }
+      HARDENED_TRY(aes_gcm_update_serial(ctx, head_len, input->data,
+                                         output->data, &written));
+    }
 
-  // Accumulate any new ciphertext to the GHASH context. The ciphertext is the
-  // output for encryption, and the input for decryption.
-  if (ctx->is_encrypt == kHardenedBoolTrue) {
-    // Since we only generate ciphertext in full-block increments, no partial
-    // blocks are possible in this case.
-    if (*bytes_written % kGhashBlockNumBytes != 0) {
-      return OTCRYPTO_RECOV_ERR;
+    // Run the full blocks through the overlapped GCTR/GHASH pipeline.
+    size_t num_blocks = (input->len - head_len) >> kAesBlockLog2NumBytes;
+    size_t blocks_len = num_blocks << kAesBlockLog2NumBytes;
+    HARDENED_TRY(aes_gcm_update_pipelined(ctx, num_blocks,
+                                          input->data + head_len,
+                                          output->data + written));
+    ctx->input_len += blocks_len;
+    written += blocks_len;
+
+    // Buffer any trailing partial block. This produces no output.
+    size_t tail_offset = head_len + blocks_len;
+    if (tail_offset < input->len) {
+      size_t tail_written;
+      HARDENED_TRY(aes_gcm_update_serial(ctx, input->len - tail_offset,
+                                         input->data + tail_offset,
+                                         output->data + written,
+                                         &tail_written));
+      written += tail_written;
     }
-    otcrypto_const_byte_buf_t written_buf = OTCRYPTO_MAKE_BUF(
-        otcrypto_const_byte_buf_t, output->data, *bytes_written);
-    HARDENED_TRY(ghash_process_full_blocks(&ctx->ghash_ctx, /*partial_len=*/0,
-                                           &ctx->partial_ghash_block,
-                                           &written_buf));
-  } else if (ctx->is_encrypt == kHardenedBoolFalse) {
-    size_t partial_ghash_block_len = ctx->input_len % kGhashBlockNumBytes;
-    HARDENED_TRY(ghash_process_full_blocks(&ctx->ghash_ctx,
-                                           partial_ghash_block_len,
-                                           &ctx->partial_ghash_block, input));
+    *bytes_written = written;
   } else {
-    return OTCRYPTO_BAD_ARGS;
+    HARDENED_CHECK_NE(ctx->security_level, kOtcryptoKeySecurityLevelLow);
+    HARDENED_TRY(aes_gcm_update_serial(ctx, input->len, input->data,
+                                       output->data, bytes_written));
   }
 
-  ctx->input_len += input->len;
-
   HARDENED_CHECK_EQ(kHardenedBoolTrue, OTCRYPTO_CHECK_BUF(output));
 
   return OTCRYPTO_OK;
@@ -9,6 +9,7 @@
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/rv_core_ibex.h"
+#include "sw/device/lib/crypto/impl/aes_gcm/ghash_clmul.h"
 #include "sw/device/lib/crypto/include/integrity.h"
 
 // Module ID for status codes.
@@ -49,9 +50,11 @@ static_assert(kGhashBlockNumBytes == (1 << kGhashBlockLog2NumBytes),
  * table of a given hash subkey becomes higher, so larger windows are slower
  * for smaller inputs but faster for large inputs.
  */
+#if !GHASH_CLMUL_ENABLED
 static const uint16_t kGFReduceTable[16] = {
     0x0000, 0x201c, 0x4038, 0x6024, 0x8070, 0xa06c, 0xc048, 0xe054,
     0x00e1, 0x20fd, 0x40d9, 0x60c5, 0x8091, 0xa08d, 0xc0a9, 0xe0b5};
+#endif
 
 /**
  * Performs a bitwise XOR of two blocks.
@@ -222,12 +225,20 @@ status_t ghash_init(ghash_context_t *ctx) {
  * This operation corresponds to multiplication in the Galois field with order
  * 2^128, modulo the polynomial x^128 +  x^8 + x^2 + x + 1
  *
+ * If the target has carry-less multiply instructions, the table is only used
+ * for its entry 1 * H (index 0x8) and the product is computed directly.
+ *
  * @param state GHASH state.
  * @param tbl Product table for the masked hash subkey.
  * @return Multiplication of the state and the hash subkey.
  */
 static ghash_block_t galois_mul_state_key(ghash_block_t state,
                                           ghash_block_t tbl[16]) {
+#if GHASH_CLMUL_ENABLED
+  ghash_block_t result;
+  ghash_clmul_mul(state.data, tbl[0x8].data, result.data);
+  return result;
+#else
   // Initialize the multiplication result to 0.
   ghash_block_t result;
   memset(result.data, 0, kGhashBlockNumBytes);
@@ -273,16 +284,10 @@ static ghash_block_t galois_mul_state_key(ghash_block_t state,
     block_xor(&result, &tbl[tbl_index], &result);
   }
   return result;
+#endif
 }
 
-/**
- * Single-block update function for GHASH.
- *
- * @param ctx GHASH context.
- * @param block Block to incorporate.
- */
-static status_t ghash_process_block(ghash_context_t *ctx,
-                                    ghash_block_t *block) {
+status_t ghash_process_block(ghash_context_t *ctx, ghash_block_t *block) {
   ghash_block_t s0_tmp;
   ghash_block_t s1_tmp;
 
@@ -131,6 +131,16 @@ status_t ghash_init_subkey(const uint32_t *hash_subkey, ghash_block_t *tbl);
  */
 status_t ghash_init(ghash_context_t *ctx);
 
+/**
+ * Single-block update function for GHASH.
+ *
+ * Incorporates exactly one full block into the state.
+ *
+ * @param ctx Context object.
+ * @param block Block to incorporate.
+ */
+status_t ghash_process_block(ghash_context_t *ctx, ghash_block_t *block);
+
 /**
  * Given a partial GHASH block and some new input, process full blocks.
  *
@@ -0,0 +1,125 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/impl/aes_gcm/ghash_clmul.h"
+
+#include <stddef.h>
+
+enum {
+  /**
+   * Number of words in a GHASH block.
+   */
+  kClmulBlockNumWords = 4,
+};
+
+/**
+ * Carry-less multiply two 32-bit words into a 64-bit product.
+ *
+ * @param a First operand.
+ * @param b Second operand.
+ * @param[out] lo Low 32 bits of the product.
+ * @param[out] hi High 32 bits of the product.
+ */
+static inline void clmul32(uint32_t a, uint32_t b, uint32_t *lo,
+                           uint32_t *hi) {
+#if GHASH_CLMUL_ENABLED
+  asm("clmul %0, %1, %2" : "=r"(*lo) : "r"(a), "r"(b));
+  asm("clmulh %0, %1, %2" : "=r"(*hi) : "r"(a), "r"(b));
+#else
+  // Constant-time emulation: add a shifted copy of `a` for each set bit of
+  // `b`, selected with a mask rather than a branch.
+  uint64_t acc = 0;
+  for (size_t i = 0; i < 32; ++i) {
+    uint64_t mask = 0 - (uint64_t)((b >> i) & 1);
+    acc ^= ((uint64_t)a << i) & mask;
+  }
+  *lo = (uint32_t)acc;
+  *hi = (uint32_t)(acc >> 32);
+#endif
+}
+
+/**
+ * Carry-less multiply two 64-bit values with one level of Karatsuba.
+ *
+ * @param a0 Low word of the first operand.
+ * @param a1 High word of the first operand.
+ * @param b0 Low word of the second operand.
+ * @param b1 High word of the second operand.
+ * @param[out] r 128-bit product (4 words, least significant first).
+ */
+static inline void clmul64(uint32_t a0, uint32_t a1, uint32_t b0, uint32_t b1,
+                           uint32_t *r) {
+  uint32_t lo[2];
+  uint32_t hi[2];
+  uint32_t mid[2];
+  clmul32(a0, b0, &lo[0], &lo[1]);
+  clmul32(a1, b1, &hi[0], &hi[1]);
+  clmul32(a0 ^ a1, b0 ^ b1, &mid[0], &mid[1]);
+  mid[0] ^= lo[0] ^ hi[0];
+  mid[1] ^= lo[1] ^ hi[1];
+  r[0] = lo[0];
+  r[1] = lo[1] ^ mid[0];
+  r[2] = hi[0] ^ mid[1];
+  r[3] = hi[1];
+}
+
+void ghash_clmul_mul(const uint32_t *x, const uint32_t *h, uint32_t *out) {
+  // GCM stores the coefficient of x^0 in the most significant bit of the first
+  // byte. Loading each block as a big-endian 128-bit integer (least
+  // significant word first) gives the bit-reflected polynomial.
+  uint32_t a[kClmulBlockNumWords];
+  uint32_t b[kClmulBlockNumWords];
+  for (size_t i = 0; i < kClmulBlockNumWords; ++i) {
+    a[i] = __builtin_bswap32(x[kClmulBlockNumWords - 1 - i]);
+    b[i] = __builtin_bswap32(h[kClmulBlockNumWords - 1 - i]);
+  }
+
+  // 128x128-bit carry-less product with Karatsuba over 64-bit halves.
+  uint32_t lo[4];
+  uint32_t hi[4];
+  uint32_t mid[4];
+  clmul64(a[0], a[1], b[0], b[1], lo);
+  clmul64(a[2], a[3], b[2], b[3], hi);
+  clmul64(a[0] ^ a[2], a[1] ^ a[3], b[0] ^ b[2], b[1] ^ b[3], mid);
+  uint32_t z[2 * kClmulBlockNumWords];
+  for (size_t i = 0; i < 4; ++i) {
+    mid[i] ^= lo[i] ^ hi[i];
+  }
+  z[0] = lo[0];
+  z[1] = lo[1];
+  z[2] = lo[2] ^ mid[0];
+  z[3] = lo[3] ^ mid[1];
+  z[4] = hi[0] ^ mid[2];
+  z[5] = hi[1] ^ mid[3];
+  z[6] = hi[2];
+  z[7] = hi[3];
+
+  // The product of two reflected 128-bit values is the reflected 255-bit
+  // product; shift left by one so that it is the reflected 256-bit product.
+  for (size_t i = 2 * kClmulBlockNumWords - 1; i > 0; --i) {
+    z[i] = (z[i] << 1) | (z[i - 1] >> 31);
+  }
+  z[0] <<= 1;
+
+  // Reduce modulo x^128 + x^7 + x^2 + x + 1. In the reflected representation
+  // the low half holds the high-degree terms. Multiplying them by
+  // (x^7 + x^2 + x + 1) is a right shift by 0, 1, 2 and 7; the bits shifted
+  // out at the bottom are first folded back in at the top.
+  uint32_t g[kClmulBlockNumWords];
+  for (size_t i = 0; i < kClmulBlockNumWords; ++i) {
+    g[i] = z[i];
+  }
+  g[3] ^= (z[0] << 31) ^ (z[0] << 30) ^ (z[0] << 25);
+  uint32_t r[kClmulBlockNumWords];
+  for (size_t i = 0; i < kClmulBlockNumWords - 1; ++i) {
+    r[i] = z[kClmulBlockNumWords + i] ^ g[i] ^ (g[i] >> 1) ^
+           (g[i + 1] << 31) ^ (g[i] >> 2) ^ (g[i + 1] << 30) ^ (g[i] >> 7) ^
+           (g[i + 1] << 25);
+  }
+  r[3] = z[7] ^ g[3] ^ (g[3] >> 1) ^ (g[3] >> 2) ^ (g[3] >> 7);
+
+  for (size_t i = 0; i < kClmulBlockNumWords; ++i) {
+    out[i] = __builtin_bswap32(r[kClmulBlockNumWords - 1 - i]);
+  }
+}
@@ -0,0 +1,50 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_AES_GCM_GHASH_CLMUL_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_AES_GCM_GHASH_CLMUL_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Whether GHASH should use the carry-less multiply kernel.
+ *
+ * The kernel is always built so that it can be tested on the host, but GHASH
+ * only selects it when the target implements the Zbc `clmul`/`clmulh`
+ * instructions; otherwise the 4-bit table implementation is faster.
+ */
+#if defined(OT_PLATFORM_RV32) && defined(__riscv_zbc)
+#define GHASH_CLMUL_ENABLED 1
+#else
+#define GHASH_CLMUL_ENABLED 0
+#endif
+
+/**
+ * Multiply two elements of the GCM Galois field with carry-less multiplies.
+ *
+ * Computes x * h modulo x^128 + x^7 + x^2 + x + 1 on GCM's bit-reflected
+ * block representation. The product is computed with two levels of Karatsuba
+ * (nine 32x32-bit carry-less multiplies) and reduced with shifts and XORs.
+ *
+ * On RV32 targets with Zbc, the 32x32-bit products use `clmul`/`clmulh`; on
+ * other targets they are emulated in constant time.
+ *
+ * Both operands and the result are blocks of 4 words in the same memory
+ * layout as `ghash_block_t`. The output may alias either input.
+ *
+ * @param x First operand.
+ * @param h Second operand (typically the hash subkey).
+ * @param[out] out Product.
+ */
+void ghash_clmul_mul(const uint32_t *x, const uint32_t *h, uint32_t *out);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_AES_GCM_GHASH_CLMUL_H_
@@ -9,6 +9,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "sw/device/lib/base/mock_crc32.h"
+#include "sw/device/lib/crypto/impl/aes_gcm/ghash_clmul.h"
 #include "sw/device/lib/crypto/impl/status.h"
 #include "sw/device/lib/crypto/include/integrity.h"
 
@@ -421,5 +422,157 @@ TEST(Ghash, McGrawViegaTestCase18) {
   EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
 }
 
+TEST(Ghash, ClmulMcGrawViegaTestCase2) {
+  // Single multiplication from test case 2 of:
+  // https://csrc.nist.rip/groups/ST/toolkit/BCM/documents/proposedmodes/gcm/gcm-spec.pdf
+  //
+  // H: 66e94bd4ef8a2c3b884cfa59ca342b2e
+  // C: 0388dace60b6a392f328c2b971b2fe78
+  // C * H: 5e2ec746917062882c85b0685353deb7
+  std::array<uint32_t, 4> H = {
+      0xd44be966,
+      0x3b2c8aef,
+      0x59fa4c88,
+      0x2e2b34ca,
+  };
+  std::array<uint32_t, 4> C = {
+      0xceda8803,
+      0x92a3b660,
+      0xb9c228f3,
+      0x78feb271,
+  };
+  std::array<uint32_t, 4> exp_result = {
+      0x46c72e5e,
+      0x88627091,
+      0x68b0852c,
+      0xb7de5353,
+  };
+
+  uint32_t result[kGhashBlockNumWords];
+  ghash_clmul_mul(C.data(), H.data(), result);
+  EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
+
+  // The output may alias an input.
+  ghash_clmul_mul(C.data(), H.data(), C.data());
+  EXPECT_THAT(C, testing::ElementsAreArray(exp_result));
+}
+
+/**
+ * Computes `x * h` with the table-based GHASH.
+ *
+ * GHASH of a single block `x` under the hash subkey `h` is `x * h`. Also
+ * checks that entry 0x8 of the product table is `h` itself, which is the
+ * operand the carry-less multiply kernel takes from the table.
+ */
+std::array<uint32_t, 4> TableMul(const std::array<uint32_t, 4> &x,
+                                 const std::array<uint32_t, 4> &h) {
+  rom_test::MockCrc32 crc32_;
+  EXPECT_CALL(crc32_, Init(testing::NotNull())).Times(testing::AnyNumber());
+  EXPECT_CALL(crc32_, Add(testing::NotNull(), testing::_, testing::_))
+      .Times(testing::AnyNumber());
+  EXPECT_CALL(crc32_, Finish(testing::NotNull()))
+      .Times(testing::AnyNumber())
+      .WillRepeatedly(testing::Return(0));
+
+  ghash_context_t ctx;
+  EXPECT_OK(ghash_init_subkey(h.data(), ctx.tbl0));
+  EXPECT_OK(ghash_init_subkey(Zero.data(), ctx.tbl1));
+  EXPECT_THAT(ctx.tbl0[0x8].data, testing::ElementsAreArray(h));
+  EXPECT_OK(
+      ghash_handle_enc_initial_counter_block(Zero.data(), Zero.data(), &ctx));
+  EXPECT_OK(ghash_init(&ctx));
+  otcrypto_const_byte_buf_t x_buf =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, (const uint8_t *)x.data(),
+                        x.size() * sizeof(uint32_t));
+  EXPECT_OK(ghash_update(&ctx, &x_buf));
+  std::array<uint32_t, 4> result;
+  EXPECT_OK(ghash_final(&ctx, result.data()));
+  return result;
+}
+
+TEST(Ghash, ClmulMatchesTableKnownVectors) {
+  // H: 66e94bd4ef8a2c3b884cfa59ca342b2e
+  std::array<uint32_t, 4> H = {
+      0xd44be966,
+      0x3b2c8aef,
+      0x59fa4c88,
+      0x2e2b34ca,
+  };
+  // C: 0388dace60b6a392f328c2b971b2fe78
+  std::array<uint32_t, 4> C = {
+      0xceda8803,
+      0x92a3b660,
+      0xb9c228f3,
+      0x78feb271,
+  };
+  // Big-endian form of 1.
+  std::array<uint32_t, 4> One = {0x80, 0, 0, 0};
+  std::array<uint32_t, 4> Ones = {
+      0xffffffff,
+      0xffffffff,
+      0xffffffff,
+      0xffffffff,
+  };
+
+  struct MulVector {
+    std::array<uint32_t, 4> x;
+    std::array<uint32_t, 4> h;
+    std::array<uint32_t, 4> exp_result;
+  };
+  // Expected products were computed with a bitwise reference implementation
+  // of the GCM multiplication (algorithm 1 of the GCM spec).
+  const MulVector kVectors[] = {
+      // All-zero key.
+      {C, Zero, Zero},
+      {Ones, Zero, Zero},
+      // All-zero input.
+      {Zero, H, Zero},
+      {Zero, Ones, Zero},
+      // Multiplication by 1.
+      {One, H, H},
+      {One, Ones, Ones},
+      {Ones, One, Ones},
+      // All-ones key.
+      {Ones, Ones, {0xaaaa02f4, 0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa}},
+      {H, Ones, {0xf0c62dcb, 0x8df150b9, 0x746c399e, 0x0c5a0238}},
+      {C, Ones, {0x418c8166, 0xb3e7dad8, 0x5a00d040, 0x6bc664e4}},
+      // C * H from test case 2 of the GCM spec.
+      {C, H, {0x46c72e5e, 0x88627091, 0x68b0852c, 0xb7de5353}},
+  };
+
+  for (const MulVector &vec : kVectors) {
+    std::array<uint32_t, 4> clmul_result;
+    ghash_clmul_mul(vec.x.data(), vec.h.data(), clmul_result.data());
+    EXPECT_THAT(clmul_result, testing::ElementsAreArray(vec.exp_result));
+    EXPECT_THAT(TableMul(vec.x, vec.h),
+                testing::ElementsAreArray(vec.exp_result));
+  }
+}
+
+TEST(Ghash, ClmulMatchesTable) {
+  // Compare the carry-less multiply kernel against the table-based GHASH
+  // (which the host build always uses) for pseudo-random operands.
+  uint32_t lfsr = 0x9e3779b9;
+  auto next_word = [&lfsr]() {
+    lfsr ^= lfsr << 13;
+    lfsr ^= lfsr >> 17;
+    lfsr ^= lfsr << 5;
+    return lfsr;
+  };
+
+  for (size_t i = 0; i < 64; ++i) {
+    std::array<uint32_t, 4> H;
+    std::array<uint32_t, 4> X;
+    for (size_t j = 0; j < kGhashBlockNumWords; ++j) {
+      H[j] = next_word();
+      X[j] = next_word();
+    }
+
+    std::array<uint32_t, 4> clmul_result;
+    ghash_clmul_mul(X.data(), H.data(), clmul_result.data());
+    EXPECT_THAT(clmul_result, testing::ElementsAreArray(TableMul(X, H)));
+  }
+}
+
 }  // namespace
 }  // namespace ghash_unittest
@@ -65,26 +65,14 @@ enum {
       (kOtbnWideWordNumWords -
        (kP256MaskedScalarShareWords % kOtbnWideWordNumWords)) %
       kOtbnWideWordNumWords,
-  /*
-   * The expected instruction counts for constant time functions.
-   */
-  kModeKeygenInsCnt = 573922,
-  kModeKeygenSideloadInsCnt = 573814,
-  kModeEcdhInsCnt = 581607,
-  kModeEcdhSideloadInsCnt = 581672,
-  kModeEcdsaSignConfigKInsCnt = 607096,
-  kModeEcdsaSignInsCnt = 606946,
-  kModeEcdsaSignSideloadInsCnt = 607161,
-  kModePointOnCurveCheckInsCnt = 224,
-  kModeBasePointMultInsCnt = 573756,
-  kModeArithShareSecretKeyInsCnt = 147,
 };
 
 OT_NOINLINE OT_WARN_UNUSED_RESULT static status_t p256_init_otbn(
     uint32_t mode) {
-  // Load the P-256 app. Fails if OTBN is non-idle.
+  // Load the P-256 app, reusing the IMEM image if it is already resident.
+  // Fails if OTBN is non-idle.
   const otbn_app_t kOtbnAppP256 = OTBN_APP_T_INIT(run_p256);
-  HARDENED_TRY(otbn_load_app(kOtbnAppP256));
+  HARDENED_TRY(otbn_ensure_app(kOtbnAppP256));
   // Set mode so start() will jump into the requested routine.
   const otbn_addr_t kOtbnVarMode = OTBN_ADDR_T_INIT(run_p256, mode);
   return otbn_dmem_write(kOtbnP256ModeWords, &mode, kOtbnVarMode);
@@ -261,7 +249,7 @@ status_t p256_keygen_finalize(p256_masked_scalar_t *private_key,
                               p256_point_t *public_key) {
   // Spin here waiting for OTBN to complete.
   HARDENED_TRY(otbn_busy_wait_for_done());
-  HARDENED_CHECK_EQ(otbn_instruction_count_get(), kModeKeygenInsCnt);
+  HARDENED_CHECK_EQ(otbn_instruction_count_get(), kP256KeygenInsCnt);
 
   // Read the masked private key from OTBN dmem.
   const otbn_addr_t kOtbnVarD0 = OTBN_ADDR_T_INIT(run_p256, d0_io);
@@ -282,7 +270,7 @@ status_t p256_keygen_finalize(p256_masked_scalar_t *private_key,
 status_t p256_sideload_keygen_finalize(p256_point_t *public_key) {
   // Spin here waiting for OTBN to complete.
   HARDENED_TRY(otbn_busy_wait_for_done());
-  HARDENED_CHECK_EQ(otbn_instruction_count_get(), kModeKeygenSideloadInsCnt);
+  HARDENED_CHECK_EQ(otbn_instruction_count_get(), kP256KeygenSideloadInsCnt);
 
   // Read the public key from OTBN dmem.
   HARDENED_TRY(p256_read_point(public_key));
@@ -364,12 +352,12 @@ status_t p256_ecdsa_sign_finalize(p256_ecdsa_signature_t *result) {
   // Spin here waiting for OTBN to complete.
   HARDENED_TRY(otbn_busy_wait_for_done());
   ins_cnt = otbn_instruction_count_get();
-  if (launder32(ins_cnt) == kModeEcdsaSignSideloadInsCnt) {
-    HARDENED_CHECK_EQ(ins_cnt, kModeEcdsaSignSideloadInsCnt);
-  } else if (launder32(ins_cnt) == kModeEcdsaSignConfigKInsCnt) {
-    HARDENED_CHECK_EQ(ins_cnt, kModeEcdsaSignConfigKInsCnt);
+  if (launder32(ins_cnt) == kP256EcdsaSignSideloadInsCnt) {
+    HARDENED_CHECK_EQ(ins_cnt, kP256EcdsaSignSideloadInsCnt);
+  } else if (launder32(ins_cnt) == kP256EcdsaSignConfigKInsCnt) {
+    HARDENED_CHECK_EQ(ins_cnt, kP256EcdsaSignConfigKInsCnt);
   } else {
-    HARDENED_CHECK_EQ(ins_cnt, kModeEcdsaSignInsCnt);
+    HARDENED_CHECK_EQ(ins_cnt, kP256EcdsaSignInsCnt);
   }
 
   // Read signature R out of OTBN dmem.
@@ -464,10 +452,10 @@ status_t p256_ecdh_finalize(p256_ecdh_shared_key_t *shared_key) {
   // OTBN returned the status code OK, so check for the expected instr. count.
   uint32_t ins_cnt;
   ins_cnt = otbn_instruction_count_get();
-  if (launder32(ins_cnt) == kModeEcdhSideloadInsCnt) {
-    HARDENED_CHECK_EQ(ins_cnt, kModeEcdhSideloadInsCnt);
+  if (launder32(ins_cnt) == kP256EcdhSideloadInsCnt) {
+    HARDENED_CHECK_EQ(ins_cnt, kP256EcdhSideloadInsCnt);
   } else {
-    HARDENED_CHECK_EQ(ins_cnt, kModeEcdhInsCnt);
+    HARDENED_CHECK_EQ(ins_cnt, kP256EcdhInsCnt);
   }
 
   // Read the shares of the key from OTBN dmem (at vars x and y).
@@ -505,7 +493,7 @@ status_t p256_point_on_curve_check(const p256_point_t *point,
   HARDENED_TRY(otbn_busy_wait_for_done());
 
   // Check if we executed the expected number of OTBN instructions.
-  HARDENED_CHECK_EQ(otbn_instruction_count_get(), kModePointOnCurveCheckInsCnt);
+  HARDENED_CHECK_EQ(otbn_instruction_count_get(), kP256PointOnCurveCheckInsCnt);
 
   // Read the result of the OTBN operation.
   const otbn_addr_t kOtbnVarOk = OTBN_ADDR_T_INIT(run_p256, ok);
@@ -532,7 +520,7 @@ status_t p256_base_point_mult(p256_masked_scalar_t *private_key,
   HARDENED_TRY(otbn_busy_wait_for_done());
 
   // Check if we executed the expected number of OTBN instructions.
-  HARDENED_CHECK_EQ(otbn_instruction_count_get(), kModeBasePointMultInsCnt);
+  HARDENED_CHECK_EQ(otbn_instruction_count_get(), kP256BasePointMultInsCnt);
 
   HARDENED_TRY(p256_read_point(public_key));
 
@@ -560,7 +548,7 @@ status_t p256_arith_share_private_key(p256_masked_scalar_t *boolean_private_key,
 
   // Check if we executed the expected number of OTBN instructions.
   HARDENED_CHECK_EQ(otbn_instruction_count_get(),
-                    kModeArithShareSecretKeyInsCnt);
+                    kP256ArithShareSecretKeyInsCnt);
 
   // Read back the shared private key.
   HARDENED_TRY(otbn_dmem_read(kP256MaskedScalarShareWords, kOtbnVarD0,
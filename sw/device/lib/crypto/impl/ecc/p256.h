@@ -79,6 +79,24 @@ enum {
   kDiceAttestationMaxSeedLength = 512 / 32,
 };
 
+/**
+ * Expected OTBN instruction counts of the constant-time P-256 operations.
+ *
+ * Checked against the OTBN instruction counter after each operation.
+ */
+enum {
+  kP256KeygenInsCnt = 573922,
+  kP256KeygenSideloadInsCnt = 573814,
+  kP256EcdhInsCnt = 581607,
+  kP256EcdhSideloadInsCnt = 581672,
+  kP256EcdsaSignConfigKInsCnt = 607096,
+  kP256EcdsaSignInsCnt = 606946,
+  kP256EcdsaSignSideloadInsCnt = 607161,
+  kP256PointOnCurveCheckInsCnt = 224,
+  kP256BasePointMultInsCnt = 573756,
+  kP256ArithShareSecretKeyInsCnt = 147,
+};
+
 /**
  * A type that holds a masked value from the P-256 scalar field.
  *
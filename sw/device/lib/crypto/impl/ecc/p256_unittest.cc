@@ -0,0 +1,205 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/impl/ecc/p256.h"
+
+#include <algorithm>
+#include <array>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/crypto/drivers/mock_otbn.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+// Stand-ins for the symbols of the `run_p256` OTBN app. On the host, the
+// mock OTBN driver keys DMEM by the address of these arrays, so each one is
+// large enough that no variable overlaps the next.
+#define P256_UNITTEST_SYMBOL(sym) \
+  extern const uint32_t OTBN_SYMBOL_ADDR(run_p256, sym)[32] = {0}
+
+#define P256_UNITTEST_APP_PTR(sym) \
+  extern const uint32_t OTBN_SYMBOL_PTR(run_p256, sym)[1] = {0}
+
+extern "C" {
+P256_UNITTEST_APP_PTR(_imem_start);
+P256_UNITTEST_APP_PTR(_imem_end);
+P256_UNITTEST_APP_PTR(_dmem_data_start);
+P256_UNITTEST_APP_PTR(_dmem_data_end);
+P256_UNITTEST_SYMBOL(_dmem_data_start);
+P256_UNITTEST_SYMBOL(_checksum);
+P256_UNITTEST_SYMBOL(mode);
+P256_UNITTEST_SYMBOL(msg);
+P256_UNITTEST_SYMBOL(r);
+P256_UNITTEST_SYMBOL(s);
+P256_UNITTEST_SYMBOL(x);
+P256_UNITTEST_SYMBOL(y);
+P256_UNITTEST_SYMBOL(d0_io);
+P256_UNITTEST_SYMBOL(d1_io);
+P256_UNITTEST_SYMBOL(k0_io);
+P256_UNITTEST_SYMBOL(k1_io);
+P256_UNITTEST_SYMBOL(x_r);
+P256_UNITTEST_SYMBOL(ok);
+P256_UNITTEST_SYMBOL(attestation_additional_seed);
+P256_UNITTEST_SYMBOL(MODE_KEYGEN);
+P256_UNITTEST_SYMBOL(MODE_SIGN);
+P256_UNITTEST_SYMBOL(MODE_SIGN_CONFIG_K);
+P256_UNITTEST_SYMBOL(MODE_VERIFY);
+P256_UNITTEST_SYMBOL(MODE_ECDH);
+P256_UNITTEST_SYMBOL(MODE_SIDELOAD_KEYGEN);
+P256_UNITTEST_SYMBOL(MODE_SIDELOAD_SIGN);
+P256_UNITTEST_SYMBOL(MODE_SIDELOAD_ECDH);
+P256_UNITTEST_SYMBOL(MODE_POINTONCRV_CHECK);
+P256_UNITTEST_SYMBOL(MODE_BASE_POINT_MULT);
+P256_UNITTEST_SYMBOL(MODE_ARITH_SHARE_SECRET_KEY);
+}  // extern "C"
+
+namespace p256_unittest {
+namespace {
+using ::testing::ElementsAreArray;
+
+#define EXPECT_OK(status_) EXPECT_EQ(status_.value, OTCRYPTO_OK.value)
+#define EXPECT_NOT_OK(status_) EXPECT_NE(status_.value, OTCRYPTO_OK.value)
+
+constexpr std::array<uint32_t, kP256CoordWords> kX = {
+    0x00000001, 0x00000002, 0x00000003, 0x00000004,
+    0x00000005, 0x00000006, 0x00000007, 0x00000008,
+};
+constexpr std::array<uint32_t, kP256CoordWords> kY = {
+    0x10000001, 0x10000002, 0x10000003, 0x10000004,
+    0x10000005, 0x10000006, 0x10000007, 0x10000008,
+};
+
+class P256Test : public testing::Test {
+ protected:
+  void SetUp() override { test::mock_otbn::Reset(); }
+
+  // Stages the value of the `ok` status word.
+  void SetOk(hardened_bool_t ok) {
+    uint32_t word = ok;
+    test::mock_otbn::SetDmem(OTBN_ADDR_T_INIT(run_p256, ok), &word, 1);
+  }
+
+  // Stages a point in the `x` and `y` variables.
+  void SetPoint() {
+    test::mock_otbn::SetDmem(OTBN_ADDR_T_INIT(run_p256, x), kX.data(),
+                             kX.size());
+    test::mock_otbn::SetDmem(OTBN_ADDR_T_INIT(run_p256, y), kY.data(),
+                             kY.size());
+  }
+};
+
+TEST_F(P256Test, KeygenFinalizeReadsKeyAndPoint) {
+  SetPoint();
+  test::mock_otbn::SetInstructionCount(kP256KeygenInsCnt);
+
+  p256_masked_scalar_t private_key;
+  p256_point_t public_key;
+  EXPECT_OK(p256_keygen_finalize(&private_key, &public_key));
+  EXPECT_THAT(public_key.x, ElementsAreArray(kX));
+  EXPECT_THAT(public_key.y, ElementsAreArray(kY));
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(),
+            2 * kP256MaskedScalarShareWords + 2 * kP256CoordWords);
+}
+
+TEST_F(P256Test, SideloadKeygenFinalizeReadsPointOnly) {
+  SetPoint();
+  test::mock_otbn::SetInstructionCount(kP256KeygenSideloadInsCnt);
+
+  p256_point_t public_key;
+  EXPECT_OK(p256_sideload_keygen_finalize(&public_key));
+  EXPECT_THAT(public_key.x, ElementsAreArray(kX));
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(), 2 * kP256CoordWords);
+}
+
+TEST_F(P256Test, EcdsaSignFinalizeReadsSignatureOnly) {
+  test::mock_otbn::SetDmem(OTBN_ADDR_T_INIT(run_p256, r), kX.data(),
+                           kX.size());
+  test::mock_otbn::SetDmem(OTBN_ADDR_T_INIT(run_p256, s), kY.data(),
+                           kY.size());
+  test::mock_otbn::SetInstructionCount(kP256EcdsaSignInsCnt);
+
+  p256_ecdsa_signature_t signature;
+  EXPECT_OK(p256_ecdsa_sign_finalize(&signature));
+  EXPECT_THAT(signature.r, ElementsAreArray(kX));
+  EXPECT_THAT(signature.s, ElementsAreArray(kY));
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(), 2 * kP256ScalarWords);
+}
+
+TEST_F(P256Test, EcdsaVerifyFinalizeReadsStatusAndRecoveredR) {
+  SetOk(kHardenedBoolTrue);
+  test::mock_otbn::SetDmem(OTBN_ADDR_T_INIT(run_p256, x_r), kX.data(),
+                           kX.size());
+
+  p256_ecdsa_signature_t signature;
+  std::copy(kX.begin(), kX.end(), signature.r);
+  std::copy(kY.begin(), kY.end(), signature.s);
+  hardened_bool_t result;
+  EXPECT_OK(p256_ecdsa_verify_finalize(&signature, &result));
+  EXPECT_EQ(result, kHardenedBoolTrue);
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(), 1 + kP256ScalarWords);
+}
+
+TEST_F(P256Test, EcdsaVerifyFinalizeStopsAfterFailedStatus) {
+  SetOk(kHardenedBoolFalse);
+
+  p256_ecdsa_signature_t signature;
+  std::copy(kX.begin(), kX.end(), signature.r);
+  std::copy(kY.begin(), kY.end(), signature.s);
+  hardened_bool_t result;
+  EXPECT_NOT_OK(p256_ecdsa_verify_finalize(&signature, &result));
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(), 1);
+}
+
+TEST_F(P256Test, EcdhFinalizeReadsStatusAndBothShares) {
+  SetOk(kHardenedBoolTrue);
+  SetPoint();
+  test::mock_otbn::SetInstructionCount(kP256EcdhInsCnt);
+
+  // The `x` and `y` variables hold the two Boolean shares of the shared
+  // x-coordinate, so both must be read back.
+  p256_ecdh_shared_key_t shared_key;
+  EXPECT_OK(p256_ecdh_finalize(&shared_key));
+  EXPECT_THAT(shared_key.share0, ElementsAreArray(kX));
+  EXPECT_THAT(shared_key.share1, ElementsAreArray(kY));
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(), 1 + 2 * kP256CoordWords);
+}
+
+TEST_F(P256Test, EcdhFinalizeStopsAfterFailedStatus) {
+  SetOk(kHardenedBoolFalse);
+  SetPoint();
+
+  p256_ecdh_shared_key_t shared_key;
+  EXPECT_NOT_OK(p256_ecdh_finalize(&shared_key));
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(), 1);
+}
+
+TEST_F(P256Test, PointOnCurveCheckReadsStatusOnly) {
+  SetOk(kHardenedBoolTrue);
+  test::mock_otbn::SetInstructionCount(kP256PointOnCurveCheckInsCnt);
+
+  p256_point_t point;
+  std::copy(kX.begin(), kX.end(), point.x);
+  std::copy(kY.begin(), kY.end(), point.y);
+  hardened_bool_t result;
+  EXPECT_OK(p256_point_on_curve_check(&point, &result));
+  EXPECT_EQ(result, kHardenedBoolTrue);
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(), 1);
+  EXPECT_EQ(test::mock_otbn::DmemWordsWritten(), 1 + 2 * kP256CoordWords);
+}
+
+TEST_F(P256Test, BasePointMultReadsPointOnly) {
+  test::mock_otbn::SetInstructionCount(kP256BasePointMultInsCnt);
+
+  p256_masked_scalar_t private_key = {0};
+  private_key.checksum = p256_masked_scalar_checksum(&private_key);
+  p256_point_t public_key;
+  EXPECT_OK(p256_base_point_mult(&private_key, &public_key));
+  EXPECT_EQ(test::mock_otbn::ExecuteCount(), 1);
+  EXPECT_EQ(test::mock_otbn::DmemWordsRead(), 2 * kP256CoordWords);
+}
+
+}  // namespace
+}  // namespace p256_unittest
@@ -97,7 +97,7 @@ enum {
 OT_NOINLINE OT_WARN_UNUSED_RESULT static status_t p384_init_otbn(
     uint32_t mode) {
   const otbn_app_t kOtbnAppP384 = OTBN_APP_T_INIT(run_p384);
-  HARDENED_TRY(otbn_load_app(kOtbnAppP384));
+  HARDENED_TRY(otbn_ensure_app(kOtbnAppP384));
   const otbn_addr_t kOtbnVarMode = OTBN_ADDR_T_INIT(run_p384, mode);
   return otbn_dmem_write(kP384ModeWords, &mode, kOtbnVarMode);
 }
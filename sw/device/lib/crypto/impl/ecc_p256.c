@@ -271,6 +271,61 @@ static otcrypto_status_t otcrypto_ecdsa_p256_sign_async_start_setup(
   return OTCRYPTO_OK;
 }
 
+/**
+ * Performs input validation for ECDSA P-256 signature verification.
+ *
+ * Shared by the single and batch verification entry points, so that the
+ * batch routine can validate the next tuple while OTBN is still busy with
+ * the current one.
+ *
+ * @param public_key The unblinded public key to verify against.
+ * @param message_digest The pre-computed hash digest that was signed.
+ * @param signature The signature to be verified.
+ * @return OK if all security and parameter checks pass, or BAD_ARGS if
+ *         inputs are invalid, mismatched, or if a fault is detected.
+ */
+OT_NOINLINE
+OT_WARN_UNUSED_RESULT
+static otcrypto_status_t otcrypto_ecdsa_p256_verify_async_start_setup(
+    const otcrypto_unblinded_key_t *public_key,
+    const otcrypto_hash_digest_t message_digest,
+    const otcrypto_const_word32_buf_t *signature) {
+#ifndef OTCRYPTO_DISABLE_NULL_CHECKS
+  if (public_key == NULL || signature == NULL || signature->data == NULL ||
+      message_digest.data == NULL || public_key->key == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+#endif
+
+  // Check the integrity of the public key.
+  if (otcrypto_integrity_unblinded_key_check(public_key) != kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(
+      launder32(otcrypto_integrity_unblinded_key_check(public_key)),
+      kHardenedBoolTrue);
+
+  // Check the public key mode.
+  if (public_key->key_mode != kOtcryptoKeyModeEcdsaP256) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(launder32(public_key->key_mode), kOtcryptoKeyModeEcdsaP256);
+
+  // Check the public key size.
+  HARDENED_TRY(p256_public_key_length_check(public_key));
+
+  // Check the digest length.
+  if (message_digest.len != kP256ScalarWords) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(launder32(message_digest.len), kP256ScalarWords);
+
+  // Check the signature lengths.
+  HARDENED_TRY(p256_signature_length_check(signature->len));
+
+  return OTCRYPTO_OK;
+}
+
 otcrypto_status_t otcrypto_ecdsa_p256_keygen(
     otcrypto_blinded_key_t *private_key, otcrypto_unblinded_key_t *public_key) {
   HARDENED_TRY(otcrypto_ecdsa_p256_keygen_async_start(private_key));
@@ -336,6 +391,65 @@ otcrypto_status_t otcrypto_ecdsa_p256_verify(
                                                    verification_result);
 }
 
+otcrypto_status_t otcrypto_ecdsa_p256_verify_batch(
+    const otcrypto_unblinded_key_t *public_keys,
+    const otcrypto_hash_digest_t *message_digests,
+    const otcrypto_const_word32_buf_t *signatures, size_t num_signatures,
+    hardened_bool_t *verification_results) {
+#ifndef OTCRYPTO_DISABLE_NULL_CHECKS
+  if (public_keys == NULL || message_digests == NULL || signatures == NULL ||
+      verification_results == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+#endif
+  if (num_signatures == 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  for (size_t i = 0; i < num_signatures; i++) {
+    verification_results[i] = kHardenedBoolFalse;
+  }
+
+  // Validate and start the first verification; this loads the application if
+  // necessary, and every later start only rewrites DMEM.
+  HARDENED_TRY(otcrypto_ecdsa_p256_verify_async_start(
+      &public_keys[0], message_digests[0], &signatures[0]));
+
+  size_t i = 0;
+  for (; launder32(i) < num_signatures; ++i) {
+    // Validate the next tuple on Ibex whilst OTBN is busy with this one. DMEM
+    // is inaccessible until OTBN is idle, so this is the work we can overlap.
+    size_t next = i + 1;
+    otcrypto_status_t next_status = OTCRYPTO_OK;
+    if (next < num_signatures) {
+      next_status = otcrypto_ecdsa_p256_verify_async_start_setup(
+          &public_keys[next], message_digests[next], &signatures[next]);
+    }
+
+    // Collect the result; this waits for OTBN and wipes DMEM.
+    HARDENED_TRY(otcrypto_ecdsa_p256_verify_async_finalize(
+        &signatures[i], &verification_results[i]));
+
+    if (next < num_signatures) {
+      HARDENED_TRY(next_status);
+      p256_point_t *pk = (p256_point_t *)public_keys[next].key;
+      p256_ecdsa_signature_t *sig =
+          (p256_ecdsa_signature_t *)signatures[next].data;
+      HARDENED_TRY(
+          p256_ecdsa_verify_start(sig, message_digests[next].data, pk));
+
+      // As for the single-shot API, check the key integrity again to detect a
+      // forged pointer handed to the ECC implementation.
+      HARDENED_CHECK_EQ(
+          otcrypto_integrity_unblinded_key_check(&public_keys[next]),
+          kHardenedBoolTrue);
+    }
+  }
+  HARDENED_CHECK_EQ(i, num_signatures);
+
+  return otcrypto_eval_exit(OTCRYPTO_OK);
+}
+
 otcrypto_status_t otcrypto_ecdsa_p256_sign_verify(
     const otcrypto_blinded_key_t *private_key,
     const otcrypto_unblinded_key_t *public_key,
@@ -624,39 +738,9 @@ otcrypto_status_t otcrypto_ecdsa_p256_verify_async_start(
     const otcrypto_unblinded_key_t *public_key,
     const otcrypto_hash_digest_t message_digest,
     const otcrypto_const_word32_buf_t *signature) {
-#ifndef OTCRYPTO_DISABLE_NULL_CHECKS
-  if (public_key == NULL || signature->data == NULL ||
-      message_digest.data == NULL || public_key->key == NULL) {
-    return OTCRYPTO_BAD_ARGS;
-  }
-#endif
-
-  // Check the integrity of the public key.
-  if (otcrypto_integrity_unblinded_key_check(public_key) != kHardenedBoolTrue) {
-    return OTCRYPTO_BAD_ARGS;
-  }
-  HARDENED_CHECK_EQ(
-      launder32(otcrypto_integrity_unblinded_key_check(public_key)),
-      kHardenedBoolTrue);
-
-  // Check the public key mode.
-  if (public_key->key_mode != kOtcryptoKeyModeEcdsaP256) {
-    return OTCRYPTO_BAD_ARGS;
-  }
-  HARDENED_CHECK_EQ(launder32(public_key->key_mode), kOtcryptoKeyModeEcdsaP256);
-
-  // Check the public key size.
-  HARDENED_TRY(p256_public_key_length_check(public_key));
+  HARDENED_TRY(otcrypto_ecdsa_p256_verify_async_start_setup(
+      public_key, message_digest, signature));
   p256_point_t *pk = (p256_point_t *)public_key->key;
-
-  // Check the digest length.
-  if (message_digest.len != kP256ScalarWords) {
-    return OTCRYPTO_BAD_ARGS;
-  }
-  HARDENED_CHECK_EQ(launder32(message_digest.len), kP256ScalarWords);
-
-  // Check the signature lengths.
-  HARDENED_TRY(p256_signature_length_check(signature->len));
   p256_ecdsa_signature_t *sig = (p256_ecdsa_signature_t *)signature->data;
 
   // Start the asynchronous signature-verification routine.
@@ -12,6 +12,10 @@
 #include "sw/device/lib/crypto/include/config.h"
 #include "sw/device/lib/crypto/include/integrity.h"
 
+#ifdef HAS_DMA
+#include "sw/device/lib/crypto/drivers/dma.h"
+#endif
+
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('s', 'h', '2')
 
@@ -20,6 +24,35 @@ static_assert(
     sizeof(otcrypto_sha2_context_t) == sizeof(hmac_ctx_t),
     "`otcrypto_sha2_context_t` must be the same size as `hmac_ctx_t`.");
 
+#ifdef HAS_DMA
+/**
+ * Tries to hash a one-shot message with the DMA's inline SHA-2 engine.
+ *
+ * Large contiguous buffers are hashed inline by the DMA instead of being
+ * pushed through the HMAC message FIFO by the CPU. If the DMA cannot take the
+ * message, is in use, or reports an error, the caller hashes the message with
+ * the HMAC block instead.
+ *
+ * @param mode SHA-2 variant.
+ * @param message Message to hash.
+ * @param[out] digest Digest buffer.
+ * @return kHardenedBoolTrue if `digest` holds the DMA result.
+ */
+static hardened_bool_t sha2_dma_try(dma_sha2_mode_t mode,
+                                    const otcrypto_const_byte_buf_t *message,
+                                    otcrypto_hash_digest_t *digest) {
+  if (dma_sha2_usable(message->data, message->len) != kHardenedBoolTrue) {
+    return kHardenedBoolFalse;
+  }
+  status_t result = dma_sha2(mode, message->data, message->len, digest->data);
+  if (launder32(OT_UNSIGNED(result.value)) != OTCRYPTO_OK.value) {
+    return kHardenedBoolFalse;
+  }
+  HARDENED_CHECK_EQ(result.value, OTCRYPTO_OK.value);
+  return kHardenedBoolTrue;
+}
+#endif
+
 otcrypto_status_t otcrypto_sha2_256(const otcrypto_const_byte_buf_t *message,
                                     otcrypto_hash_digest_t *digest) {
 #ifndef OTCRYPTO_DISABLE_NULL_CHECKS
@@ -37,6 +70,12 @@ otcrypto_status_t otcrypto_sha2_256(const otcrypto_const_byte_buf_t *message,
   HARDENED_CHECK_EQ(digest->len, kHmacSha256DigestWords);
   digest->mode = kOtcryptoHashModeSha256;
 
+#ifdef HAS_DMA
+  if (sha2_dma_try(kDmaSha2Mode256, message, digest) == kHardenedBoolTrue) {
+    return otcrypto_eval_exit(OTCRYPTO_OK);
+  }
+#endif
+
   return otcrypto_eval_exit(hmac_hash_sha256(message, digest->data));
 }
 
@@ -57,6 +96,12 @@ otcrypto_status_t otcrypto_sha2_384(const otcrypto_const_byte_buf_t *message,
   HARDENED_CHECK_EQ(digest->len, kHmacSha384DigestWords);
   digest->mode = kOtcryptoHashModeSha384;
 
+#ifdef HAS_DMA
+  if (sha2_dma_try(kDmaSha2Mode384, message, digest) == kHardenedBoolTrue) {
+    return otcrypto_eval_exit(OTCRYPTO_OK);
+  }
+#endif
+
   return otcrypto_eval_exit(hmac_hash_sha384(message, digest->data));
 }
 
@@ -77,6 +122,12 @@ otcrypto_status_t otcrypto_sha2_512(const otcrypto_const_byte_buf_t *message,
   HARDENED_CHECK_EQ(digest->len, kHmacSha512DigestWords);
   digest->mode = kOtcryptoHashModeSha512;
 
+#ifdef HAS_DMA
+  if (sha2_dma_try(kDmaSha2Mode512, message, digest) == kHardenedBoolTrue) {
+    return otcrypto_eval_exit(OTCRYPTO_OK);
+  }
+#endif
+
   return otcrypto_eval_exit(hmac_hash_sha512(message, digest->data));
 }
 
@@ -147,6 +147,37 @@ otcrypto_status_t otcrypto_ecdsa_p256_verify(
     const otcrypto_const_word32_buf_t *signature,
     hardened_bool_t *verification_result);
 
+/**
+ * Verifies a batch of ECDSA/P-256 signatures.
+ *
+ * Equivalent to calling `otcrypto_ecdsa_p256_verify` once for each index, but
+ * keeps the OTBN application resident across the batch and checks the inputs
+ * of each signature while OTBN is still busy with the previous one. This is
+ * intended for callers such as certificate-chain validation that verify many
+ * signatures back to back.
+ *
+ * All arrays must have `num_signatures` entries. See
+ * `otcrypto_ecdsa_p256_verify` for requirements on the individual inputs. As
+ * for the single-shot API, the caller must check each entry of
+ * `verification_results`; the status code only indicates whether errors were
+ * encountered. If an error is returned, entries after the failing index are
+ * left as `kHardenedBoolFalse`.
+ *
+ * @param public_keys Array of unblinded public key (Q) structs.
+ * @param message_digests Array of message digests (pre-hashed).
+ * @param signatures Array of signatures to be verified.
+ * @param num_signatures Number of signatures in the batch (at least 1).
+ * @param[out] verification_results Whether each signature passed
+ * verification.
+ * @return Result of the batch ECDSA verification operation.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_ecdsa_p256_verify_batch(
+    const otcrypto_unblinded_key_t *public_keys,
+    const otcrypto_hash_digest_t *message_digests,
+    const otcrypto_const_word32_buf_t *signatures, size_t num_signatures,
+    hardened_bool_t *verification_results);
+
 /**
  * Generates a key pair for ECDH with curve P-256.
  *
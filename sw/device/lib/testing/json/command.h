@@ -42,7 +42,8 @@ extern "C" {
     value(_, SpiMailboxUnmap) \
     value(_, SpiMailboxWrite) \
     value(_, SpiPassthruSetAddressMap) \
-    value(_, SwStrapRead)
+    value(_, SwStrapRead) \
+    value(_, UjsonConfig)
 UJSON_SERDE_ENUM(TestCommand, test_command_t, ENUM_TEST_COMMAND);
 
 // clang-format on
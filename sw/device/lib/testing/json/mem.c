@@ -21,6 +21,39 @@ status_t ujcmd_mem_read32(ujson_t *uj) {
   return RESP_OK(ujson_serialize_mem_read32_resp_t, uj, &resp);
 }
 
+/**
+ * Serializes a MemRead response with only the first `data_len` bytes of
+ * `data`.
+ *
+ * The derived serializer always emits the whole `data` array, which would make
+ * every response as long as the largest one.  The host and device parsers both
+ * accept a shorter array.
+ */
+static status_t mem_read_resp_serialize(ujson_t *uj,
+                                        const mem_read_resp_t *self) {
+  TRY(ujson_putbuf(uj, "{", 1));
+  TRY(ujson_serialize_string(uj, "data"));
+  TRY(ujson_putbuf(uj, ":", 1));
+  if (uj->compact_bytes) {
+    TRY(ujson_serialize_hex(uj, self->data, self->data_len));
+  } else {
+    TRY(ujson_putbuf(uj, "[", 1));
+    for (size_t i = 0; i < self->data_len; ++i) {
+      if (i) {
+        TRY(ujson_putbuf(uj, ",", 1));
+      }
+      TRY(ujson_serialize_uint8_t(uj, &self->data[i]));
+    }
+    TRY(ujson_putbuf(uj, "]", 1));
+  }
+  TRY(ujson_putbuf(uj, ",", 1));
+  TRY(ujson_serialize_string(uj, "data_len"));
+  TRY(ujson_putbuf(uj, ":", 1));
+  TRY(ujson_serialize_uint16_t(uj, &self->data_len));
+  TRY(ujson_putbuf(uj, "}", 1));
+  return OK_STATUS();
+}
+
 status_t ujcmd_mem_read(ujson_t *uj) {
   mem_read_req_t op;
   mem_read_resp_t resp;
@@ -30,7 +63,7 @@ status_t ujcmd_mem_read(ujson_t *uj) {
   }
   memcpy(resp.data, (void *)op.address, op.data_len);
   resp.data_len = op.data_len;
-  return RESP_OK(ujson_serialize_mem_read_resp_t, uj, &resp);
+  return RESP_OK(mem_read_resp_serialize, uj, &resp);
 }
 
 status_t ujcmd_mem_write32(ujson_t *uj) {
@@ -13,6 +13,11 @@ extern "C" {
 
 #define MODULE_ID MAKE_MODULE_ID('j', 'm', 'h')
 
+// Maximum number of bytes moved by a single MemRead or MemWrite command.  Only
+// the first `data_len` bytes of `data` are sent either way, so the limit sets
+// the size of the buffers rather than of every message.
+#define MEM_CMD_MAX_DATA_BYTES 512
+
 #define STRUCT_MEM_READ32_REQ(field, string) \
     field(address, uint32_t)
 UJSON_SERDE_STRUCT(MemRead32Req, mem_read32_req_t, STRUCT_MEM_READ32_REQ);
@@ -27,7 +32,7 @@ UJSON_SERDE_STRUCT(MemRead32Resp, mem_read32_resp_t, STRUCT_MEM_READ32_RESP);
 UJSON_SERDE_STRUCT(MemReadReq, mem_read_req_t, STRUCT_MEM_READ_REQ);
 
 #define STRUCT_MEM_READ_RESP(field, string) \
-    field(data, uint8_t, 256) \
+    field(data, uint8_t, MEM_CMD_MAX_DATA_BYTES) \
     field(data_len, uint16_t)
 UJSON_SERDE_STRUCT(MemReadResp, mem_read_resp_t, STRUCT_MEM_READ_RESP);
 
@@ -38,7 +43,7 @@ UJSON_SERDE_STRUCT(MemWrite32Req, mem_write32_req_t, STRUCT_MEM_WRITE32_REQ);
 
 #define STRUCT_MEM_WRITE_REQ(field, string) \
     field(address, uint32_t) \
-    field(data, uint8_t, 256) \
+    field(data, uint8_t, MEM_CMD_MAX_DATA_BYTES) \
     field(data_len, uint16_t)
 UJSON_SERDE_STRUCT(MemWriteReq, mem_write_req_t, STRUCT_MEM_WRITE_REQ);
 
@@ -16,6 +16,12 @@ extern "C" {
     field(crc, uint32_t)
 UJSON_SERDE_STRUCT(OttfCrc, ottf_crc_t, STRUCT_OTTF_CRC);
 
+// Options for the ujson encoding used on the console.  `compact_bytes` selects
+// hex strings rather than integer arrays for byte buffers sent by the device.
+#define STRUCT_UJSON_CONFIG(field, string) \
+    field(compact_bytes, bool)
+UJSON_SERDE_STRUCT(UjsonConfig, ujson_config_t, STRUCT_UJSON_CONFIG);
+
 #undef MODULE_ID
 
 // clang-format on
@@ -4,6 +4,7 @@
 
 #include "sw/device/lib/testing/profile.h"
 
+#include "sw/device/lib/base/math.h"
 #include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 
@@ -22,3 +23,20 @@ uint32_t profile_end_and_print(uint64_t t_start, char *name) {
   LOG_INFO("%s took %u cycles or %u ms @ 100 MHz.", name, cycles, time_ms);
   return cycles;
 }
+
+void profile_stats_add(profile_stats_t *stats, uint32_t cycles) {
+  stats->total += cycles;
+  if (cycles > stats->max) {
+    stats->max = cycles;
+  }
+  ++stats->count;
+}
+
+void profile_stats_print(const profile_stats_t *stats, const char *name) {
+  uint32_t average = 0;
+  if (stats->count > 0) {
+    average = (uint32_t)udiv64_slow(stats->total, stats->count, NULL);
+  }
+  LOG_INFO("%s cycles over %u runs: average %u, max %u.", name,
+           (uint32_t)stats->count, average, stats->max);
+}
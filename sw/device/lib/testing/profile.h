@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_PROFILE_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_PROFILE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -50,6 +51,51 @@ uint32_t profile_end(uint64_t t_start);
  */
 uint32_t profile_end_and_print(uint64_t t_start, char *name);
 
+/**
+ * Summary of the cycle counts of repeated runs of the same operation.
+ *
+ * Basic usage:
+ *   static profile_stats_t stats;
+ *   for (...) {
+ *     uint64_t t_start = profile_start();
+ *     // Do some stuff
+ *     profile_stats_add(&stats, profile_end(t_start));
+ *   }
+ *   profile_stats_print(&stats, "Some stuff");
+ *
+ * Zero-initialize before the first run.
+ */
+typedef struct profile_stats {
+  /**
+   * Sum of the cycle counts of all runs.
+   */
+  uint64_t total;
+  /**
+   * Largest cycle count of a single run.
+   */
+  uint32_t max;
+  /**
+   * Number of runs.
+   */
+  size_t count;
+} profile_stats_t;
+
+/**
+ * Record the cycle count of one run.
+ *
+ * @param stats Summary to update.
+ * @param cycles Cycle count of the run, e.g. from `profile_end()`.
+ */
+void profile_stats_add(profile_stats_t *stats, uint32_t cycles);
+
+/**
+ * Print the average and maximum cycle counts of the recorded runs.
+ *
+ * @param stats Summary to print.
+ * @param name Name of the operation, for printing.
+ */
+void profile_stats_print(const profile_stats_t *stats, const char *name);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -5,8 +5,18 @@
 #include "sw/device/lib/testing/test_framework/ujson_ottf_commands.h"
 
 #include "sw/device/lib/testing/json/mem.h"
+#include "sw/device/lib/testing/json/ottf.h"
 #include "sw/device/lib/testing/test_framework/ujson_ottf.h"
 
+static status_t ujcmd_ujson_config(ujson_t *uj) {
+  ujson_config_t config;
+  TRY(UJSON_WITH_CRC(ujson_deserialize_ujson_config_t, uj, &config));
+  // Acknowledge in the current encoding before switching.
+  RESP_OK_STATUS(uj);
+  uj->compact_bytes = config.compact_bytes;
+  return OK_STATUS();
+}
+
 status_t ujson_ottf_dispatch(ujson_t *uj, test_command_t command) {
   if (uj == NULL) {
     return INVALID_ARGUMENT();
@@ -24,6 +34,9 @@ status_t ujson_ottf_dispatch(ujson_t *uj, test_command_t command) {
     case kTestCommandMemWrite:
       RESP_ERR(uj, ujcmd_mem_write(uj));
       break;
+    case kTestCommandUjsonConfig:
+      RESP_ERR(uj, ujcmd_ujson_config(uj));
+      break;
     default:
       return UNIMPLEMENTED();
   }
@@ -16,6 +16,9 @@ extern "C" {
 /**
  * Handles basic memory commands known to the OTTF ujson framework.
  *
+ * Also handles `UjsonConfig`, which lets the host switch the encoding used for
+ * byte buffers in subsequent responses.
+ *
  * For unrecognized command codes, no response is sent back to the requester.
  * This function returns a status with code `kUnimplemented`, and the caller
  * chooses whether to send an error response or to forward the command code to
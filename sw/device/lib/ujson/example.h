@@ -63,6 +63,21 @@ UJSON_SERDE_STRUCT(Rect, rect, STRUCT_RECT);
     field(k, int32_t, 3, 5)
 UJSON_SERDE_STRUCT(Matrix, matrix, STRUCT_MATRIX);
 
+// One-dimensional `uint8_t` arrays are byte buffers:
+// struct Blob {
+//     uint8_t data[8];
+//     uint32_t len;
+// } blob;
+// (and serialize/deserialize functions).
+//
+// A byte buffer may be received either as an array of integers or as a hex
+// string (e.g. "00a1ff...").  It is serialized as a hex string when the
+// `compact_bytes` flag of the ujson context is set.
+#define STRUCT_BLOB(field, string) \
+    field(data, uint8_t, 8) \
+    field(len, uint32_t)
+UJSON_SERDE_STRUCT(Blob, blob, STRUCT_BLOB);
+
 /////////////////////////////////////////////////////////////////////////////
 // Automatic generation of enums with serialize/deserialize functions:
 //
@@ -56,6 +56,14 @@ status_t roundtrip(const char *name) {
     ujson_crc32_reset(&uj);
     TRY(ujson_serialize_matrix(&uj, &x));
     printf("\n%x", ujson_crc32_finish(&uj));
+  } else if (!strcmp(name, "blob") || !strcmp(name, "blob_compact")) {
+    blob x = {0};
+    uj.compact_bytes = !strcmp(name, "blob_compact");
+    TRY(ujson_deserialize_blob(&uj, &x));
+    TRY(check_crc32(&uj));
+    ujson_crc32_reset(&uj);
+    TRY(ujson_serialize_blob(&uj, &x));
+    printf("\n%x", ujson_crc32_finish(&uj));
   } else if (!strcmp(name, "direction")) {
     direction x = {0};
     TRY(ujson_deserialize_direction(&uj, &x));
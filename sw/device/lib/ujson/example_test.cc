@@ -125,6 +125,58 @@ TEST(Derive, MatrixDeserialize) {
   EXPECT_EQ(memcmp(&m, &expected, sizeof(m)), 0);
 }
 
+TEST(Derive, BlobSerialize) {
+  blob blob = {{0x00, 0x01, 0x7f, 0x80, 0xaa, 0xbb, 0xfe, 0xff}, 8};
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_serialize_blob(&uj, &blob)));
+  EXPECT_EQ(ss.Sink(),
+            R"json({"data":[0,1,127,128,170,187,254,255],"len":8})json");
+}
+
+TEST(Derive, BlobSerializeCompact) {
+  blob blob = {{0x00, 0x01, 0x7f, 0x80, 0xaa, 0xbb, 0xfe, 0xff}, 8};
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  uj.compact_bytes = true;
+  EXPECT_TRUE(status_ok(ujson_serialize_blob(&uj, &blob)));
+  EXPECT_EQ(ss.Sink(), R"json({"data":"00017f80aabbfeff","len":8})json");
+}
+
+TEST(Derive, BlobDeserializeCompact) {
+  blob expected = {{0x00, 0x01, 0x7f, 0x80, 0xaa, 0xbb, 0xfe, 0xff}, 8};
+  blob blob{};
+  SourceSink ss(R"json({"data": "00017F80aabbfeff", "len":8})json");
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_deserialize_blob(&uj, &blob)));
+  EXPECT_EQ(memcmp(&blob, &expected, sizeof(blob)), 0);
+
+  // Both encodings are accepted regardless of `compact_bytes`.
+  blob = {};
+  ss.Reset(R"json({"data":[0,1,127,128,170,187,254,255],"len":8})json");
+  EXPECT_TRUE(status_ok(ujson_deserialize_blob(&uj, &blob)));
+  EXPECT_EQ(memcmp(&blob, &expected, sizeof(blob)), 0);
+}
+
+TEST(Derive, BlobDeserializeCompactShort) {
+  blob expected = {{0xde, 0xad}, 2};
+  blob blob{};
+  SourceSink ss(R"json({"data":"dead","len":2})json");
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_deserialize_blob(&uj, &blob)));
+  EXPECT_EQ(memcmp(&blob, &expected, sizeof(blob)), 0);
+}
+
+TEST(Derive, BlobDeserializeCompactInvalid) {
+  blob blob{};
+  SourceSink ss(R"json({"data":"dea","len":2})json");
+  ujson_t uj = ss.UJson();
+  EXPECT_EQ(status_err(ujson_deserialize_blob(&uj, &blob)), kOutOfRange);
+
+  ss.Reset(R"json({"data":"xy","len":2})json");
+  EXPECT_EQ(status_err(ujson_deserialize_blob(&uj, &blob)), kOutOfRange);
+}
+
 TEST(Derive, DirectionSerialize) {
   direction d = kDirectionEast;
   SourceSink ss;
@@ -104,6 +104,32 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_blob() -> Result<()> {
+        let before = example::Blob {
+            data: [0, 1, 127, 128, 170, 187, 254, 255].into(),
+            len: 8,
+        };
+        let after = roundtrip("blob", &serde_json::to_string(&before)?, true)?;
+        assert!(after.contains("[0,1,127,128,170,187,254,255]"));
+        let after = serde_json::from_str::<example::Blob>(&after)?;
+        assert_eq!(before, after);
+        Ok(())
+    }
+
+    #[test]
+    fn test_blob_compact() -> Result<()> {
+        let before = example::Blob {
+            data: [0, 1, 127, 128, 170, 187, 254, 255].into(),
+            len: 8,
+        };
+        let after = roundtrip("blob_compact", &serde_json::to_string(&before)?, true)?;
+        assert!(after.contains(r#""00017f80aabbfeff""#));
+        let after = serde_json::from_str::<example::Blob>(&after)?;
+        assert_eq!(before, after);
+        Ok(())
+    }
+
     #[test]
     fn test_direction() -> Result<()> {
         let before = example::Direction::North;
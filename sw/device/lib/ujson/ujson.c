@@ -168,6 +168,24 @@ status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len) {
   return OK_STATUS(n);
 }
 
+status_t ujson_parse_hex(ujson_t *uj, uint8_t *buf, size_t len) {
+  size_t n = 0;
+  TRY(ujson_consume(uj, '"'));
+  while (true) {
+    char ch = (char)TRY(ujson_getc(uj));
+    if (ch == '"') {
+      break;
+    }
+    TRY(ujson_ungetc(uj, ch));
+    int hi = TRY(consume_hexdigit(uj));
+    int lo = TRY(consume_hexdigit(uj));
+    if (n < len) {
+      buf[n++] = (uint8_t)((hi << 4) | lo);
+    }
+  }
+  return OK_STATUS((int32_t)n);
+}
+
 status_t ujson_parse_integer(ujson_t *uj, void *result, size_t rsz) {
   char ch = (char)TRY(consume_whitespace(uj));
   bool neg = false;
@@ -324,6 +342,24 @@ status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
   return OK_STATUS();
 }
 
+status_t ujson_serialize_hex(ujson_t *uj, const uint8_t *buf, size_t len) {
+  // Encode in chunks to amortize the cost of each `putbuf` call.
+  char chunk[32];
+  TRY(ujson_putbuf(uj, "\"", 1));
+  while (len > 0) {
+    size_t n = 0;
+    while (len > 0 && n < sizeof(chunk)) {
+      chunk[n++] = hex[*buf >> 4];
+      chunk[n++] = hex[*buf & 0xF];
+      ++buf;
+      --len;
+    }
+    TRY(ujson_putbuf(uj, chunk, n));
+  }
+  TRY(ujson_putbuf(uj, "\"", 1));
+  return OK_STATUS();
+}
+
 static status_t ujson_serialize_integer64(ujson_t *uj, uint64_t value,
                                           bool neg) {
   char buf[24];
@@ -4,6 +4,7 @@
 
 #ifndef OPENTITAN_SW_DEVICE_LIB_UJSON_UJSON_H_
 #define OPENTITAN_SW_DEVICE_LIB_UJSON_UJSON_H_
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/status.h"
@@ -29,6 +30,11 @@ typedef struct ujson {
   uint32_t crc32;
   /** Holds size counter for strings sent or received.*/
   size_t str_size;
+  /**
+   * Serialize one-dimensional `uint8_t` arrays as hex strings rather than as
+   * arrays of integers. Both forms are always accepted when deserializing.
+   */
+  bool compact_bytes;
 } ujson_t;
 
 // clang-format off
@@ -40,6 +46,7 @@ typedef struct ujson {
       .getc = (getc_),                                  \
       .buffer = -1,                                     \
       .crc32 = UINT32_MAX,                              \
+      .compact_bytes = false,                           \
   }
 // clang-format on
 
@@ -163,6 +170,20 @@ status_t ujson_consume_maybe(ujson_t *uj, char ch);
  */
 status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len);
 
+/**
+ * Parse a hex-encoded byte string.
+ *
+ * Consume whitespace until finding a double-quote, then decode pairs of hex
+ * digits until the next double-quote.  If the input exceeds the length of the
+ * user buffer, the excess bytes are consumed and discarded.
+ *
+ * @param uj A ujson IO context.
+ * @param buf A buffer to write the bytes into.
+ * @param len The length of the target buffer.
+ * @return The number of bytes written to `buf` or an error.
+ */
+status_t ujson_parse_hex(ujson_t *uj, uint8_t *buf, size_t len);
+
 /**
  * Parse a JSON integer.
  *
@@ -213,6 +234,16 @@ status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value);
  */
 status_t ujson_serialize_string(ujson_t *uj, const char *buf);
 
+/**
+ * Serialize a byte buffer as a hex-encoded string.
+ *
+ * @param uj A ujson IO context.
+ * @param buf The bytes to serialize.
+ * @param len The number of bytes to serialize.
+ * @return OK or an error.
+ */
+status_t ujson_serialize_hex(ujson_t *uj, const uint8_t *buf, size_t len);
+
 /**
  * Serialize an integer.
  *
@@ -74,6 +74,12 @@
 // Helper to count number of fields.
 #define ujson_count(name_, type_, ...) +1
 
+// Whether a struct field is a one-dimensional `uint8_t` array, which may be
+// encoded as a hex string instead of an array of integers.  The element of a
+// multi-dimensional array is itself an array and so never matches.
+#define ujson_is_byte_array(field_) \
+    _Generic((field_)[0], uint8_t: true, default: false)
+
 //////////////////////////////////////////////////////////////////////
 // Serialize Implementation
 //////////////////////////////////////////////////////////////////////
@@ -99,8 +105,12 @@
             TRY(ujson_serialize_##type_(uj, &self->name_)); \
         , /*else*/ \
             const type_ *p = (const type_*)self->name_; \
-            OT_EVAL(ujson_ser_loop( \
-                    TRY(ujson_serialize_##type_(uj, p++)), __VA_ARGS__)) \
+            if (ujson_is_byte_array(self->name_) && uj->compact_bytes) { \
+                TRY(ujson_serialize_hex(uj, (const uint8_t*)p, sizeof(self->name_))); \
+            } else { \
+                OT_EVAL(ujson_ser_loop( \
+                        TRY(ujson_serialize_##type_(uj, p++)), __VA_ARGS__)) \
+            } \
         ) /*endif*/ \
         if (--nfield) TRY(ujson_putbuf(uj, ",", 1)); \
     }
@@ -200,8 +210,14 @@
             TRY(ujson_deserialize_##type_(uj, &self->name_)); \
         , /*else*/ \
             type_ *p = (type_*)self->name_; \
-            OT_EVAL(ujson_de_loop(1, \
-                TRY(ujson_deserialize_##type_(uj, p++)), __VA_ARGS__)) \
+            if (ujson_is_byte_array(self->name_) && \
+                TRY(ujson_consume_maybe(uj, '"'))) { \
+                TRY(ujson_ungetc(uj, '"')); \
+                TRY(ujson_parse_hex(uj, (uint8_t*)p, sizeof(self->name_))); \
+            } else { \
+                OT_EVAL(ujson_de_loop(1, \
+                    TRY(ujson_deserialize_##type_(uj, p++)), __VA_ARGS__)) \
+            } \
         ) /*endif*/ \
     }
 
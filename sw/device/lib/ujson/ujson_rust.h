@@ -37,6 +37,8 @@
 // clang-format off
 rust_attr[allow(unused_imports)]
 use opentitanlib::test_utils::status::status_t;
+rust_attr[allow(unused_imports)]
+use opentitanlib::test_utils::ujson_bytes;
 
 // clang-format is turned off; as scary as these macros look, they look
 // even scarier after clang-format is done with them.
@@ -49,7 +51,26 @@ use opentitanlib::test_utils::status::status_t;
         arrayvec::ArrayVec<OT_OBSTRUCT(ujson_struct_field_array_indirect)()(t_, __VA_ARGS__), sz_> \
     ) /*endif*/
 
+// One-dimensional `uint8_t` arrays may be encoded as hex strings; detect them
+// by probing the (already translated) element type and the number of
+// dimensions.
+#define ujson_rust_byte_type_u8 OT_PROBE(~)
+#define ujson_rust_one_dim_1 OT_PROBE(~)
+#define ujson_rust_is_byte_type(type_) \
+    OT_CHECK(OT_PRIMITIVE_CAT(ujson_rust_byte_type_, type_))
+#define ujson_rust_is_one_dim(...) \
+    OT_CHECK(OT_CAT(ujson_rust_one_dim_, OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__)))
+
 #define ujson_struct_field(name_, type_, ...) \
+    OT_IIF(ujson_rust_is_byte_type(type_)) \
+    ( /*then*/ \
+        OT_IIF(ujson_rust_is_one_dim(__VA_ARGS__)) \
+        ( /*then*/ \
+            rust_attr[serde(with = "ujson_bytes")] \
+        , /*else*/ \
+        ) /*endif*/ \
+    , /*else*/ \
+    ) /*endif*/ \
     pub OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
     ( /*then*/ \
         name_: type_ \
@@ -4,6 +4,8 @@
 
 #include "sw/device/lib/ujson/ujson.h"
 
+#include <cstdio>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <string>
 
@@ -196,6 +198,68 @@ TEST(UJson, SerializeString) {
   EXPECT_EQ(ss.Sink(), R"json("\u00ff\u0001\u0099")json");
 }
 
+TEST(UJson, ParseHex) {
+  SourceSink ss(R"json(  "0123456789abcdefABCDEF" )json");
+  ujson_t uj = ss.UJson();
+  uint8_t buf[16];
+  status_t s;
+
+  s = ujson_parse_hex(&uj, buf, sizeof(buf));
+  EXPECT_TRUE(status_ok(s));
+  EXPECT_EQ(s.value, 11);
+  const uint8_t expected[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab,
+                              0xcd, 0xef, 0xab, 0xcd, 0xef};
+  EXPECT_EQ(memcmp(buf, expected, sizeof(expected)), 0);
+
+  // Bytes that do not fit are consumed and discarded.
+  ss.Reset();
+  memset(buf, 0, sizeof(buf));
+  s = ujson_parse_hex(&uj, buf, 2);
+  EXPECT_TRUE(status_ok(s));
+  EXPECT_EQ(s.value, 2);
+  EXPECT_EQ(buf[1], 0x23);
+  EXPECT_EQ(buf[2], 0);
+  EXPECT_EQ(status_err(ujson_getc(&uj)), kOk);
+}
+
+TEST(UJson, ParseHexError) {
+  SourceSink ss(R"json("abc")json");
+  ujson_t uj = ss.UJson();
+  uint8_t buf[16];
+
+  EXPECT_EQ(status_err(ujson_parse_hex(&uj, buf, sizeof(buf))), kOutOfRange);
+
+  ss.Reset(R"json([1,2])json");
+  EXPECT_EQ(status_err(ujson_parse_hex(&uj, buf, sizeof(buf))), kNotFound);
+}
+
+TEST(UJson, SerializeHex) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+
+  const uint8_t buf[] = {0x00, 0x01, 0x7f, 0x80, 0xff};
+  EXPECT_TRUE(status_ok(ujson_serialize_hex(&uj, buf, sizeof(buf))));
+  EXPECT_EQ(ss.Sink(), R"json("00017f80ff")json");
+
+  ss.Reset();
+  EXPECT_TRUE(status_ok(ujson_serialize_hex(&uj, buf, 0)));
+  EXPECT_EQ(ss.Sink(), R"json("")json");
+
+  // Longer than the internal chunk.
+  uint8_t big[40];
+  std::string expected = "\"";
+  for (size_t i = 0; i < sizeof(big); ++i) {
+    big[i] = static_cast<uint8_t>(i * 7);
+    char hex[3];
+    snprintf(hex, sizeof(hex), "%02x", big[i]);
+    expected += hex;
+  }
+  expected += "\"";
+  ss.Reset();
+  EXPECT_TRUE(status_ok(ujson_serialize_hex(&uj, big, sizeof(big))));
+  EXPECT_EQ(ss.Sink(), expected);
+}
+
 TEST(UJson, SerializeBool) {
   SourceSink ss;
   ujson uj = ss.UJson();
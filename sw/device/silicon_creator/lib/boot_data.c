@@ -8,11 +8,14 @@
 #include <stdint.h>
 
 #include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/silicon_creator/lib/base/sec_mmio.h"
 #include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
 #include "sw/device/silicon_creator/lib/drivers/hmac.h"
 #include "sw/device/silicon_creator/lib/drivers/otp.h"
+#include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
+#include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
 #include "sw/device/silicon_creator/lib/error.h"
 
 #include "hw/top/flash_ctrl_regs.h"
@@ -460,12 +463,162 @@ static rom_error_t boot_data_page_info_update(
   return error;
 }
 
+/**
+ * Computes the integrity tag of a boot data index.
+ *
+ * @param index A boot data index.
+ * @param[out] tag Digest of all fields of `index` except `tag`.
+ */
+static void boot_data_index_tag_compute(const boot_data_index_t *index,
+                                        hmac_digest_t *tag) {
+  enum {
+    kTagRegionOffset = sizeof(index->tag),
+    kTagRegionSize = sizeof(boot_data_index_t) - kTagRegionOffset,
+  };
+  static_assert(offsetof(boot_data_index_t, tag) == 0,
+                "`tag` must be the first field of `boot_data_index_t`.");
+  hmac_sha256((const char *)index + kTagRegionOffset, kTagRegionSize, tag);
+}
+
+/**
+ * Stores the location of the given boot data entry in the retention SRAM.
+ *
+ * @param page A boot data page.
+ * @param index Index of the entry in the given page.
+ * @param boot_data The entry at the given page and index.
+ */
+static void boot_data_index_set(const flash_ctrl_info_page_t *page,
+                                size_t index, const boot_data_t *boot_data) {
+  boot_data_index_t boot_data_index = {
+      .identifier = kBootDataIndexIdentifier,
+      .page = page == kPages[0] ? 0 : 1,
+      .entry = index,
+      .counter = boot_data->counter,
+      .digest = boot_data->digest,
+  };
+  boot_data_index_tag_compute(&boot_data_index, &boot_data_index.tag);
+  retention_sram_get()->creator.boot_data_index = boot_data_index;
+}
+
+/**
+ * Invalidates the boot data index in the retention SRAM.
+ */
+static void boot_data_index_clear(void) {
+  retention_sram_get()->creator.boot_data_index.identifier = 0;
+}
+
+/**
+ * Reads the boot data entry pointed to by the given index and checks that it
+ * is the last valid entry.
+ *
+ * The entry must match the counter and digest recorded in the index and pass
+ * `boot_data_check()`. Since `boot_data_write()` writes the new entry before
+ * invalidating the previous one, the next entry in the same page must be
+ * empty. Reads must be enabled for the indexed page before this function is
+ * called, see `boot_data_index_lookup()`.
+ *
+ * @param index Boot data index.
+ * @param[out] page_info Page info struct of the active info page.
+ * @param[out] boot_data Last valid boot data entry.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t boot_data_index_lookup_impl(const boot_data_index_t *index,
+                                               active_page_info_t *page_info,
+                                               boot_data_t *boot_data) {
+  const flash_ctrl_info_page_t *page = kPages[index->page];
+  HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, index->entry, boot_data));
+  if (boot_data->counter != index->counter) {
+    return kErrorBootDataNotFound;
+  }
+  hardened_bool_t digest_eq =
+      hardened_memeq(boot_data->digest.digest, index->digest.digest,
+                     ARRAYSIZE(index->digest.digest));
+  if (launder32(digest_eq) != kHardenedBoolTrue) {
+    return kErrorBootDataNotFound;
+  }
+  HARDENED_CHECK_EQ(digest_eq, kHardenedBoolTrue);
+  HARDENED_RETURN_IF_ERROR(boot_data_check(boot_data));
+
+  size_t next = index->entry + 1;
+  boot_data_t buf;
+  HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, next, &buf));
+  hardened_bool_t has_empty_entry = boot_data_is_empty(&buf);
+  if (launder32(has_empty_entry) != kHardenedBoolTrue) {
+    return kErrorBootDataNotFound;
+  }
+  HARDENED_CHECK_EQ(has_empty_entry, kHardenedBoolTrue);
+
+  *page_info = (active_page_info_t){
+      .page = page,
+      .has_empty_entry = has_empty_entry,
+      .first_empty_index = next,
+      .has_valid_entry = kHardenedBoolTrue,
+      .last_valid_index = index->entry,
+  };
+  return kErrorOk;
+}
+
+/**
+ * Finds the last valid boot data entry using the boot data index in the
+ * retention SRAM.
+ *
+ * The index is not used after a power-on reset since the retention SRAM is
+ * initialized with random data, nor if its integrity tag does not match. It is
+ * not used either if it points at the last entry of a page: the next entry
+ * would then be in the other page, which may hold newer entries anywhere, so
+ * both pages are scanned instead. This function wraps the actual
+ * implementation to enable and disable reads for the indexed page, see
+ * `boot_data_index_lookup_impl()`.
+ *
+ * @param[out] page_info Page info struct of the active info page.
+ * @param[out] boot_data Last valid boot data entry.
+ * @return `kErrorOk` if the indexed entry is the last valid entry,
+ * `kErrorBootDataNotFound` or an error from the flash controller otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t boot_data_index_lookup(active_page_info_t *page_info,
+                                          boot_data_t *boot_data) {
+  const retention_sram_creator_t *creator = &retention_sram_get()->creator;
+  boot_data_index_t index = creator->boot_data_index;
+  if ((creator->reset_reasons & (1 << kRstmgrReasonPowerOn)) != 0 ||
+      index.identifier != kBootDataIndexIdentifier ||
+      index.page >= kPageCount || index.entry >= kBootDataEntriesPerPage - 1) {
+    return kErrorBootDataNotFound;
+  }
+  hmac_digest_t tag;
+  boot_data_index_tag_compute(&index, &tag);
+  hardened_bool_t tag_eq =
+      hardened_memeq(tag.digest, index.tag.digest, ARRAYSIZE(tag.digest));
+  if (launder32(tag_eq) != kHardenedBoolTrue) {
+    return kErrorBootDataNotFound;
+  }
+  HARDENED_CHECK_EQ(tag_eq, kHardenedBoolTrue);
+
+  const flash_ctrl_info_page_t *page = kPages[index.page];
+  flash_ctrl_info_perms_set(page, (flash_ctrl_perms_t){
+                                      .read = kMultiBitBool4True,
+                                      .write = kMultiBitBool4False,
+                                      .erase = kMultiBitBool4False,
+                                  });
+  rom_error_t error = boot_data_index_lookup_impl(&index, page_info, boot_data);
+  flash_ctrl_info_perms_set(page, (flash_ctrl_perms_t){
+                                      .read = kMultiBitBool4False,
+                                      .write = kMultiBitBool4False,
+                                      .erase = kMultiBitBool4False,
+                                  });
+  SEC_MMIO_WRITE_INCREMENT(2 * kFlashCtrlSecMmioInfoPermsSet);
+  return error;
+}
+
 /**
  * Finds the active info page and returns its page info struct and last boot
  * data entry.
  *
  * The active info page is the one that has the newest valid boot data entry,
- * i.e. the entry with the greatest counter value.
+ * i.e. the entry with the greatest counter value. The boot data index in the
+ * retention SRAM is tried first; both pages are scanned, and the index is
+ * refreshed, only if the index cannot be used.
  *
  * @param[out] page_info Page info struct of the active info page.
  * @param[out] boot_data Last valid boot data entry.
@@ -474,6 +627,12 @@ static rom_error_t boot_data_page_info_update(
 OT_WARN_UNUSED_RESULT
 static rom_error_t boot_data_active_page_find(active_page_info_t *page_info,
                                               boot_data_t *boot_data) {
+  rom_error_t error = boot_data_index_lookup(page_info, boot_data);
+  if (launder32(error) == kErrorOk) {
+    HARDENED_CHECK_EQ(error, kErrorOk);
+    return error;
+  }
+  // Fall back to scanning both pages if the index is stale or unavailable.
   *page_info = (active_page_info_t){
       .page = NULL,
       .has_empty_entry = kHardenedBoolFalse,
@@ -489,6 +648,14 @@ static rom_error_t boot_data_active_page_find(active_page_info_t *page_info,
   HARDENED_RETURN_IF_ERROR(
       boot_data_page_info_update(kPages[1], page_info, boot_data));
 
+  if (launder32(page_info->has_valid_entry) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(page_info->has_valid_entry, kHardenedBoolTrue);
+    boot_data_index_set(page_info->page, page_info->last_valid_index,
+                        boot_data);
+  } else {
+    boot_data_index_clear();
+  }
+
   return kErrorOk;
 }
 
@@ -615,6 +782,8 @@ rom_error_t boot_data_write(const boot_data_t *boot_data) {
   active_page_info_t active_page;
   boot_data_t last_entry;
   RETURN_IF_ERROR(boot_data_active_page_find(&active_page, &last_entry));
+  const flash_ctrl_info_page_t *new_page = kPages[0];
+  size_t new_index = 0;
 
   if (active_page.has_valid_entry == kHardenedBoolTrue) {
     // Note: Not checking for wraparound since a successful write will
@@ -625,11 +794,12 @@ rom_error_t boot_data_write(const boot_data_t *boot_data) {
       RETURN_IF_ERROR(boot_data_entry_write(active_page.page,
                                             active_page.first_empty_index,
                                             &new_entry, kHardenedBoolFalse));
+      new_page = active_page.page;
+      new_index = active_page.first_empty_index;
     } else {
       // Erase the other page and write the new entry there if the active page
       // is full.
-      const flash_ctrl_info_page_t *new_page =
-          active_page.page == kPages[0] ? kPages[1] : kPages[0];
+      new_page = active_page.page == kPages[0] ? kPages[1] : kPages[0];
       RETURN_IF_ERROR(
           boot_data_entry_write(new_page, 0, &new_entry, kHardenedBoolTrue));
     }
@@ -645,6 +815,7 @@ rom_error_t boot_data_write(const boot_data_t *boot_data) {
     RETURN_IF_ERROR(
         boot_data_entry_write(kPages[0], 0, &new_entry, kHardenedBoolTrue));
   }
+  boot_data_index_set(new_page, new_index, &new_entry);
 
   return kErrorOk;
 }
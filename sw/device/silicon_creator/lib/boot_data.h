@@ -170,6 +170,57 @@ typedef enum boot_slot {
   kBootSlotUnspecified = 0x55555555,
 } boot_slot_t;
 
+/**
+ * Location of the last valid boot data entry, cached across resets.
+ *
+ * `boot_data_read()` and `boot_data_write()` keep a copy of this struct in the
+ * retention SRAM so that warm boots can read the last valid entry directly
+ * instead of scanning both boot data pages. The cached location is only used
+ * after its integrity tag and the entry it points at in flash have been
+ * checked.
+ */
+typedef struct boot_data_index {
+  /**
+   * Integrity tag: SHA-256 digest of the remaining fields of this struct.
+   */
+  hmac_digest_t tag;
+  /**
+   * Index identifier (ASCII "BDIX").
+   */
+  uint32_t identifier;
+  /**
+   * Index of the active boot data page (0 or 1).
+   */
+  uint32_t page;
+  /**
+   * Index of the last valid entry in the active page.
+   */
+  uint32_t entry;
+  /**
+   * Counter of the last valid entry.
+   */
+  uint32_t counter;
+  /**
+   * Digest of the last valid entry.
+   */
+  hmac_digest_t digest;
+} boot_data_index_t;
+
+OT_ASSERT_MEMBER_OFFSET(boot_data_index_t, tag, 0);
+OT_ASSERT_MEMBER_OFFSET(boot_data_index_t, identifier, 32);
+OT_ASSERT_MEMBER_OFFSET(boot_data_index_t, page, 36);
+OT_ASSERT_MEMBER_OFFSET(boot_data_index_t, entry, 40);
+OT_ASSERT_MEMBER_OFFSET(boot_data_index_t, counter, 44);
+OT_ASSERT_MEMBER_OFFSET(boot_data_index_t, digest, 48);
+OT_ASSERT_SIZE(boot_data_index_t, 80);
+
+enum {
+  /**
+   * Boot data index identifier value (ASCII "BDIX").
+   */
+  kBootDataIndexIdentifier = 0x58494442,
+};
+
 /**
  * Reads the boot data stored in the flash info partition.
  *
@@ -181,6 +232,11 @@ typedef enum boot_slot {
  * returns the default boot data in non-production life cycle states
  * (TEST_UNLOCKED, DEV, RMA).
  *
+ * Except after a power-on reset, the entry pointed to by the boot data index in
+ * the retention SRAM is read first. Both pages are scanned if the index is
+ * corrupted, points at the last entry of a page, or if that entry does not
+ * match the index or may not be the newest one.
+ *
  * @param lc_state Life cycle state of the device.
  * @param boot_data[out] Boot data.
  * @return The result of the operation.
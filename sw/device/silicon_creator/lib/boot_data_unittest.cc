@@ -11,6 +11,8 @@
 #include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
 #include "sw/device/silicon_creator/lib/drivers/mock_hmac.h"
 #include "sw/device/silicon_creator/lib/drivers/mock_otp.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_retention_sram.h"
+#include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
 #include "sw/device/silicon_creator/testing/rom_test.h"
 
 #include "hw/top/flash_ctrl_regs.h"
@@ -69,6 +71,15 @@ constexpr boot_data_t kValidEntryV1 = {
     .min_security_version_bl0 = 0,
 };
 
+/**
+ * Integrity tag returned by the mocked digest computation of the boot data
+ * index.
+ */
+constexpr hmac_digest_t kIndexTag = {
+    .digest = {0x8badf00d, 0x8badf00d, 0x8badf00d, 0x8badf00d, 0x8badf00d,
+               0x8badf00d, 0x8badf00d, 0x8badf00d},
+};
+
 /**
  * Default boot data entry loaded by `boot_data_default_get`.
  */
@@ -96,6 +107,8 @@ class BootDataTest : public rom_test::RomTest {
   rom_test::MockFlashCtrl flash_ctrl_;
   rom_test::MockHmac hmac_;
   rom_test::MockOtp otp_;
+  rom_test::NiceMockRetentionSram retention_sram_;
+  retention_sram_t ret_ram_ = {};
 
   // Data for an entry which is fully erased.
   std::array<uint32_t, kBootDataNumWords> erased_entry_ = {};
@@ -109,6 +122,22 @@ class BootDataTest : public rom_test::RomTest {
     std::fill_n(non_erased_entry_.begin(), kBootDataNumWords, 0x01234567);
     std::fill_n(part_erased_entry_.begin(), kBootDataNumWords, 0x01234567);
     std::fill_n(part_erased_entry_.begin(), 3, kFlashCtrlErasedWord);
+    ON_CALL(retention_sram_, Get()).WillByDefault(Return(&ret_ram_));
+  }
+
+  /**
+   * Converts a boot data entry into an array of words.
+   *
+   * @param boot_data Boot data entry.
+   * @return Words of the entry.
+   */
+  static std::array<uint32_t, kBootDataNumWords> EntryWords(
+      boot_data_t boot_data) {
+    static_assert(sizeof(uint32_t) * kBootDataNumWords == sizeof(boot_data_t),
+                  "`kBootDataNumWords` must match size of `boot_data_t`");
+    std::array<uint32_t, kBootDataNumWords> words = {};
+    std::memcpy(words.data(), &boot_data, sizeof(boot_data_t));
+    return words;
   }
 
   /**
@@ -256,8 +285,8 @@ class BootDataTest : public rom_test::RomTest {
                   "`kBootDataNumWords` must match size of `boot_data_t`");
 
     // Convert the given boot data into an array of words.
-    std::array<uint32_t, kBootDataNumWords> boot_data_raw = {};
-    std::memcpy(boot_data_raw.data(), &boot_data, sizeof(boot_data_t));
+    std::array<uint32_t, kBootDataNumWords> boot_data_raw =
+        EntryWords(boot_data);
 
     // Mock the page to have the following layout:
     // #0. Non-erased but non-bootable.
@@ -297,6 +326,104 @@ class BootDataTest : public rom_test::RomTest {
     };
   }
 
+  /**
+   * Sets an expectation that the boot data index is used to look up the last
+   * valid entry.
+   *
+   * @param page  The page pointed to by the index.
+   * @param reads Function containing expectations of the reads happening while
+   *              reads are enabled for `page`.
+   */
+  void ExpectIndexLookup(const flash_ctrl_info_page_t *page,
+                         std::function<void()> reads) {
+    ExpectPermsSet(page, true, false, false);
+    reads();
+    ExpectPermsSet(page, false, false, false);
+  }
+
+  /**
+   * Returns a boot data index pointing at the given entry.
+   *
+   * @param page      Index of the boot data page.
+   * @param entry     Index of the entry in the page.
+   * @param boot_data Entry whose counter and digest are recorded.
+   * @return Boot data index with `kIndexTag` as its tag.
+   */
+  static boot_data_index_t MakeIndex(uint32_t page, uint32_t entry,
+                                     boot_data_t boot_data) {
+    return {
+        .tag = kIndexTag,
+        .identifier = kBootDataIndexIdentifier,
+        .page = page,
+        .entry = entry,
+        .counter = boot_data.counter,
+        .digest = boot_data.digest,
+    };
+  }
+
+  /**
+   * Sets an expectation that the integrity tag of a boot data index pointing
+   * at the given entry is computed.
+   *
+   * @param page      Index of the boot data page.
+   * @param entry     Index of the entry in the page.
+   * @param boot_data Entry whose counter and digest are recorded.
+   * @param valid     Whether the mocked tag should match `kIndexTag`.
+   */
+  void ExpectIndexTagCompute(uint32_t page, uint32_t entry,
+                             boot_data_t boot_data, bool valid = true) {
+    constexpr size_t kTagRegionOffset = sizeof(boot_data_index_t::tag);
+    constexpr size_t kTagRegionSize =
+        sizeof(boot_data_index_t) - kTagRegionOffset;
+
+    boot_data_index_t index = MakeIndex(page, entry, boot_data);
+    hmac_digest_t tag = kIndexTag;
+    if (!valid) {
+      tag.digest[0] += 1;
+    }
+
+    EXPECT_CALL(hmac_, sha256(_, kTagRegionSize, _))
+        .WillOnce([index, tag](const void *tag_region, size_t,
+                               hmac_digest_t *tag_) {
+          EXPECT_EQ(std::memcmp(tag_region,
+                                reinterpret_cast<const char *>(&index) +
+                                    kTagRegionOffset,
+                                kTagRegionSize),
+                    0);
+          *tag_ = tag;
+        });
+  }
+
+  /**
+   * Points the boot data index in the retention SRAM at the given entry.
+   *
+   * @param page      Index of the boot data page.
+   * @param entry     Index of the entry in the page.
+   * @param boot_data Entry whose counter and digest are recorded.
+   */
+  void SetIndex(uint32_t page, uint32_t entry, boot_data_t boot_data) {
+    ret_ram_.creator.boot_data_index = MakeIndex(page, entry, boot_data);
+  }
+
+  /**
+   * Checks that the boot data index points at the given entry.
+   *
+   * @param page      Expected index of the boot data page.
+   * @param entry     Expected index of the entry in the page.
+   * @param boot_data Entry whose counter and digest are expected.
+   */
+  void CheckIndex(uint32_t page, uint32_t entry, boot_data_t boot_data) {
+    const boot_data_index_t &index = ret_ram_.creator.boot_data_index;
+    EXPECT_THAT(index.tag.digest, testing::ElementsAreArray(kIndexTag.digest));
+    EXPECT_EQ(index.identifier, kBootDataIndexIdentifier);
+    EXPECT_EQ(index.page, page);
+    EXPECT_EQ(index.entry, entry);
+    EXPECT_EQ(index.counter, boot_data.counter);
+    EXPECT_EQ(std::memcmp(&index.digest, &boot_data.digest,
+                          sizeof(index.digest)),
+              0);
+  }
+
   /**
    * Sets an expectation that the device queries for whether the default boot
    * data entry should be loaded when in the `prod` lifecycle state.
@@ -334,17 +461,20 @@ TEST_F(BootDataReadTest, ReadBothValidTest1) {
   // Expect both pages to be checked, with both giving valid entries.
   ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
   ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1));
+  ExpectIndexTagCompute(1, 1, kValidEntry1);
 
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
   // Expect the entry with the higher `.counter` to have been selected.
   EXPECT_EQ(boot_data, kValidEntry1);
+  CheckIndex(1, 1, kValidEntry1);
 }
 
 TEST_F(BootDataReadTest, ReadBothValidTest2) {
   // Same as above, but swap which page contains `test_entry_1`.
   ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry1));
   ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry0));
+  ExpectIndexTagCompute(0, 1, kValidEntry1);
 
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
@@ -356,6 +486,7 @@ TEST_F(BootDataReadTest, ReadOneEntryTest) {
   // Expect both pages to be searched, but give only a valid entry for one.
   ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
   ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+  ExpectIndexTagCompute(0, 1, kValidEntry0);
 
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
@@ -366,6 +497,7 @@ TEST_F(BootDataReadTest, ReadOneValidTest) {
   // Expect both pages to be searched, but give only a valid entry for one.
   ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
   ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1, false));
+  ExpectIndexTagCompute(0, 1, kValidEntry0);
 
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
@@ -433,6 +565,7 @@ TEST_F(BootDataReadTest, ReadV1AsV2Test) {
   // Expect both to be searched, but only provide an entry in one.
   ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntryV1));
   ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+  ExpectIndexTagCompute(0, 1, kValidEntryV1);
 
   // Expect a new digest computation on version 2 of the boot data.
   ExpectDigestCompute(kValidEntry0, true);
@@ -445,5 +578,103 @@ TEST_F(BootDataReadTest, ReadV1AsV2Test) {
   EXPECT_EQ(boot_data, kValidEntry0);
 }
 
+TEST_F(BootDataReadTest, ReadIndexTest) {
+  SetIndex(0, 3, kValidEntry1);
+  ExpectIndexTagCompute(0, 3, kValidEntry1);
+  // Expect only the indexed entry and the one after it to be read.
+  ExpectIndexLookup(&kFlashCtrlInfoPageBootData0, [&] {
+    ExpectRead(&kFlashCtrlInfoPageBootData0, 3, EntryWords(kValidEntry1),
+               kErrorOk);
+    ExpectDigestCompute(kValidEntry1, true);
+    ExpectRead(&kFlashCtrlInfoPageBootData0, 4, erased_entry_, kErrorOk);
+  });
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+}
+
+TEST_F(BootDataReadTest, ReadIndexLastEntryTest) {
+  SetIndex(0, kBootDataEntriesPerPage - 1, kValidEntry0);
+  // Newer entries may be anywhere in the other page, so expect the index to be
+  // ignored and both pages to be scanned.
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1));
+  ExpectIndexTagCompute(1, 1, kValidEntry1);
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+  CheckIndex(1, 1, kValidEntry1);
+}
+
+TEST_F(BootDataReadTest, ReadIndexBadTagTest) {
+  SetIndex(0, 1, kValidEntry0);
+  // The tag does not match, so the index is ignored without reading flash.
+  ExpectIndexTagCompute(0, 1, kValidEntry0, false);
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1));
+  ExpectIndexTagCompute(1, 1, kValidEntry1);
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+  CheckIndex(1, 1, kValidEntry1);
+}
+
+TEST_F(BootDataReadTest, ReadIndexNewerEntryTest) {
+  SetIndex(0, 1, kValidEntry0);
+  ExpectIndexTagCompute(0, 1, kValidEntry0);
+  // The entry after the indexed one is not empty, so it may be newer.
+  ExpectIndexLookup(&kFlashCtrlInfoPageBootData0, [&] {
+    ExpectRead(&kFlashCtrlInfoPageBootData0, 1, EntryWords(kValidEntry0),
+               kErrorOk);
+    ExpectDigestCompute(kValidEntry0, true);
+    ExpectRead(&kFlashCtrlInfoPageBootData0, 2, EntryWords(kValidEntry1),
+               kErrorOk);
+  });
+  // Expect to fall back to scanning both pages.
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1));
+  ExpectIndexTagCompute(1, 1, kValidEntry1);
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+  CheckIndex(1, 1, kValidEntry1);
+}
+
+TEST_F(BootDataReadTest, ReadIndexMismatchTest) {
+  SetIndex(0, 1, kValidEntry1);
+  ExpectIndexTagCompute(0, 1, kValidEntry1);
+  // The indexed entry does not match the index, so its digest is not checked.
+  ExpectIndexLookup(&kFlashCtrlInfoPageBootData0, [&] {
+    ExpectRead(&kFlashCtrlInfoPageBootData0, 1, EntryWords(kValidEntry0),
+               kErrorOk);
+  });
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+  ExpectIndexTagCompute(0, 1, kValidEntry0);
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry0);
+  CheckIndex(0, 1, kValidEntry0);
+}
+
+TEST_F(BootDataReadTest, ReadIndexPowerOnTest) {
+  SetIndex(0, 1, kValidEntry0);
+  ret_ram_.creator.reset_reasons = 1 << kRstmgrReasonPowerOn;
+  // Expect the index to be ignored after a power-on reset.
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, ErasedPage());
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1));
+  ExpectIndexTagCompute(1, 1, kValidEntry1);
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+  CheckIndex(1, 1, kValidEntry1);
+}
+
 }  // namespace
 }  // namespace boot_data_unittest
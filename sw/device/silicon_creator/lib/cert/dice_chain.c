@@ -5,6 +5,7 @@
 #include "sw/device/silicon_creator/lib/cert/dice_chain.h"
 
 #include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
@@ -28,6 +29,41 @@ enum {
   kFlashPageSize = FLASH_CTRL_PARAM_BYTES_PER_PAGE,
 };
 
+/**
+ * Record of the inputs the CDI_1 key and certificate were generated from.
+ *
+ * This record is stored as a `kPersoObjectTypeDiceCertInputs` object right
+ * after the CDI_1 certificate. If the digest of the current inputs matches
+ * `digest`, the ROM_EXT uses the cached public key instead of re-deriving it.
+ *
+ * The record is not authenticated: the page digest only detects corruption.
+ * Trusting the cached key relies on the ROM_EXT revoking write and erase access
+ * to the page with `flash_ctrl_cert_info_page_owner_restrict()` before handing
+ * over to the owner firmware, so that only the ROM_EXT can write the record.
+ */
+typedef struct dice_chain_cert_inputs {
+  /**
+   * Digest of the key manager and certificate inputs.
+   */
+  hmac_digest_t digest;
+  /**
+   * Subject public key id of the certificate.
+   */
+  hmac_digest_t pubkey_id;
+  /**
+   * Subject public key of the certificate.
+   */
+  ecdsa_p256_public_key_t pubkey;
+} dice_chain_cert_inputs_t;
+
+enum {
+  /**
+   * Size of the perso TLV object that holds a `dice_chain_cert_inputs_t`.
+   */
+  kDiceChainCertInputsObjSize =
+      sizeof(perso_tlv_object_header_t) + sizeof(dice_chain_cert_inputs_t),
+};
+
 /**
  * Defines a class for parsing and building the DICE cert chain.
  *
@@ -270,6 +306,89 @@ static rom_error_t dice_chain_push_cert(const char *name, const uint8_t *cert,
   return kErrorOk;
 }
 
+/**
+ * Look up the inputs record that follows the cert object at the tail.
+ *
+ * If the record matches `digest`, the cached subject public key is loaded into
+ * `subject_pubkey_id` and `subject_pubkey`. The tail offset is not moved.
+ *
+ * @param digest Digest of the current certificate inputs.
+ * @return Whether a matching record was found.
+ */
+OT_WARN_UNUSED_RESULT
+static hardened_bool_t dice_chain_cert_inputs_match(
+    const hmac_digest_t *digest) {
+  perso_tlv_cert_obj_t cert_obj;
+  if (perso_tlv_get_cert_obj(dice_chain_get_tail_buffer(),
+                             dice_chain_get_tail_size(), kPersoBlobVersionV0,
+                             &cert_obj) != kErrorOk) {
+    return kHardenedBoolFalse;
+  }
+
+  // Objects are aligned to flash words, see `dice_chain_next_cert_obj()`.
+  size_t offset = util_size_to_words(cert_obj.obj_size) * sizeof(uint32_t);
+  offset = dice_chain.tail_offset + util_round_up_to(offset, 3);
+  if (offset + kDiceChainCertInputsObjSize > sizeof(dice_chain.page.data)) {
+    return kHardenedBoolFalse;
+  }
+  const uint8_t *obj = &dice_chain.page.data[offset];
+  if (perso_tlv_object_type(obj, kPersoBlobVersionV0) !=
+          kPersoObjectTypeDiceCertInputs ||
+      perso_tlv_object_size(obj, kPersoBlobVersionV0) !=
+          kDiceChainCertInputsObjSize) {
+    return kHardenedBoolFalse;
+  }
+
+  dice_chain_cert_inputs_t inputs;
+  memcpy(&inputs, obj + sizeof(perso_tlv_object_header_t), sizeof(inputs));
+  if (hardened_memeq(inputs.digest.digest, digest->digest,
+                     ARRAYSIZE(digest->digest)) != kHardenedBoolTrue) {
+    return kHardenedBoolFalse;
+  }
+  dice_chain.subject_pubkey_id = inputs.pubkey_id;
+  dice_chain.subject_pubkey = inputs.pubkey;
+  return kHardenedBoolTrue;
+}
+
+// Skip the inputs record at the tail, if any.
+static void dice_chain_skip_cert_inputs(void) {
+  if (dice_chain_get_tail_size() >= kDiceChainCertInputsObjSize &&
+      perso_tlv_object_type(dice_chain_get_tail_buffer(),
+                            kPersoBlobVersionV0) ==
+          kPersoObjectTypeDiceCertInputs) {
+    dice_chain.tail_offset +=
+        util_round_up_to(kDiceChainCertInputsObjSize, 3);
+    HARDENED_CHECK_LE(dice_chain.tail_offset, sizeof(dice_chain.page.data));
+  }
+}
+
+// Push the inputs record of the current subject key to the tail. The record is
+// only an optimization, so it is silently dropped if the page is full.
+static void dice_chain_push_cert_inputs(const hmac_digest_t *digest) {
+  if (dice_chain_get_tail_size() <
+      util_round_up_to(kDiceChainCertInputsObjSize, 3)) {
+    return;
+  }
+
+  // The data is going to be updated, mark it as dirty and clear the tail.
+  dice_chain.data_dirty = kHardenedBoolTrue;
+  memset(dice_chain_get_tail_buffer(), 0, dice_chain_get_tail_size());
+
+  perso_tlv_object_header_t obj_header = 0;
+  PERSO_TLV_SET_FIELD(Objh, Type, obj_header, kPersoObjectTypeDiceCertInputs);
+  PERSO_TLV_SET_FIELD(Objh, Size, obj_header, kDiceChainCertInputsObjSize);
+  dice_chain_cert_inputs_t inputs = {
+      .digest = *digest,
+      .pubkey_id = dice_chain.subject_pubkey_id,
+      .pubkey = dice_chain.subject_pubkey,
+  };
+  uint8_t *obj = dice_chain_get_tail_buffer();
+  memcpy(obj, &obj_header, sizeof(obj_header));
+  memcpy(obj + sizeof(obj_header), &inputs, sizeof(inputs));
+
+  dice_chain.tail_offset += util_round_up_to(kDiceChainCertInputsObjSize, 3);
+}
+
 rom_error_t dice_chain_attestation_silicon(void) {
   // Initialize the entropy complex and KMAC for key manager operations.
   // Note: `OTCRYPTO_OK.value` is equal to `kErrorOk` but we cannot add a static
@@ -466,11 +585,44 @@ rom_error_t dice_chain_attestation_owner(
       /*sealing_binding=*/sealing_binding,
       /*attest_binding=*/(keymgr_binding_value_t *)&attest_measurement,
       owner_manifest->max_key_version));
-  HARDENED_RETURN_IF_ERROR(otbn_boot_cert_ecc_p256_keygen(
-      kDiceKeyCdi1, &dice_chain.subject_pubkey_id, &dice_chain.subject_pubkey));
 
-  // Check if the current CDI_1 cert is valid.
-  RETURN_IF_ERROR(dice_chain_load_cert_obj("CDI_1", /*name_size=*/6));
+  // Digest everything the CDI_1 key and certificate are derived from. The
+  // CDI_0 key id stands for the OwnerIntermediateKey, the bl0 and owner
+  // measurements are covered by the attestation measurement.
+  hmac_digest_t inputs_digest;
+  hmac_sha256_configure(false);
+  hmac_sha256_start();
+  hmac_sha256_update(&static_dice_cdi_0.cdi_0_pubkey_id,
+                     sizeof(static_dice_cdi_0.cdi_0_pubkey_id));
+  hmac_sha256_update(sealing_binding, sizeof(*sealing_binding));
+  hmac_sha256_update(&attest_measurement, sizeof(attest_measurement));
+  hmac_sha256_update(&owner_manifest->max_key_version,
+                     sizeof(owner_manifest->max_key_version));
+  hmac_sha256_update(owner_history_hash, sizeof(*owner_history_hash));
+  hmac_sha256_update(&owner_manifest->security_version,
+                     sizeof(owner_manifest->security_version));
+  hmac_sha256_update(&key_domain, sizeof(key_domain));
+  hmac_sha256_process();
+  hmac_sha256_final(&inputs_digest);
+
+  // Skip the key generation if nothing changed since the CDI_1 cert was
+  // stored. The cached key is still checked against the cert below.
+  hardened_bool_t inputs_match = dice_chain_cert_inputs_match(&inputs_digest);
+  if (inputs_match == kHardenedBoolTrue) {
+    HARDENED_RETURN_IF_ERROR(
+        sc_keymgr_state_check(kDiceKeyCdi1.required_keymgr_state));
+    RETURN_IF_ERROR(dice_chain_load_cert_obj("CDI_1", /*name_size=*/6));
+  }
+  if (inputs_match != kHardenedBoolTrue ||
+      dice_chain.cert_valid != kHardenedBoolTrue) {
+    inputs_match = kHardenedBoolFalse;
+    HARDENED_RETURN_IF_ERROR(otbn_boot_cert_ecc_p256_keygen(
+        kDiceKeyCdi1, &dice_chain.subject_pubkey_id,
+        &dice_chain.subject_pubkey));
+    // Check if the current CDI_1 cert is valid.
+    RETURN_IF_ERROR(dice_chain_load_cert_obj("CDI_1", /*name_size=*/6));
+  }
+
   if (dice_chain.cert_valid == kHardenedBoolFalse) {
     dbg_puts("warning: CDI_1 certificate not valid; updating\r\n");
     // Update the cert page buffer.
@@ -492,6 +644,13 @@ rom_error_t dice_chain_attestation_owner(
         kDiceKeyCdi1.keygen_seed_idx, kDiceKeyCdi1.type,
         *kDiceKeyCdi1.keymgr_diversifier));
   }
+
+  // Record the inputs of the CDI_1 key for the next boot.
+  if (inputs_match == kHardenedBoolTrue) {
+    dice_chain_skip_cert_inputs();
+  } else {
+    dice_chain_push_cert_inputs(&inputs_digest);
+  }
   dice_chain.endorsement_pubkey_id = dice_chain.subject_pubkey_id;
 
   sc_keymgr_sw_binding_unlock_wait();
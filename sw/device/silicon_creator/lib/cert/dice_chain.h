@@ -64,6 +64,10 @@ rom_error_t dice_chain_attestation_creator(
 /**
  * Check the CDI_1 certificate and regenerate if invalid.
  *
+ * A digest of the CDI_1 key and certificate inputs is stored after the CDI_1
+ * certificate. If it matches on the next boot, the CDI_1 public key is taken
+ * from that record instead of being generated again with OTBN.
+ *
  * @param owner_manifest Pointer to the owner SW manifest to be boot.
  * @param bl0_measurement Pointer to the measurement of the owner firmware.
  * @param owner_measurement Pointer to the measurement of the owner config.
@@ -175,26 +175,56 @@ static rom_error_t wait_for_done(rom_error_t error) {
   abs_mmio_write32(flash_ctrl_core_base() + FLASH_CTRL_OP_STATUS_REG_OFFSET,
                    0u);
 
-  if (bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_ERR_BIT)) {
+  if (launder32(bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_ERR_BIT))) {
     return error;
   }
+  HARDENED_CHECK_EQ(
+      bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_ERR_BIT), 0);
   return kErrorOk;
 }
 
 /**
- * Writes data to the given partition.
+ * Returns the error code for the flash transaction described by the given
+ * value of the `CONTROL` register.
+ *
+ * @param control Value of the `CONTROL` register.
+ * @return Error code to report if the transaction fails.
+ */
+static rom_error_t op_error(uint32_t control) {
+  const bool is_info =
+      bitfield_bit32_read(control, FLASH_CTRL_CONTROL_PARTITION_SEL_BIT);
+  switch (bitfield_field32_read(control, FLASH_CTRL_CONTROL_OP_FIELD)) {
+    case FLASH_CTRL_CONTROL_OP_VALUE_READ:
+      return is_info ? kErrorFlashCtrlInfoRead : kErrorFlashCtrlDataRead;
+    case FLASH_CTRL_CONTROL_OP_VALUE_PROG:
+      return is_info ? kErrorFlashCtrlInfoWrite : kErrorFlashCtrlDataWrite;
+    case FLASH_CTRL_CONTROL_OP_VALUE_ERASE:
+      return is_info ? kErrorFlashCtrlInfoErase : kErrorFlashCtrlDataErase;
+    default:
+      HARDENED_TRAP();
+      return kErrorFlashCtrlDataErase;
+  }
+}
+
+/**
+ * Starts writing data to the given partition.
+ *
+ * Program operations can't cross program window boundaries, so the data is
+ * written with one transaction per window. All windows but the last are
+ * completed before this function returns; the last one is left in flight and
+ * must be completed with `wait_for_done()`.
  *
  * @param addr Full byte address to write to.
  * @param partition The partition to write to.
- * @param word_count Number of bus words to write.
+ * @param word_count Number of bus words to write. Must be non-zero.
  * @param data Data to write.
  * @param error Error code to return in case of a flash controller error.
  * @return Result of the operation.
  */
 OT_WARN_UNUSED_RESULT
-static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
-                         uint32_t word_count, const void *data,
-                         rom_error_t error) {
+static rom_error_t write_start(uint32_t addr, flash_ctrl_partition_t partition,
+                               uint32_t word_count, const void *data,
+                               rom_error_t error) {
   enum {
     kWindowWordCount = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t)
   };
@@ -202,7 +232,7 @@ static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
   // Find the number of words that can be written in the first window.
   uint32_t window_word_count =
       kWindowWordCount - ((addr / sizeof(uint32_t)) % kWindowWordCount);
-  while (word_count > 0) {
+  while (true) {
     // Program operations can't cross window boundaries.
     window_word_count =
         word_count < window_word_count ? word_count : window_word_count;
@@ -217,17 +247,41 @@ static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
     });
 
     fifo_write(window_word_count, data);
+    word_count -= window_word_count;
+    if (word_count == 0) {
+      break;
+    }
     RETURN_IF_ERROR(wait_for_done(error));
 
     addr += window_word_count * sizeof(uint32_t);
     data = (const char *)data + window_word_count * sizeof(uint32_t);
-    word_count -= window_word_count;
     window_word_count = kWindowWordCount;
   }
 
   return kErrorOk;
 }
 
+/**
+ * Writes data to the given partition.
+ *
+ * @param addr Full byte address to write to.
+ * @param partition The partition to write to.
+ * @param word_count Number of bus words to write.
+ * @param data Data to write.
+ * @param error Error code to return in case of a flash controller error.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
+                         uint32_t word_count, const void *data,
+                         rom_error_t error) {
+  if (word_count == 0) {
+    return kErrorOk;
+  }
+  RETURN_IF_ERROR(write_start(addr, partition, word_count, data, error));
+  return wait_for_done(error);
+}
+
 /**
  * Disables all access to a page until next reset.
  *
@@ -395,8 +449,17 @@ rom_error_t flash_ctrl_info_write(const flash_ctrl_info_page_t *info_page,
                kErrorFlashCtrlInfoWrite);
 }
 
-rom_error_t flash_ctrl_data_erase(uint32_t addr,
-                                  flash_ctrl_erase_type_t erase_type) {
+rom_error_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                        const void *data) {
+  if (word_count == 0) {
+    return kErrorFlashCtrlDataWrite;
+  }
+  return write_start(addr, kFlashCtrlPartitionData, word_count, data,
+                     kErrorFlashCtrlDataWrite);
+}
+
+rom_error_t flash_ctrl_data_erase_start(uint32_t addr,
+                                        flash_ctrl_erase_type_t erase_type) {
   transaction_start((transaction_params_t){
       .addr = addr,
       .op_type = FLASH_CTRL_CONTROL_OP_VALUE_ERASE,
@@ -405,9 +468,30 @@ rom_error_t flash_ctrl_data_erase(uint32_t addr,
       // Does not apply to erase transactions.
       .word_count = 1,
   });
+  return kErrorOk;
+}
+
+rom_error_t flash_ctrl_data_erase(uint32_t addr,
+                                  flash_ctrl_erase_type_t erase_type) {
+  RETURN_IF_ERROR(flash_ctrl_data_erase_start(addr, erase_type));
   return wait_for_done(kErrorFlashCtrlDataErase);
 }
 
+hardened_bool_t flash_ctrl_op_poll(void) {
+  uint32_t op_status =
+      abs_mmio_read32(flash_ctrl_core_base() + FLASH_CTRL_OP_STATUS_REG_OFFSET);
+  if (bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_DONE_BIT)) {
+    return kHardenedBoolTrue;
+  }
+  return kHardenedBoolFalse;
+}
+
+rom_error_t flash_ctrl_op_finish(void) {
+  uint32_t control =
+      abs_mmio_read32(flash_ctrl_core_base() + FLASH_CTRL_CONTROL_REG_OFFSET);
+  return wait_for_done(op_error(control));
+}
+
 rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
                                          flash_ctrl_erase_type_t erase_type) {
   static_assert(__builtin_popcount(FLASH_CTRL_PARAM_BYTES_PER_BANK) == 1,
@@ -434,23 +518,43 @@ rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
       break;
   }
 
+  enum {
+    /**
+     * Number of bytes checked per loop iteration.
+     */
+    kStrideBytes = 4 * sizeof(uint32_t),
+  };
+  static_assert(FLASH_CTRL_PARAM_BYTES_PER_PAGE % kStrideBytes == 0,
+                "Page size must be a multiple of the stride.");
+
   // Truncate to the closest lower bank/page aligned address.
   addr &= ~byte_count + 1;
   uint32_t mask = kFlashCtrlErasedWord;
   size_t i = 0, r = byte_count - 1;
-  uint32_t mem_base =
-      dt_flash_ctrl_memory_base(kFlashCtrlDt, kDtFlashCtrlMemoryMem);
+  uint32_t base =
+      dt_flash_ctrl_memory_base(kFlashCtrlDt, kDtFlashCtrlMemoryMem) + addr;
   for (; launder32(i) < byte_count && launder32(r) < byte_count;
-       i += sizeof(uint32_t), r -= sizeof(uint32_t)) {
-    uint32_t word = abs_mmio_read32(mem_base + addr + i);
+       i += kStrideBytes, r -= kStrideBytes) {
+    // Issue independent loads so that they can be pipelined, then fold them.
+    uint32_t word0 = abs_mmio_read32(base + i);
+    uint32_t word1 = abs_mmio_read32(base + i + sizeof(uint32_t));
+    uint32_t word2 = abs_mmio_read32(base + i + 2 * sizeof(uint32_t));
+    uint32_t word3 = abs_mmio_read32(base + i + 3 * sizeof(uint32_t));
+    uint32_t word = (word0 & word1) & (word2 & word3);
     mask &= word;
     error &= word;
+    // Stop at the first word that is not erased. This can only lead to a
+    // failure: `mask` can't become all ones again, and the success path below
+    // checks that the whole range was read.
+    if (launder32(word) != kFlashCtrlErasedWord) {
+      break;
+    }
   }
-  HARDENED_CHECK_EQ(i, byte_count);
-  HARDENED_CHECK_EQ(r, SIZE_MAX);
 
   if (launder32(mask) == kFlashCtrlErasedWord) {
     HARDENED_CHECK_EQ(mask, kFlashCtrlErasedWord);
+    HARDENED_CHECK_EQ(i, byte_count);
+    HARDENED_CHECK_EQ(r, SIZE_MAX);
     return error ^ (byte_count - 1);
   }
 
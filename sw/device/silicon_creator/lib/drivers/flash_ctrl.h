@@ -440,6 +440,66 @@ OT_WARN_UNUSED_RESULT
 rom_error_t flash_ctrl_info_erase(const flash_ctrl_info_page_t *info_page,
                                   flash_ctrl_erase_type_t erase_type);
 
+/**
+ * Starts writing data to the data partition without waiting for completion.
+ *
+ * Program operations are split at program window boundaries. All windows but
+ * the last are programmed before this function returns, so an arbitrary
+ * number of pages can be written with a single call; the last window is left
+ * in flight. The caller may do other work, e.g. receive or hash the next block
+ * of data, and must then complete the operation with `flash_ctrl_op_finish()`
+ * before starting another flash operation.
+ *
+ * `data` must stay valid until this function returns; the flash controller
+ * does not read it after that.
+ *
+ * @param addr Address to write to.
+ * @param word_count Number of bus words to write. Must be non-zero.
+ * @param data Data to write. Must be word aligned.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                        const void *data);
+
+/**
+ * Starts erasing a data partition page or bank without waiting for
+ * completion.
+ *
+ * The operation must be completed with `flash_ctrl_op_finish()` before
+ * starting another flash operation.
+ *
+ * @param addr Address that falls within the bank or page being deleted.
+ * @param erase_type Whether to erase a page or a bank.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_erase_start(uint32_t addr,
+                                        flash_ctrl_erase_type_t erase_type);
+
+/**
+ * Checks whether the flash operation in flight has completed.
+ *
+ * This does not acknowledge the completion; `flash_ctrl_op_finish()` must
+ * still be called.
+ *
+ * @return kHardenedBoolTrue if the operation has completed.
+ */
+hardened_bool_t flash_ctrl_op_poll(void);
+
+/**
+ * Completes the flash operation in flight.
+ *
+ * Blocks until the operation started by `flash_ctrl_data_write_start()` or
+ * `flash_ctrl_data_erase_start()` is done, acknowledges it and checks its
+ * status.
+ *
+ * @return Result of the operation, using the same error codes as the blocking
+ * function for the same kind of operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_op_finish(void);
+
 /**
  * A struct for specifying access permissions.
  *
@@ -479,6 +479,75 @@ TEST_F(TransferTest, TransferInternalError) {
             kErrorFlashCtrlDataRead);
 }
 
+TEST_F(TransferTest, ProgDataAsync) {
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG, 0x01234567,
+                      words_.size());
+  ExpectProgData(words_);
+  EXPECT_EQ(
+      flash_ctrl_data_write_start(0x01234567, words_.size(), &words_.front()),
+      kErrorOk);
+
+  EXPECT_ABS_READ32(base_ + FLASH_CTRL_OP_STATUS_REG_OFFSET,
+                    {{FLASH_CTRL_OP_STATUS_DONE_BIT, false}});
+  EXPECT_EQ(flash_ctrl_op_poll(), kHardenedBoolFalse);
+  EXPECT_ABS_READ32(base_ + FLASH_CTRL_OP_STATUS_REG_OFFSET,
+                    {{FLASH_CTRL_OP_STATUS_DONE_BIT, true}});
+  EXPECT_EQ(flash_ctrl_op_poll(), kHardenedBoolTrue);
+
+  EXPECT_ABS_READ32(
+      base_ + FLASH_CTRL_CONTROL_REG_OFFSET,
+      {{FLASH_CTRL_CONTROL_OP_OFFSET, FLASH_CTRL_CONTROL_OP_VALUE_PROG}});
+  ExpectWaitForDone(true, false);
+  EXPECT_EQ(flash_ctrl_op_finish(), kErrorOk);
+}
+
+TEST_F(TransferTest, ProgDataAsyncAcrossWindows) {
+  static const uint32_t kWinWords =
+      FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t);
+  std::vector<uint32_t> many_words(2 * kWinWords);
+  for (uint32_t i = 0; i < many_words.size(); ++i) {
+    many_words[i] = i;
+  }
+  auto iter = many_words.begin();
+
+  // The first window is completed before returning, the second one is not.
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG, 0, kWinWords);
+  ExpectProgData(std::vector<uint32_t>(iter, iter + kWinWords));
+  ExpectWaitForDone(true, false);
+  iter += kWinWords;
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG,
+                      kWinWords * sizeof(uint32_t), kWinWords);
+  ExpectProgData(std::vector<uint32_t>(iter, iter + kWinWords));
+  EXPECT_EQ(
+      flash_ctrl_data_write_start(0, many_words.size(), &many_words.front()),
+      kErrorOk);
+
+  EXPECT_ABS_READ32(
+      base_ + FLASH_CTRL_CONTROL_REG_OFFSET,
+      {{FLASH_CTRL_CONTROL_OP_OFFSET, FLASH_CTRL_CONTROL_OP_VALUE_PROG}});
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_op_finish(), kErrorFlashCtrlDataWrite);
+}
+
+TEST_F(TransferTest, ProgDataAsyncEmpty) {
+  EXPECT_EQ(flash_ctrl_data_write_start(0, 0, &words_.front()),
+            kErrorFlashCtrlDataWrite);
+}
+
+TEST_F(TransferTest, EraseDataPageAsync) {
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_ERASE, 0x01234567,
+                      1);
+  EXPECT_EQ(flash_ctrl_data_erase_start(0x01234567, kFlashCtrlEraseTypePage),
+            kErrorOk);
+
+  EXPECT_ABS_READ32(
+      base_ + FLASH_CTRL_CONTROL_REG_OFFSET,
+      {{FLASH_CTRL_CONTROL_OP_OFFSET, FLASH_CTRL_CONTROL_OP_VALUE_ERASE}});
+  ExpectWaitForDone(false, false);
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_op_finish(), kErrorFlashCtrlDataErase);
+}
+
 class ExecTest : public FlashCtrlTest {};
 
 TEST_F(ExecTest, Set) {
@@ -881,6 +950,19 @@ INSTANTIATE_TEST_SUITE_P(
            // large number of expectations.
         ));
 
+TEST_F(FlashCtrlTest, DataEraseVerifyEarlyExit) {
+  // Verification stops after the group of words that contains the first word
+  // that is not erased.
+  const uint32_t addr = 3 * FLASH_CTRL_PARAM_BYTES_PER_PAGE;
+  for (uint32_t i = 0; i < 8; ++i) {
+    EXPECT_ABS_READ32(TOP_EARLGREY_FLASH_CTRL_MEM_BASE_ADDR + addr +
+                          i * sizeof(uint32_t),
+                      i == 5 ? 0 : kFlashCtrlErasedWord);
+  }
+  EXPECT_EQ(flash_ctrl_data_erase_verify(addr, kFlashCtrlEraseTypePage),
+            kErrorFlashCtrlDataEraseVerify);
+}
+
 class DataRegionProtectTestSuite
     : public testing::TestWithParam<
           std::tuple<size_t, size_t, size_t, bool, bool, bool>> {
@@ -46,6 +46,24 @@ rom_error_t flash_ctrl_data_erase(uint32_t addr,
   return MockFlashCtrl::Instance().DataErase(addr, erase_type);
 }
 
+rom_error_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                        const void *data) {
+  return MockFlashCtrl::Instance().DataWriteStart(addr, word_count, data);
+}
+
+rom_error_t flash_ctrl_data_erase_start(uint32_t addr,
+                                        flash_ctrl_erase_type_t erase_type) {
+  return MockFlashCtrl::Instance().DataEraseStart(addr, erase_type);
+}
+
+hardened_bool_t flash_ctrl_op_poll(void) {
+  return MockFlashCtrl::Instance().OpPoll();
+}
+
+rom_error_t flash_ctrl_op_finish(void) {
+  return MockFlashCtrl::Instance().OpFinish();
+}
+
 rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
                                          flash_ctrl_erase_type_t erase_type) {
   return MockFlashCtrl::Instance().DataEraseVerify(addr, erase_type);
@@ -28,6 +28,11 @@ class MockFlashCtrl : public global_mock::GlobalMock<MockFlashCtrl> {
               (const flash_ctrl_info_page_t *, uint32_t, uint32_t,
                const void *));
   MOCK_METHOD(rom_error_t, DataErase, (uint32_t, flash_ctrl_erase_type_t));
+  MOCK_METHOD(rom_error_t, DataWriteStart, (uint32_t, uint32_t, const void *));
+  MOCK_METHOD(rom_error_t, DataEraseStart,
+              (uint32_t, flash_ctrl_erase_type_t));
+  MOCK_METHOD(hardened_bool_t, OpPoll, ());
+  MOCK_METHOD(rom_error_t, OpFinish, ());
   MOCK_METHOD(rom_error_t, DataEraseVerify,
               (uint32_t, flash_ctrl_erase_type_t));
   MOCK_METHOD(rom_error_t, InfoErase,
@@ -9,6 +9,7 @@
 
 #include "hw/top/dt/sram_ctrl.h"
 #include "sw/device/lib/base/macros.h"
+#include "sw/device/silicon_creator/lib/boot_data.h"
 #include "sw/device/silicon_creator/lib/boot_log.h"
 #include "sw/device/silicon_creator/lib/boot_svc/boot_svc_msg.h"
 #include "sw/device/silicon_creator/lib/error.h"
@@ -51,10 +52,18 @@ typedef struct retention_sram_creator {
    */
   uint32_t reserved[(2044 - (sizeof(uint32_t)          // reset_reason
                              + sizeof(boot_svc_msg_t)  // boot services message
+                             + sizeof(boot_data_index_t)
                              + sizeof(boot_log_t)      // boot_log
                              + sizeof(rom_error_t)     // last_shutdown_reason
                              )) /
                     sizeof(uint32_t)];
+  /**
+   * Boot data index.
+   *
+   * Location of the last valid boot data entry, used to avoid scanning the boot
+   * data pages on warm boots. See `boot_data_index_t`.
+   */
+  boot_data_index_t boot_data_index;
   /**
    * Boot log area.
    *
@@ -73,6 +82,7 @@ typedef struct retention_sram_creator {
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, reset_reasons, 0);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_svc_msg, 4);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, reserved, 260);
+OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_data_index, 1832);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_log, 1912);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, last_shutdown_reason, 2040);
 OT_ASSERT_SIZE(boot_svc_msg_t, 256);
@@ -8,7 +8,6 @@
 #include <stdint.h>
 
 #include "sw/device/lib/base/macros.h"
-#include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
 #include "sw/device/silicon_creator/lib/drivers/usb.h"
 #include "sw/device/silicon_creator/lib/error.h"
 
@@ -338,7 +337,10 @@ void dfu_protocol_handler(void *_ctx, uint8_t ep, usb_transfer_flags_t flags,
   if (flags & kUsbTransferFlagsReset) {
     // A USB reset after we've been enumerated means software reset.
     if (ctx->ep0.device_address && ctx->ep0.configuration) {
-      rstmgr_reboot();
+      // Only returns if the background flash operation failed.
+      OT_DISCARD(rescue_reboot(&ctx->state));
+      ctx->dfu_state = kDfuStateError;
+      ctx->dfu_error = kDfuErrVendor;
     }
   }
 
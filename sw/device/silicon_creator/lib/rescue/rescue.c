@@ -64,10 +64,57 @@ static inline bool is_rom_ext_update_allowed(rescue_state_t *state) {
           state->boot_log->rom_ext_slot == kBootSlotA);
 }
 
+/**
+ * Complete a background erase started by `flash_firmware_block`, if any.
+ *
+ * This must be called before issuing any other flash operation.
+ *
+ * @param state Rescue state.
+ * @return The result of the erase.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t flash_erase_finish(rescue_state_t *state) {
+  if (state->flash_erase_pending) {
+    state->flash_erase_pending = false;
+    HARDENED_RETURN_IF_ERROR(flash_ctrl_op_finish());
+  }
+  return kErrorOk;
+}
+
+/**
+ * Erase the pages of the firmware partition up to (but not including) `end`.
+ *
+ * Pages are erased lazily as the image is streamed in rather than erasing the
+ * whole rescue range up front: only the pages which are about to be written
+ * are erased, so the cost of an upload scales with the size of the image
+ * instead of the size of the slot.
+ *
+ * @param state Rescue state.
+ * @param bank_offset Byte offset of the bank holding the partition.
+ * @param end Partition-relative offset to erase up to.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t flash_erase_ahead(rescue_state_t *state,
+                                     uint32_t bank_offset, uint32_t end) {
+  HARDENED_RETURN_IF_ERROR(flash_erase_finish(state));
+  if (end > state->flash_limit) {
+    end = state->flash_limit;
+  }
+  while (state->flash_erased < end) {
+    HARDENED_RETURN_IF_ERROR(flash_ctrl_data_erase(
+        bank_offset + state->flash_erased, kFlashCtrlEraseTypePage));
+    state->flash_erased += kFlashPageSize;
+  }
+  return kErrorOk;
+}
+
 rom_error_t flash_firmware_block(rescue_state_t *state) {
   uint32_t bank_offset =
       state->mode == kRescueModeFirmwareSlotB ? kFlashBankSize : 0;
   if (state->flash_offset == 0) {
+    // A new upload may follow a previous one with an erase still in flight.
+    HARDENED_RETURN_IF_ERROR(flash_erase_finish(state));
     // TODO(#24428): Make sure we interact correctly with owner flash region
     // configuration.
     flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
@@ -82,13 +129,10 @@ rom_error_t flash_firmware_block(rescue_state_t *state) {
         (is_rom_ext_update_allowed(state) && is_rom_ext(state->data))
             ? 0
             : state->flash_start;
+    // Nothing in the allowed range has been erased yet; pages are erased on
+    // demand as the image is written.
+    state->flash_erased = state->flash_begin;
 
-    // Erase the allowed range in the requested partition.
-    for (uint32_t addr = state->flash_begin; addr < state->flash_limit;
-         addr += kFlashPageSize) {
-      HARDENED_RETURN_IF_ERROR(
-          flash_ctrl_data_erase(bank_offset + addr, kFlashCtrlEraseTypePage));
-    }
     // Regardless of whether we're allowed to flash the ROM_EXT, set the flash
     // offset to zero if the data stream contains a ROM_EXT, otherwise, set to
     // flash_start. This will allow rescue to silently consume the ROM_EXT if
@@ -103,11 +147,24 @@ rom_error_t flash_firmware_block(rescue_state_t *state) {
     // Beyond the allowed limit; return an error.
     return kErrorRescueImageTooBig;
   } else {
-    // In the allowed range; flash the data.
+    // In the allowed range; make sure the destination is erased and flash the
+    // data.
+    uint32_t next = state->flash_offset + sizeof(state->data);
+    HARDENED_RETURN_IF_ERROR(flash_erase_ahead(state, bank_offset, next));
     HARDENED_RETURN_IF_ERROR(flash_ctrl_data_write(
         bank_offset + state->flash_offset,
         sizeof(state->data) / sizeof(uint32_t), state->data));
-    state->flash_offset += sizeof(state->data);
+    state->flash_offset = next;
+    // Start erasing the page the next block will land in.  The erase runs
+    // while the transport receives that block and is completed by the next
+    // call to `flash_erase_ahead`.
+    if (state->flash_erased < state->flash_limit &&
+        state->flash_erased < next + sizeof(state->data)) {
+      HARDENED_RETURN_IF_ERROR(flash_ctrl_data_erase_start(
+          bank_offset + state->flash_erased, kFlashCtrlEraseTypePage));
+      state->flash_erased += kFlashPageSize;
+      state->flash_erase_pending = true;
+    }
   }
   return kErrorOk;
 }
@@ -152,7 +209,12 @@ static void ownership_erase(void) {
 
 rom_error_t rescue_validate_mode(uint32_t mode, rescue_state_t *state) {
   rescue_msg("\r\nmode: %C\r\n", bitfield_byteswap32(mode));
-  rom_error_t result = kErrorOk;
+  // Make sure a background erase from a firmware upload has completed before
+  // the new mode can issue flash operations of its own.
+  rom_error_t result = flash_erase_finish(state);
+  if (result != kErrorOk) {
+    goto exitproc;
+  }
 
   // The following commands are always allowed and are not subject to
   // the "command allowed" check.
@@ -345,6 +407,7 @@ void rescue_state_init(rescue_state_t *state, boot_data_t *bootdata,
   state->config = config;
   state->default_mode = kRescueModeFirmware;
   state->next_mode = 0;
+  state->flash_erase_pending = false;
 
   if ((hardened_bool_t)config == kHardenedBoolFalse) {
     HARDENED_CHECK_EQ((hardened_bool_t)config, kHardenedBoolFalse);
@@ -388,6 +451,18 @@ rom_error_t rescue_inactivity(rescue_state_t *state) {
   return kErrorOk;
 }
 
+rom_error_t rescue_finish(rescue_state_t *state, rom_error_t result) {
+  HARDENED_RETURN_IF_ERROR(flash_erase_finish(state));
+  return result;
+}
+
+rom_error_t rescue_reboot(rescue_state_t *state) {
+  HARDENED_RETURN_IF_ERROR(flash_erase_finish(state));
+  rstmgr_reboot();
+  // Only reached in off-target tests, where `rstmgr_reboot()` returns.
+  return kErrorRescueReboot;
+}
+
 hardened_bool_t rescue_enter_on_fail(const owner_rescue_config_t *config) {
   if ((hardened_bool_t)config != kHardenedBoolFalse) {
     if (bitfield_bit32_read(config->timeout, RESCUE_ENTER_ON_FAIL_BIT)) {
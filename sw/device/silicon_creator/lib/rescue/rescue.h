@@ -94,6 +94,12 @@ typedef struct RescueState {
   // the same as `flash_start`, but if we're allowed to write the ROM_EXT
   // and we've detected a ROM_EXT, this may be adjusted to zero.
   uint32_t flash_begin;
+  // Partition-relative offset up to which flash has been erased.  Pages are
+  // erased lazily, just ahead of `flash_offset`, rather than all at once.
+  uint32_t flash_erased;
+  // Whether an erase of the page just below `flash_erased` is still in
+  // flight.
+  bool flash_erase_pending;
   // Range to erase and write for firmware rescue (inclusive).
   uint32_t flash_start;
   uint32_t flash_limit;
@@ -167,6 +173,30 @@ rom_error_t rescue_enter_handler(boot_svc_msg_t *msg);
  */
 rom_error_t rescue_inactivity(rescue_state_t *state);
 
+/**
+ * Leave the rescue protocol.
+ *
+ * Completes any flash operation the rescue state machine left running in the
+ * background, so that the caller may use the flash controller again.
+ *
+ * @param state Rescue state
+ * @param result The result of the rescue protocol.
+ * @return `result`, or the error from the flash operation if it failed.
+ */
+rom_error_t rescue_finish(rescue_state_t *state, rom_error_t result);
+
+/**
+ * Reboot the chip from within the rescue protocol.
+ *
+ * Completes any flash operation the rescue state machine left running in the
+ * background first, so that the reset cannot interrupt it. The chip is only
+ * rebooted if that operation succeeded.
+ *
+ * @param state Rescue state
+ * @return The error from the flash operation; does not return otherwise.
+ */
+rom_error_t rescue_reboot(rescue_state_t *state);
+
 /**
  * Perform the rescue protocol.
  *
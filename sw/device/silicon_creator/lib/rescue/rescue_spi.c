@@ -11,7 +11,6 @@
 #include "sw/device/silicon_creator/lib/boot_data.h"
 #include "sw/device/silicon_creator/lib/dbg_print.h"
 #include "sw/device/silicon_creator/lib/drivers/lifecycle.h"
-#include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
 #include "sw/device/silicon_creator/lib/drivers/spi_device.h"
 #include "sw/device/silicon_creator/lib/drivers/usb.h"
 #include "sw/device/silicon_creator/lib/error.h"
@@ -92,15 +91,18 @@ rom_error_t rescue_protocol(boot_data_t *bootdata, boot_log_t *boot_log,
   spi_device_cmd_t cmd;
   uint32_t length;
   while (true) {
-    RETURN_IF_ERROR(rescue_inactivity(&ctx.state));
-    rom_error_t result = spi_device_cmd_get(&cmd, /*blocking=*/false);
+    rom_error_t result = rescue_inactivity(&ctx.state);
+    if (result != kErrorOk) {
+      return rescue_finish(&ctx.state, result);
+    }
+    result = spi_device_cmd_get(&cmd, /*blocking=*/false);
     switch (result) {
       case kErrorOk:
         break;
       case kErrorNoData:
         continue;
       default:
-        return result;
+        return rescue_finish(&ctx.state, result);
     }
     switch (cmd.opcode) {
       case kSpiDeviceOpcodePageProgram: {
@@ -130,7 +132,8 @@ rom_error_t rescue_protocol(boot_data_t *bootdata, boot_log_t *boot_log,
       } break;
 
       case kSpiDeviceOpcodeReset:
-        rstmgr_reboot();
+        // Only returns if the background flash operation failed.
+        dfu_transport_result(&ctx, rescue_reboot(&ctx.state));
         break;
       default:
         dfu_transport_result(&ctx, kErrorUsbBadSetup);
@@ -5,7 +5,6 @@
 #include "sw/device/lib/arch/device.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/silicon_creator/lib/boot_data.h"
-#include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
 #include "sw/device/silicon_creator/lib/drivers/uart.h"
 #include "sw/device/silicon_creator/lib/ownership/datatypes.h"
 #include "sw/device/silicon_creator/lib/rescue/rescue.h"
@@ -161,7 +160,7 @@ rom_error_t rescue_protocol(boot_data_t *bootdata, boot_log_t *boot_log,
   uart_enable_receiver();
   rom_error_t result = protocol(&rescue_state);
   if (result == kErrorRescueReboot) {
-    rstmgr_reboot();
+    result = rescue_reboot(&rescue_state);
   }
-  return result;
+  return rescue_finish(&rescue_state, result);
 }
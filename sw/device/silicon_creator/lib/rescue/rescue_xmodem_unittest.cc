@@ -3,8 +3,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <stdio.h>
+#include <string.h>
 #include <tuple>
 
+#include "sw/device/silicon_creator/lib/base/chip.h"
 #include "sw/device/silicon_creator/lib/boot_data.h"
 #include "sw/device/silicon_creator/lib/boot_log.h"
 #include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
@@ -15,6 +17,8 @@
 #include "sw/device/silicon_creator/lib/rescue/rescue.h"
 #include "sw/device/silicon_creator/testing/rom_test.h"
 
+#include "hw/top/flash_ctrl_regs.h"
+
 // #include "testing/base/public/gmock.h"
 // #include "testing/base/public/gunit.h"
 
@@ -51,6 +55,8 @@ class XmodemTest : public rom_test::RomTest {
     ON_CALL(flash_, DataDefaultPermsSet(_)).WillByDefault(Return());
     ON_CALL(flash_, DataErase(_, _)).WillByDefault(Return(kErrorOk));
     ON_CALL(flash_, DataWrite(_, _, _)).WillByDefault(Return(kErrorOk));
+    ON_CALL(flash_, DataEraseStart(_, _)).WillByDefault(Return(kErrorOk));
+    ON_CALL(flash_, OpFinish()).WillByDefault(Return(kErrorOk));
   }
 
   void HandleOwnerWrite() {
@@ -148,6 +154,42 @@ INSTANTIATE_TEST_SUITE_P(
                     std::make_tuple(kRescueModeNoOp, 1024, 2),
                     std::make_tuple(kRescueModeNoOp, 128, 16)));
 
+// Tests that a firmware upload only erases the pages it writes to, plus the
+// page erased ahead in the background for the next block.
+TEST_F(XmodemTest, FirmwareErasesOnDemand) {
+  constexpr uint32_t kPageSize = FLASH_CTRL_PARAM_BYTES_PER_PAGE;
+  constexpr uint32_t kUploadSize = 2 * kPageSize;
+  static_assert(sizeof(state_.data) == kPageSize,
+                "This test assumes one data block per flash page");
+  rescue_validate_mode(kRescueModeFirmware, &state_);
+  memset(state_.data, 0, sizeof(state_.data));
+  HandleFrame(1024);
+  HandleFlashWrite();
+
+  EXPECT_CALL(flash_, DataErase(_, _)).Times(0);
+  EXPECT_CALL(flash_, DataEraseStart(_, _)).Times(0);
+  EXPECT_CALL(flash_, DataErase(CHIP_ROM_EXT_SIZE_MAX, kFlashCtrlEraseTypePage))
+      .WillOnce(Return(kErrorOk));
+  for (uint32_t addr = CHIP_ROM_EXT_SIZE_MAX + kPageSize;
+       addr <= CHIP_ROM_EXT_SIZE_MAX + kUploadSize; addr += kPageSize) {
+    EXPECT_CALL(flash_, DataEraseStart(addr, kFlashCtrlEraseTypePage))
+        .WillOnce(Return(kErrorOk));
+  }
+
+  for (size_t i = 0; i < kUploadSize / 1024; ++i) {
+    EXPECT_EQ(protocol_inner(&state_), kErrorOk);
+  }
+  EXPECT_EQ(state_.flash_offset, CHIP_ROM_EXT_SIZE_MAX + kUploadSize);
+  EXPECT_EQ(state_.flash_erased,
+            CHIP_ROM_EXT_SIZE_MAX + kUploadSize + kPageSize);
+  EXPECT_TRUE(state_.flash_erase_pending);
+
+  // Switching modes completes the background erase.
+  EXPECT_CALL(flash_, OpFinish()).WillOnce(Return(kErrorOk));
+  EXPECT_EQ(rescue_validate_mode(kRescueModeNoOp, &state_), kErrorOk);
+  EXPECT_FALSE(state_.flash_erase_pending);
+}
+
 class XmodemSendTests
     : public XmodemTest,
       public testing::WithParamInterface<std::tuple<rescue_mode_t, size_t>> {};
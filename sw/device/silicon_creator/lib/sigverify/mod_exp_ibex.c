@@ -71,6 +71,86 @@ static uint32_t shift_left(sigverify_rsa_buffer_t *a) {
   return msb;
 }
 
+enum {
+  /**
+   * Number of Montgomery squarings used to compute R^2 mod n.
+   *
+   * `calc_r_square` doubles R mod n `kSigVerifyRsaNumBits >> k` times and then
+   * squares k times. One squaring costs roughly as much as 200 doublings, so
+   * this balances the two: more squarings would be slower, not faster.
+   */
+  kRSquareNumSquarings = 4,
+  /**
+   * Number of digits processed per iteration of the unrolled inner loop of
+   * `mont_mul`.
+   */
+  kMontMulUnroll = 4,
+};
+static_assert(kSigVerifyRsaNumBits % (1 << kRSquareNumSquarings) == 0,
+              "kRSquareNumSquarings does not divide kSigVerifyRsaNumBits");
+static_assert(kRSquareNumSquarings % 2 == 0,
+              "kRSquareNumSquarings must be even");
+
+/**
+ * Processes one digit of the inner loop of Montgomery multiplication.
+ *
+ * Computes the two accumulations of step 2.2 of the algorithm for digit j:
+ *   acc0 = x_i * y_j + r_j + c0
+ *   acc1 = u_i * n_j + (acc0 mod b) + c1
+ * stores the carry words `acc0 / b` and `acc1 / b` in `c0` and `c1`, and
+ * returns `acc1 mod b`, which is digit j-1 of the result after the division by
+ * b. Neither accumulation can wrap since (b-1)^2 + 2*(b-1) = b^2 - 1.
+ *
+ * @param x_i Digit i of `x`.
+ * @param y_j Digit j of `y`.
+ * @param u_i Multiple of the modulus for this iteration.
+ * @param n_j Digit j of the modulus.
+ * @param r_j Digit j of the intermediate result.
+ * @param[in,out] c0 Carry word of `acc0`.
+ * @param[in,out] c1 Carry word of `acc1`.
+ * @return Digit j-1 of the new intermediate result.
+ */
+static OT_ALWAYS_INLINE uint32_t mont_mul_step(uint32_t x_i, uint32_t y_j,
+                                               uint32_t u_i, uint32_t n_j,
+                                               uint32_t r_j, uint32_t *c0,
+                                               uint32_t *c1) {
+#ifdef OT_PLATFORM_RV32
+  // Ibex has no add-with-carry, so each 64-bit addition is an add, an sltu to
+  // recover the carry and an add into the high word. The `mulhu` for the
+  // modulus product is issued after the low word has been consumed so that
+  // only three temporaries are live.
+  uint32_t lo;
+  uint32_t hi;
+  uint32_t carry;
+  asm("mul   %[lo], %[x], %[y]\n"
+      "mulhu %[hi], %[x], %[y]\n"
+      "add   %[lo], %[lo], %[r]\n"
+      "sltu  %[carry], %[lo], %[r]\n"
+      "add   %[hi], %[hi], %[carry]\n"
+      "add   %[lo], %[lo], %[c0]\n"
+      "sltu  %[carry], %[lo], %[c0]\n"
+      "add   %[c0], %[hi], %[carry]\n"
+      "mul   %[hi], %[u], %[n]\n"
+      "add   %[hi], %[hi], %[lo]\n"
+      "sltu  %[carry], %[hi], %[lo]\n"
+      "mulhu %[lo], %[u], %[n]\n"
+      "add   %[lo], %[lo], %[carry]\n"
+      "add   %[hi], %[hi], %[c1]\n"
+      "sltu  %[carry], %[hi], %[c1]\n"
+      "add   %[c1], %[lo], %[carry]\n"
+      : [lo] "=&r"(lo), [hi] "=&r"(hi), [carry] "=&r"(carry),
+        [c0] "+&r"(*c0), [c1] "+&r"(*c1)
+      : [x] "r"(x_i), [y] "r"(y_j), [u] "r"(u_i), [n] "r"(n_j), [r] "r"(r_j));
+  return hi;
+#else
+  uint64_t acc0 = (uint64_t)x_i * y_j + r_j + *c0;
+  uint64_t acc1 = (uint64_t)u_i * n_j + (uint32_t)acc0 + *c1;
+  *c0 = (uint32_t)(acc0 >> 32);
+  *c1 = (uint32_t)(acc1 >> 32);
+  return (uint32_t)acc1;
+#endif
+}
+
 /**
  * Computes the Montgomery reduction of the product of two integers.
  *
@@ -80,7 +160,10 @@ static uint32_t shift_left(sigverify_rsa_buffer_t *a) {
  * - n is the modulus of the key, and
  * - R is 2^`kSigVerifyRsaNumBits`, e.g. 2^3072 for RSA-3072.
  *
- * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.36.
+ * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.36. The
+ * multiplication and reduction of each digit of `x` share a single pass over
+ * the digits (coarsely integrated operand scanning, CIOS), with the inner
+ * loop unrolled `kMontMulUnroll` times.
  *
  * @param key An RSA public key.
  * @param x Buffer that holds `x`, little-endian.
@@ -93,30 +176,37 @@ static void mont_mul(const sigverify_rsa_key_t *key,
                      sigverify_rsa_buffer_t *result) {
   memset(result->data, 0, sizeof(result->data));
 
+  const uint32_t *n = key->n.data;
+  uint32_t *r = result->data;
   for (size_t i = 0; i < ARRAYSIZE(x->data); ++i) {
+    const uint32_t x_i = x->data[i];
     // The loop below reads one word ahead of writes to avoid a separate loop
-    // for the division by `b` in step 2.2 of the algorithm. Thus, `acc0` and
-    // `acc1` are initialized here before the loop. `acc0` holds the sum of
-    // first two addends in step 2.2 while `acc1` holds the entire sum. Carries
-    // of these operations are stored separately in the upper words of `acc0`
-    // and `acc1`. `acc0` and `acc1` can safely store these intermediate values,
-    // i.e. without wrapping, because UINT32_MAX^2 + 2*UINT32_MAX is
-    // 0xffff_ffff_ffff_ffff.
-
-    // Holds the sum of the first two addends in step 2.2.
-    uint64_t acc0 = (uint64_t)x->data[i] * y->data[0] + result->data[0];
+    // for the division by `b` in step 2.2 of the algorithm, so the first digit
+    // is handled here: it determines `u_i`, and its low word is zero by
+    // construction.
+    uint64_t acc0 = (uint64_t)x_i * y->data[0] + r[0];
     const uint32_t u_i = (uint32_t)acc0 * key->n0_inv[0];
-    // Holds the sum of the all three addends in step 2.2.
-    uint64_t acc1 = (uint64_t)u_i * key->n.data[0] + (uint32_t)acc0;
+    uint64_t acc1 = (uint64_t)u_i * n[0] + (uint32_t)acc0;
+    uint32_t c0 = (uint32_t)(acc0 >> 32);
+    uint32_t c1 = (uint32_t)(acc1 >> 32);
 
     // Process the i^th digit of `x`, i.e. `x[i]`.
-    for (size_t j = 1; j < ARRAYSIZE(result->data); ++j) {
-      acc0 = (uint64_t)x->data[i] * y->data[j] + result->data[j] + (acc0 >> 32);
-      acc1 = (uint64_t)u_i * key->n.data[j] + (uint32_t)acc0 + (acc1 >> 32);
-      result->data[j - 1] = (uint32_t)acc1;
+    size_t j = 1;
+    for (; j + kMontMulUnroll <= ARRAYSIZE(result->data);
+         j += kMontMulUnroll) {
+      r[j - 1] = mont_mul_step(x_i, y->data[j], u_i, n[j], r[j], &c0, &c1);
+      r[j] = mont_mul_step(x_i, y->data[j + 1], u_i, n[j + 1], r[j + 1], &c0,
+                           &c1);
+      r[j + 1] = mont_mul_step(x_i, y->data[j + 2], u_i, n[j + 2], r[j + 2],
+                               &c0, &c1);
+      r[j + 2] = mont_mul_step(x_i, y->data[j + 3], u_i, n[j + 3], r[j + 3],
+                               &c0, &c1);
+    }
+    for (; j < ARRAYSIZE(result->data); ++j) {
+      r[j - 1] = mont_mul_step(x_i, y->data[j], u_i, n[j], r[j], &c0, &c1);
     }
-    acc0 = (acc0 >> 32) + (acc1 >> 32);
-    result->data[ARRAYSIZE(result->data) - 1] = (uint32_t)acc0;
+    acc0 = (uint64_t)c0 + c1;
+    r[ARRAYSIZE(result->data) - 1] = (uint32_t)acc0;
 
     // The intermediate result of this algorithm before the check below is
     // bounded by R + n (Eq. (4) in Montgomery Arithmetic from a Software
@@ -136,32 +226,37 @@ static void mont_mul(const sigverify_rsa_key_t *key,
 /**
  * Calculates R^2 mod n, where R = 2^kSigVerifyRsaNumBits.
  *
+ * Doubles R mod n to get (2^s * R) mod n, where
+ * s = kSigVerifyRsaNumBits / 2^k and k = `kRSquareNumSquarings`. Then squares
+ * k times: each Montgomery squaring maps a*R to a^2*R, so the result is
+ * (2^s)^(2^k) * R = R^2 mod n.
+ *
  * @param key An RSA public key.
  * @param[out] result Buffer to write the result to, little-endian.
  */
 static void calc_r_square(const sigverify_rsa_key_t *key,
                           sigverify_rsa_buffer_t *result) {
-  sigverify_rsa_buffer_t buf;
-  memset(buf.data, 0, sizeof(result->data));
-  // This subtraction sets buf = -n mod R = R - n, which is equivalent to R
-  // modulo n and ensures that `buf` fits in `kSigVerifyRsaNumWords` going
+  memset(result->data, 0, sizeof(result->data));
+  // This subtraction sets result = -n mod R = R - n, which is equivalent to R
+  // modulo n and ensures that `result` fits in `kSigVerifyRsaNumWords` going
   // into the loop.
-  OT_DISCARD(subtract_modulus(key, &buf));
+  OT_DISCARD(subtract_modulus(key, result));
 
-  // Compute (2^96 * R) mod n.
-  // Each run of the loop doubles buf and reduces modulo n.
-  for (size_t i = 0; i < 96; ++i) {
-    uint32_t msb = shift_left(&buf);
-    // Reduce until buf < n. Doing this at every iteration minimizes the
+  // Compute (2^s * R) mod n.
+  // Each run of the loop doubles result and reduces modulo n.
+  for (size_t i = 0; i < (kSigVerifyRsaNumBits >> kRSquareNumSquarings);
+       ++i) {
+    uint32_t msb = shift_left(result);
+    // Reduce until result < n. Doing this at every iteration minimizes the
     // total number of subtractions that we need to perform.
-    while (msb > 0 || greater_equal_modulus(key, &buf)) {
-      msb -= subtract_modulus(key, &buf);
+    while (msb > 0 || greater_equal_modulus(key, result)) {
+      msb -= subtract_modulus(key, result);
     }
   }
 
-  // Perform 5 montgomery squares to get RR = ((2^96)^32 * R) mod n
-  mont_mul(key, &buf, &buf, result);
-  for (size_t i = 0; i < 2; ++i) {
+  // Square k times to get RR = ((2^s)^(2^k) * R) mod n.
+  sigverify_rsa_buffer_t buf;
+  for (size_t i = 0; i < kRSquareNumSquarings / 2; ++i) {
     mont_mul(key, result, result, &buf);
     mont_mul(key, &buf, &buf, result);
   }
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/testing/profile.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
 #include "sw/device/silicon_creator/lib/base/sec_mmio.h"
 #include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex.h"
@@ -16,12 +17,17 @@
 // Index of the test vector currently under test
 static uint32_t test_index;
 
+// Cycle counts of the modular exponentiations, across all test vectors.
+static profile_stats_t mod_exp_stats;
+
 rom_error_t sigverify_mod_exp_ibex_test(void) {
   sigverify_test_vector_t testvec = sigverify_tests[test_index];
 
   sigverify_rsa_buffer_t recovered_message;
+  uint64_t t_start = profile_start();
   rom_error_t err =
       sigverify_mod_exp_ibex(&testvec.key, &testvec.sig, &recovered_message);
+  profile_stats_add(&mod_exp_stats, profile_end(t_start));
   if (err != kErrorOk) {
     if (testvec.valid) {
       LOG_ERROR("Error on a valid signature.");
@@ -62,6 +68,7 @@ bool test_main(void) {
     test_index = i;
     EXECUTE_TEST(result, sigverify_mod_exp_ibex_test);
   }
+  profile_stats_print(&mod_exp_stats, "sigverify_mod_exp_ibex");
   LOG_INFO("Finished mod_exp_ibex_functest:%s", RULE_NAME);
   return status_ok(result);
 }
@@ -23,6 +23,9 @@
 // Index of the test vector currently under test
 static uint32_t test_index = 0;
 
+// Cycle counts of the verifications with valid signatures.
+static profile_stats_t verify_stats;
+
 OTTF_DEFINE_TEST_CONFIG();
 
 enum {
@@ -39,10 +42,12 @@ enum {
  * @param test Test vector to run.
  * @param[out] root Output buffer for root node computed from signature.
  * @param[out] pub_root Output buffer for root node computed from public key.
+ * @param[out] stats Summary to record the cycle count in, or NULL.
  */
 OT_WARN_UNUSED_RESULT
 static rom_error_t run_verify(const spx_verify_test_vector_t *test,
-                              uint32_t *root, uint32_t *pub_root) {
+                              uint32_t *root, uint32_t *pub_root,
+                              profile_stats_t *stats) {
   // Calculate the public-key root to compare against.
   spx_public_key_root(test->pk, pub_root);
 
@@ -52,6 +57,9 @@ static rom_error_t run_verify(const spx_verify_test_vector_t *test,
                                test->msg_len, test->pk, root);
   uint32_t cycles = profile_end(t_start);
   LOG_INFO("Verification took %u cycles.", cycles);
+  if (stats != NULL) {
+    profile_stats_add(stats, cycles);
+  }
 
   return err;
 }
@@ -67,7 +75,7 @@ static rom_error_t spx_verify_test(void) {
 
   uint32_t root[kSpxVerifyRootNumWords];
   uint32_t pub_root[kSpxVerifyRootNumWords];
-  RETURN_IF_ERROR(run_verify(&test, root, pub_root));
+  RETURN_IF_ERROR(run_verify(&test, root, pub_root, &verify_stats));
 
   // Ensure that both roots are the same (verification passed).
   CHECK_ARRAYS_EQ(root, pub_root, kSpxVerifyRootNumWords);
@@ -93,7 +101,7 @@ static rom_error_t spx_verify_negative_test(void) {
 
   uint32_t root[kSpxVerifyRootNumWords];
   uint32_t pub_root[kSpxVerifyRootNumWords];
-  RETURN_IF_ERROR(run_verify(&test, root, pub_root));
+  RETURN_IF_ERROR(run_verify(&test, root, pub_root, NULL));
 
   // Ensure that the roots are the different (verification failed).
   CHECK_ARRAYS_NE(root, pub_root, kSpxVerifyRootNumWords);
@@ -115,6 +123,7 @@ bool test_main(void) {
     test_index++;
     LOG_INFO("Finished test %d of %d.", test_index, kSpxVerifyNumTests);
   }
+  profile_stats_print(&verify_stats, "Verification");
 
   LOG_INFO("Running %d tests with invalid signatures.", kNumNegativeTests);
 
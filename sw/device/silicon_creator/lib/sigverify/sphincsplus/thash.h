@@ -36,6 +36,49 @@ extern "C" {
 void thash(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
            const spx_addr_t *addr, uint32_t *out);
 
+/**
+ * Starts a tweakable hash computation without waiting for the result.
+ *
+ * Absorbs the address and input and starts the hash engine. The input buffer
+ * and address may be modified as soon as this returns, so the caller can
+ * prepare the next input while the digest is computed. Must be followed by
+ * `thash_end` before any other hash operation is started.
+ *
+ * @param in Input buffer.
+ * @param inblocks Number of `kSpxN`-byte blocks in input buffer.
+ * @param ctx Context object.
+ * @param addr Hypertree address.
+ */
+void thash_start(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
+                 const spx_addr_t *addr);
+
+/**
+ * Waits for the tweakable hash started by `thash_start` and reads the digest.
+ *
+ * @param[out] out Output buffer (at least `kSpxN` bytes).
+ */
+void thash_end(uint32_t *out);
+
+/**
+ * Iterates the tweakable hash along a WOTS+ chain.
+ *
+ * Interprets `buf` as the value of the chain at index `start` and replaces it
+ * with the value at index `start + steps`. `addr` must contain the address of
+ * the chain; its hash address is updated while each digest is computed, and
+ * on return is `start + steps`.
+ *
+ * The hash address is a single byte, so the caller must ensure that
+ * `start + steps <= UINT8_MAX`.
+ *
+ * @param[in,out] buf Chain value (`kSpxNWords` words).
+ * @param start Start index.
+ * @param steps Number of steps.
+ * @param ctx Context object.
+ * @param addr Hypertree address.
+ */
+void thash_chain(uint32_t *buf, uint8_t start, uint8_t steps,
+                 const spx_ctx_t *ctx, spx_addr_t *addr);
+
 #ifdef __cplusplus
 }
 #endif
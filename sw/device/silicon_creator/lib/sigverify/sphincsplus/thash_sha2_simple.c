@@ -11,11 +11,42 @@
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/sha2.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/thash.h"
 
-void thash(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
-           const spx_addr_t *addr, uint32_t *out) {
+enum {
+  /**
+   * Number of full words in the compressed address.
+   */
+  kAddrNumFullWords = kSpxSha256AddrBytes / sizeof(uint32_t),
+};
+
+void thash_start(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
+                 const spx_addr_t *addr) {
   hmac_sha256_restore(&ctx->state_seeded);
-  hmac_sha256_update((unsigned char *)addr->addr, kSpxSha256AddrBytes);
+  // The address is word-aligned, so write its full words directly and only
+  // fall back to byte writes for the remainder.
+  hmac_sha256_update_words(addr->addr, kAddrNumFullWords);
+  hmac_sha256_update(&addr->addr[kAddrNumFullWords],
+                     kSpxSha256AddrBytes % sizeof(uint32_t));
   hmac_sha256_update_words(in, inblocks * kSpxNWords);
   hmac_sha256_process();
+}
+
+void thash_end(uint32_t *out) {
   hmac_sha256_final_truncated(out, kSpxNWords);
 }
+
+void thash(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
+           const spx_addr_t *addr, uint32_t *out) {
+  thash_start(in, inblocks, ctx, addr);
+  thash_end(out);
+}
+
+void thash_chain(uint32_t *buf, uint8_t start, uint8_t steps,
+                 const spx_ctx_t *ctx, spx_addr_t *addr) {
+  spx_addr_hash_set(addr, start);
+  for (uint8_t i = 0; i < steps; i++) {
+    thash_start(buf, /*inblocks=*/1, ctx, addr);
+    // Update the address while HMAC is processing for performance reasons.
+    spx_addr_hash_set(addr, (uint8_t)(start + i + 1));
+    thash_end(buf);
+  }
+}
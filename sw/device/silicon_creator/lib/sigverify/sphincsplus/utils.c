@@ -53,26 +53,29 @@ void spx_utils_compute_root(const uint32_t *leaf, uint32_t leaf_idx,
   }
   auth_path += kSpxNWords;
 
-  for (uint8_t i = 0; i < tree_height - 1; i++) {
-    leaf_idx >>= 1;
-    idx_offset >>= 1;
-    // Set the address of the node we're creating.
-    spx_addr_tree_height_set(addr, i + 1);
-    spx_addr_tree_index_set(addr, leaf_idx + idx_offset);
+  // Set the address of the first node we're creating.
+  leaf_idx >>= 1;
+  idx_offset >>= 1;
+  spx_addr_tree_height_set(addr, 1);
+  spx_addr_tree_index_set(addr, leaf_idx + idx_offset);
 
+  for (uint8_t i = 0; i < tree_height - 1; i++) {
     // Pick the right or left neighbor, depending on parity of the node.
     uint32_t *hash_dst = (leaf_idx & 1) ? buffer_second : buffer;
     uint32_t *auth_dst = (leaf_idx & 1) ? buffer : buffer_second;
 
-    thash(buffer, /*inblocks=*/2, ctx, addr, hash_dst);
+    // The input and address have been absorbed once `thash_start` returns, so
+    // prepare the next node's input and address while the digest is computed.
+    thash_start(buffer, /*inblocks=*/2, ctx, addr);
     memcpy(auth_dst, auth_path, kSpxN);
     auth_path += kSpxNWords;
+    leaf_idx >>= 1;
+    idx_offset >>= 1;
+    spx_addr_tree_height_set(addr, i + 2);
+    spx_addr_tree_index_set(addr, leaf_idx + idx_offset);
+    thash_end(hash_dst);
   }
 
   // The last iteration is exceptional; we do not copy an auth_path node.
-  leaf_idx >>= 1;
-  idx_offset >>= 1;
-  spx_addr_tree_height_set(addr, tree_height);
-  spx_addr_tree_index_set(addr, leaf_idx + idx_offset);
   thash(buffer, 2, ctx, addr, root);
 }
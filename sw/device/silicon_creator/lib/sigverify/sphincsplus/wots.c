@@ -8,11 +8,9 @@
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/wots.h"
 
 #include "sw/device/lib/base/memory.h"
-#include "sw/device/silicon_creator/lib/drivers/hmac.h"
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/address.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/params.h"
-#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/sha2.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/thash.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/utils.h"
 
@@ -40,19 +38,8 @@ static void gen_chain(const uint32_t *in, uint8_t start, const spx_ctx_t *ctx,
   // Initialize out with the value at position `start`.
   memcpy(out, in, kSpxN);
 
-  // Iterate `kSpxWotsW - 1` calls to the hash function. This loop is
-  // performance-critical.
-  spx_addr_hash_set(addr, start);
-  for (uint8_t i = start; i + 1 < kSpxWotsW; i++) {
-    // This loop body is essentially just `thash`, inlined for performance.
-    hmac_sha256_restore(&ctx->state_seeded);
-    hmac_sha256_update((unsigned char *)addr->addr, kSpxSha256AddrBytes);
-    hmac_sha256_update_words(out, kSpxNWords);
-    hmac_sha256_process();
-    // Update the address while HMAC is processing for performance reasons.
-    spx_addr_hash_set(addr, i + 1);
-    hmac_sha256_final_truncated(out, kSpxNWords);
-  }
+  // Walk the chain up to index `kSpxWotsW - 1`. This is performance-critical.
+  thash_chain(out, start, (uint8_t)(kSpxWotsW - 1 - start), ctx, addr);
 }
 
 /**
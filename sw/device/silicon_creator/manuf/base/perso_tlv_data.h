@@ -69,6 +69,12 @@ typedef enum perso_tlv_object_type {
    * Personalization firmware SHA256 Hash.
    */
   kPersoObjectTypePersoSha256Hash = 7,
+  /**
+   * Digest of the inputs a DICE certificate was generated from, stored by the
+   * ROM_EXT after the certificate in the DICE certificate flash info page.
+   * Never sent to the host.
+   */
+  kPersoObjectTypeDiceCertInputs = 8,
   /**
    * Personalization blob version.
    */
@@ -0,0 +1,231 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/silicon_creator/lib/boot_log.h"
+#include "sw/device/silicon_creator/lib/boot_svc/boot_svc_msg.h"
+#include "sw/device/silicon_creator/lib/boot_svc/boot_svc_next_boot_bl0_slot.h"
+#include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
+#include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
+#include "sw/device/silicon_creator/manuf/base/perso_tlv_data.h"
+
+#include "hw/top/flash_ctrl_regs.h"  // Generated.
+
+/**
+ * Checks the record of the CDI_1 inputs the ROM_EXT keeps after the CDI_1
+ * certificate in the DiceCerts page.
+ *
+ * The test runs over several resets, keeping its state in the owner area of
+ * the retention SRAM:
+ * 1. Snapshot the CDI_1 certificate and the inputs record.
+ * 2. The inputs did not change, so the ROM_EXT must have taken the cached key:
+ *    the certificate and the record must be byte-identical. Corrupt the digest
+ *    in the record and reseal the page.
+ * 3. The corrupted record must not match, so the ROM_EXT falls back to the
+ *    keygen. The key is the same, so the certificate is kept and the record is
+ *    rewritten as it was in step 1.
+ * 4. Boot slot B, which holds this test with a higher security version. The
+ *    certificate and the record must both have been rewritten.
+ */
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  kPageNumWords = FLASH_CTRL_PARAM_BYTES_PER_PAGE / sizeof(uint32_t),
+  kPageDataSize = FLASH_CTRL_PARAM_BYTES_PER_PAGE - sizeof(hmac_digest_t),
+};
+
+typedef enum cert_inputs_test_state {
+  kCertInputsTestStateInit = 0,
+  kCertInputsTestStateCached,
+  kCertInputsTestStateCorrupted,
+  kCertInputsTestStateSecver,
+} cert_inputs_test_state_t;
+
+typedef struct cert_inputs_retram {
+  // The state of the test.
+  cert_inputs_test_state_t state;
+  // Digest of the CDI_1 certificate object taken in the first step.
+  hmac_digest_t cert;
+  // Digest of the inputs record object taken in the first step.
+  hmac_digest_t record;
+} cert_inputs_retram_t;
+
+typedef struct dice_certs_page {
+  uint8_t data[kPageDataSize];
+  hmac_digest_t digest;
+} dice_certs_page_t;
+
+static dice_certs_page_t page;
+
+/**
+ * Location of the CDI_1 certificate and its inputs record in `page`.
+ */
+typedef struct cdi_1_objs {
+  size_t cert_offset;
+  size_t cert_size;
+  size_t record_offset;
+  size_t record_size;
+} cdi_1_objs_t;
+
+static status_t page_read(void) {
+  TRY(flash_ctrl_info_read(&kFlashCtrlInfoPageDiceCerts, 0, kPageNumWords,
+                           &page));
+  hmac_digest_t digest;
+  hmac_sha256(page.data, sizeof(page.data), &digest);
+  TRY_CHECK_ARRAYS_EQ(digest.digest, page.digest.digest,
+                      ARRAYSIZE(digest.digest));
+  return OK_STATUS();
+}
+
+static status_t page_write(void) {
+  hmac_sha256(page.data, sizeof(page.data), &page.digest);
+  TRY(flash_ctrl_info_erase(&kFlashCtrlInfoPageDiceCerts,
+                            kFlashCtrlEraseTypePage));
+  TRY(flash_ctrl_info_write(&kFlashCtrlInfoPageDiceCerts, 0, kPageNumWords,
+                            &page));
+  return OK_STATUS();
+}
+
+// Objects are aligned to flash words.
+static size_t next_obj_offset(size_t offset, size_t size) {
+  return offset + ((size + 7) & ~(size_t)7);
+}
+
+static status_t cdi_1_find(cdi_1_objs_t *objs) {
+  size_t offset = 0;
+  while (offset < sizeof(page.data)) {
+    perso_tlv_cert_obj_t obj = {0};
+    TRY(perso_tlv_get_cert_obj(&page.data[offset], sizeof(page.data) - offset,
+                               kPersoBlobVersionV0, &obj));
+    if (memcmp(obj.name, "CDI_1", sizeof("CDI_1")) == 0) {
+      objs->cert_offset = offset;
+      objs->cert_size = obj.obj_size;
+      objs->record_offset = next_obj_offset(offset, obj.obj_size);
+      break;
+    }
+    offset = next_obj_offset(offset, obj.obj_size);
+  }
+  TRY_CHECK(offset < sizeof(page.data));
+
+  const uint8_t *record = &page.data[objs->record_offset];
+  TRY_CHECK(perso_tlv_object_type(record, kPersoBlobVersionV0) ==
+            kPersoObjectTypeDiceCertInputs);
+  objs->record_size = perso_tlv_object_size(record, kPersoBlobVersionV0);
+  TRY_CHECK(objs->record_size >
+            sizeof(perso_tlv_object_header_t) + sizeof(hmac_digest_t));
+  TRY_CHECK(objs->record_offset + objs->record_size <= sizeof(page.data));
+  return OK_STATUS();
+}
+
+static status_t cdi_1_digest(hmac_digest_t *cert, hmac_digest_t *record) {
+  TRY(page_read());
+  cdi_1_objs_t objs;
+  TRY(cdi_1_find(&objs));
+  hmac_sha256(&page.data[objs.cert_offset], objs.cert_size, cert);
+  hmac_sha256(&page.data[objs.record_offset], objs.record_size, record);
+  return OK_STATUS();
+}
+
+static status_t snapshot(cert_inputs_retram_t *state) {
+  TRY(cdi_1_digest(&state->cert, &state->record));
+  LOG_INFO("Snapshot taken");
+  state->state = kCertInputsTestStateCached;
+  rstmgr_reset();
+  return INTERNAL();
+}
+
+static status_t check_cached(cert_inputs_retram_t *state) {
+  hmac_digest_t cert;
+  hmac_digest_t record;
+  TRY(cdi_1_digest(&cert, &record));
+  TRY_CHECK_ARRAYS_EQ(cert.digest, state->cert.digest,
+                      ARRAYSIZE(cert.digest));
+  TRY_CHECK_ARRAYS_EQ(record.digest, state->record.digest,
+                      ARRAYSIZE(record.digest));
+
+  // Flip a bit of the digest in the record and reseal the page so that only
+  // the record check can catch it.
+  cdi_1_objs_t objs;
+  TRY(cdi_1_find(&objs));
+  page.data[objs.record_offset + sizeof(perso_tlv_object_header_t)] ^= 1;
+  flash_ctrl_cert_info_page_creator_cfg(&kFlashCtrlInfoPageDiceCerts);
+  TRY(page_write());
+  LOG_INFO("Corrupted CDI_1 inputs record");
+
+  state->state = kCertInputsTestStateCorrupted;
+  rstmgr_reset();
+  return INTERNAL();
+}
+
+static status_t check_corrupted(retention_sram_t *retram,
+                                cert_inputs_retram_t *state) {
+  hmac_digest_t cert;
+  hmac_digest_t record;
+  TRY(cdi_1_digest(&cert, &record));
+  TRY_CHECK_ARRAYS_EQ(cert.digest, state->cert.digest,
+                      ARRAYSIZE(cert.digest));
+  TRY_CHECK_ARRAYS_EQ(record.digest, state->record.digest,
+                      ARRAYSIZE(record.digest));
+
+  LOG_INFO("Switching to slot B");
+  state->state = kCertInputsTestStateSecver;
+  boot_svc_msg_t msg = {0};
+  boot_svc_next_boot_bl0_slot_req_init(kBootSlotUnspecified, kBootSlotB,
+                                       &msg.next_boot_bl0_slot_req);
+  retram->creator.boot_svc_msg = msg;
+  rstmgr_reset();
+  return INTERNAL();
+}
+
+static status_t check_secver(retention_sram_t *retram,
+                             cert_inputs_retram_t *state) {
+  TRY_CHECK(retram->creator.boot_log.bl0_slot == kBootSlotB);
+  hmac_digest_t cert;
+  hmac_digest_t record;
+  TRY(cdi_1_digest(&cert, &record));
+  TRY_CHECK(memcmp(&cert, &state->cert, sizeof(cert)) != 0);
+  TRY_CHECK(memcmp(&record, &state->record, sizeof(record)) != 0);
+  return OK_STATUS();
+}
+
+static status_t cert_inputs_test(void) {
+  retention_sram_t *retram = retention_sram_get();
+  TRY(boot_log_check(&retram->creator.boot_log));
+  cert_inputs_retram_t *state = (cert_inputs_retram_t *)&retram->owner;
+  if (bitfield_bit32_read(retram->creator.reset_reasons,
+                          kRstmgrReasonPowerOn)) {
+    memset(&retram->owner, 0, sizeof(retram->owner));
+  }
+
+  LOG_INFO("Test state = %d", state->state);
+  switch (state->state) {
+    case kCertInputsTestStateInit:
+      return snapshot(state);
+    case kCertInputsTestStateCached:
+      return check_cached(state);
+    case kCertInputsTestStateCorrupted:
+      return check_corrupted(retram, state);
+    case kCertInputsTestStateSecver:
+      return check_secver(retram, state);
+    default:
+      LOG_ERROR("Unknown state: %d", state->state);
+      return UNKNOWN();
+  }
+}
+
+bool test_main(void) {
+  status_t sts = cert_inputs_test();
+  if (status_err(sts)) {
+    LOG_ERROR("cert_inputs_test: %r", sts);
+  }
+  return status_ok(sts);
+}
@@ -0,0 +1,296 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/aes.h"
+#include "sw/device/lib/crypto/include/aes_gcm.h"
+#include "sw/device/lib/crypto/include/config.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/drbg.h"
+#include "sw/device/lib/crypto/include/integrity.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/tests/crypto/lib/crypto_benchmark.h"
+
+// Benchmarks the AES block cipher modes, AES-GCM and the (AES-based) CTR_DRBG
+// entry points of the cryptolib across message and key sizes. Results are
+// printed as `CRYPTO_BENCH` lines; see `crypto_benchmark.h`.
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  kMaxMsgBytes = 1024,
+  kMaxKeyBytes = 256 / 8,
+  kMaxKeyWords = kMaxKeyBytes / sizeof(uint32_t),
+  kAesIvWords = 128 / 32,
+  kGcmIvWords = 96 / 32,
+  kGcmTagWords = 128 / 32,
+  kMaxDrbgBytes = 256,
+  kMaxDrbgWords = kMaxDrbgBytes / sizeof(uint32_t),
+  kIterations = 4,
+};
+
+static const size_t kKeySizes[] = {128 / 8, 256 / 8};
+static const size_t kAesMsgSizes[] = {16, 256, kMaxMsgBytes};
+static const size_t kGcmMsgSizes[] = {0, 16, 256, kMaxMsgBytes};
+static const size_t kDrbgOutputSizes[] = {16, 64, kMaxDrbgBytes};
+
+static uint8_t input_buf[kMaxMsgBytes];
+static uint8_t output_buf[kMaxMsgBytes];
+static uint32_t key_data[kMaxKeyWords];
+
+static const uint32_t kKeyMask[kMaxKeyWords] = {
+    0x1b81ef19, 0x3a31f6df, 0x62b3a7e4, 0x8c0e2ef6,
+    0xb0eb0c0a, 0x9eb6a8f0, 0x5d5e1fb9, 0x4f2bd3ea,
+};
+
+typedef struct aes_mode_benchmark {
+  otcrypto_aes_mode_t mode;
+  otcrypto_key_mode_t key_mode;
+} aes_mode_benchmark_t;
+
+static const aes_mode_benchmark_t kAesModes[] = {
+    {kOtcryptoAesModeEcb, kOtcryptoKeyModeAesEcb},
+    {kOtcryptoAesModeCbc, kOtcryptoKeyModeAesCbc},
+    {kOtcryptoAesModeCfb, kOtcryptoKeyModeAesCfb},
+    {kOtcryptoAesModeOfb, kOtcryptoKeyModeAesOfb},
+    {kOtcryptoAesModeCtr, kOtcryptoKeyModeAesCtr},
+};
+
+// Variant names, indexed by key size and then by mode (and, for
+// `otcrypto_aes`, operation). They are spelled out because the device-side
+// printer cannot build them at runtime.
+static const char *const kAesVariants[][ARRAYSIZE(kAesModes)][2] = {
+    {
+        {"aes128-ecb-enc", "aes128-ecb-dec"},
+        {"aes128-cbc-enc", "aes128-cbc-dec"},
+        {"aes128-cfb-enc", "aes128-cfb-dec"},
+        {"aes128-ofb-enc", "aes128-ofb-dec"},
+        {"aes128-ctr-enc", "aes128-ctr-dec"},
+    },
+    {
+        {"aes256-ecb-enc", "aes256-ecb-dec"},
+        {"aes256-cbc-enc", "aes256-cbc-dec"},
+        {"aes256-cfb-enc", "aes256-cfb-dec"},
+        {"aes256-ofb-enc", "aes256-ofb-dec"},
+        {"aes256-ctr-enc", "aes256-ctr-dec"},
+    },
+};
+static const char *const kGcmVariants[] = {"aes128", "aes256"};
+
+/**
+ * Fills the keyblob of a blinded key from `key_data`.
+ *
+ * @param key Blinded key with its configuration and keyblob set up.
+ * @return OK or error.
+ */
+static status_t blind_key(otcrypto_blinded_key_t *key) {
+  TRY(keyblob_from_key_and_mask(key_data, kKeyMask, key->config,
+                                key->keyblob));
+  key->checksum = otcrypto_integrity_blinded_checksum(key);
+  return OK_STATUS();
+}
+
+typedef struct aes_ctx {
+  otcrypto_blinded_key_t *key;
+  otcrypto_aes_mode_t mode;
+  otcrypto_aes_operation_t operation;
+  size_t len;
+} aes_ctx_t;
+
+static status_t aes_run(void *ctx) {
+  aes_ctx_t *aes_ctx = ctx;
+  uint32_t iv_data[kAesIvWords] = {0};
+  otcrypto_word32_buf_t iv =
+      OTCRYPTO_MAKE_BUF(otcrypto_word32_buf_t, iv_data, ARRAYSIZE(iv_data));
+  otcrypto_const_byte_buf_t input =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, input_buf, aes_ctx->len);
+  otcrypto_byte_buf_t output =
+      OTCRYPTO_MAKE_BUF(otcrypto_byte_buf_t, output_buf, aes_ctx->len);
+  return otcrypto_aes(aes_ctx->key, &iv, aes_ctx->mode, aes_ctx->operation,
+                      &input, kOtcryptoAesPaddingNull, &output);
+}
+
+static status_t aes_benchmarks(void) {
+  for (size_t k = 0; k < ARRAYSIZE(kKeySizes); ++k) {
+    for (size_t m = 0; m < ARRAYSIZE(kAesModes); ++m) {
+      otcrypto_key_config_t config = {
+          .version = kOtcryptoLibVersion1,
+          .key_mode = kAesModes[m].key_mode,
+          .key_length = kKeySizes[k],
+          .hw_backed = kHardenedBoolFalse,
+          .exportable = kHardenedBoolFalse,
+          .security_level = kOtcryptoKeySecurityLevelLow,
+      };
+      uint32_t keyblob[keyblob_num_words(config)];
+      otcrypto_blinded_key_t key = {
+          .config = config,
+          .keyblob_length = sizeof(keyblob),
+          .keyblob = keyblob,
+      };
+      TRY(blind_key(&key));
+
+      for (size_t op = 0; op < 2; ++op) {
+        for (size_t i = 0; i < ARRAYSIZE(kAesMsgSizes); ++i) {
+          aes_ctx_t ctx = {
+              .key = &key,
+              .mode = kAesModes[m].mode,
+              .operation = op == 0 ? kOtcryptoAesOperationEncrypt
+                                   : kOtcryptoAesOperationDecrypt,
+              .len = kAesMsgSizes[i],
+          };
+          crypto_benchmark_t bench = {
+              .op = "otcrypto_aes",
+              .variant = kAesVariants[k][m][op],
+              .bytes = kAesMsgSizes[i],
+              .iterations = kIterations,
+              .fn = aes_run,
+              .ctx = &ctx,
+          };
+          TRY(crypto_benchmark_run(&bench));
+        }
+      }
+    }
+  }
+  return OK_STATUS();
+}
+
+typedef struct gcm_ctx {
+  otcrypto_blinded_key_t *key;
+  size_t len;
+  uint32_t tag[kGcmTagWords];
+} gcm_ctx_t;
+
+static const uint32_t kGcmIv[kGcmIvWords] = {0xcafebabe, 0xfaceb00c,
+                                             0xdecaf888};
+static const uint8_t kGcmAad[] = "crypto benchmark";
+
+static status_t gcm_encrypt_run(void *ctx) {
+  gcm_ctx_t *gcm_ctx = ctx;
+  otcrypto_const_byte_buf_t plaintext =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, input_buf, gcm_ctx->len);
+  otcrypto_const_word32_buf_t iv = OTCRYPTO_MAKE_BUF(
+      otcrypto_const_word32_buf_t, kGcmIv, ARRAYSIZE(kGcmIv));
+  otcrypto_const_byte_buf_t aad = OTCRYPTO_MAKE_BUF(
+      otcrypto_const_byte_buf_t, kGcmAad, sizeof(kGcmAad) - 1);
+  otcrypto_byte_buf_t ciphertext =
+      OTCRYPTO_MAKE_BUF(otcrypto_byte_buf_t, output_buf, gcm_ctx->len);
+  otcrypto_word32_buf_t tag = OTCRYPTO_MAKE_BUF(
+      otcrypto_word32_buf_t, gcm_ctx->tag, ARRAYSIZE(gcm_ctx->tag));
+  return otcrypto_aes_gcm_encrypt(gcm_ctx->key, &plaintext, &iv, &aad,
+                                  kOtcryptoAesGcmTagLen128, &ciphertext, &tag);
+}
+
+static status_t gcm_decrypt_run(void *ctx) {
+  gcm_ctx_t *gcm_ctx = ctx;
+  otcrypto_const_byte_buf_t ciphertext =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, output_buf, gcm_ctx->len);
+  otcrypto_const_word32_buf_t iv = OTCRYPTO_MAKE_BUF(
+      otcrypto_const_word32_buf_t, kGcmIv, ARRAYSIZE(kGcmIv));
+  otcrypto_const_byte_buf_t aad = OTCRYPTO_MAKE_BUF(
+      otcrypto_const_byte_buf_t, kGcmAad, sizeof(kGcmAad) - 1);
+  otcrypto_const_word32_buf_t tag = OTCRYPTO_MAKE_BUF(
+      otcrypto_const_word32_buf_t, gcm_ctx->tag, ARRAYSIZE(gcm_ctx->tag));
+  // Decrypt into the input buffer, which restores the plaintext.
+  otcrypto_byte_buf_t plaintext =
+      OTCRYPTO_MAKE_BUF(otcrypto_byte_buf_t, input_buf, gcm_ctx->len);
+  hardened_bool_t success;
+  TRY(otcrypto_aes_gcm_decrypt(gcm_ctx->key, &ciphertext, &iv, &aad,
+                               kOtcryptoAesGcmTagLen128, &tag, &plaintext,
+                               &success));
+  TRY_CHECK(success == kHardenedBoolTrue);
+  return OK_STATUS();
+}
+
+static status_t gcm_benchmarks(void) {
+  for (size_t k = 0; k < ARRAYSIZE(kKeySizes); ++k) {
+    otcrypto_key_config_t config = {
+        .version = kOtcryptoLibVersion1,
+        .key_mode = kOtcryptoKeyModeAesGcm,
+        .key_length = kKeySizes[k],
+        .hw_backed = kHardenedBoolFalse,
+        .exportable = kHardenedBoolFalse,
+        .security_level = kOtcryptoKeySecurityLevelLow,
+    };
+    uint32_t keyblob[keyblob_num_words(config)];
+    otcrypto_blinded_key_t key = {
+        .config = config,
+        .keyblob_length = sizeof(keyblob),
+        .keyblob = keyblob,
+    };
+    TRY(blind_key(&key));
+
+    for (size_t i = 0; i < ARRAYSIZE(kGcmMsgSizes); ++i) {
+      gcm_ctx_t ctx = {
+          .key = &key,
+          .len = kGcmMsgSizes[i],
+      };
+      crypto_benchmark_t bench = {
+          .op = "otcrypto_aes_gcm_encrypt",
+          .variant = kGcmVariants[k],
+          .bytes = kGcmMsgSizes[i],
+          .iterations = kIterations,
+          .fn = gcm_encrypt_run,
+          .ctx = &ctx,
+      };
+      TRY(crypto_benchmark_run(&bench));
+
+      // Decrypt the ciphertext and tag left behind by the last encryption.
+      bench.op = "otcrypto_aes_gcm_decrypt";
+      bench.fn = gcm_decrypt_run;
+      TRY(crypto_benchmark_run(&bench));
+    }
+  }
+  return OK_STATUS();
+}
+
+typedef struct drbg_ctx {
+  size_t words;
+} drbg_ctx_t;
+
+static status_t drbg_generate_run(void *ctx) {
+  drbg_ctx_t *drbg_ctx = ctx;
+  uint32_t output_data[kMaxDrbgWords];
+  otcrypto_const_byte_buf_t additional_input =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, NULL, 0);
+  otcrypto_word32_buf_t output =
+      OTCRYPTO_MAKE_BUF(otcrypto_word32_buf_t, output_data, drbg_ctx->words);
+  return otcrypto_drbg_generate(&additional_input, &output);
+}
+
+static status_t drbg_benchmarks(void) {
+  otcrypto_const_byte_buf_t perso_string =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, NULL, 0);
+  TRY(otcrypto_drbg_instantiate(&perso_string));
+
+  for (size_t i = 0; i < ARRAYSIZE(kDrbgOutputSizes); ++i) {
+    drbg_ctx_t ctx = {
+        .words = kDrbgOutputSizes[i] / sizeof(uint32_t),
+    };
+    crypto_benchmark_t bench = {
+        .op = "otcrypto_drbg_generate",
+        .variant = "",
+        .bytes = kDrbgOutputSizes[i],
+        .iterations = kIterations,
+        .fn = drbg_generate_run,
+        .ctx = &ctx,
+    };
+    TRY(crypto_benchmark_run(&bench));
+  }
+  return otcrypto_drbg_uninstantiate();
+}
+
+bool test_main(void) {
+  CHECK_STATUS_OK(otcrypto_init(kOtcryptoKeySecurityLevelLow));
+  crypto_benchmark_fill(input_buf, sizeof(input_buf));
+  crypto_benchmark_fill((uint8_t *)key_data, sizeof(key_data));
+
+  status_t result = OK_STATUS();
+  EXECUTE_TEST(result, aes_benchmarks);
+  EXECUTE_TEST(result, gcm_benchmarks);
+  EXECUTE_TEST(result, drbg_benchmarks);
+  return status_ok(result);
+}
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/rv_core_ibex.h"
 #include "sw/device/lib/crypto/impl/aes_gcm/aes_gcm.h"
 #include "sw/device/lib/crypto/include/config.h"
@@ -18,6 +19,40 @@
 // Global pointer to the current test vector.
 static aes_gcm_test_t *current_test = NULL;
 
+enum {
+  /**
+   * Largest message length for the throughput benchmark, in bytes.
+   */
+  kThroughputMaxLen = 4096,
+  /**
+   * Chunk size for the streaming check; deliberately not block-aligned.
+   */
+  kThroughputChunkLen = 23,
+  /**
+   * Tag length for the throughput benchmark, in words.
+   */
+  kThroughputTagWords = 4,
+  /**
+   * Number of blocks in the counter-wrap check.
+   */
+  kWrapNumBlocks = 4,
+  /**
+   * Starting counter word for the counter-wrap check; two blocks before the
+   * 32-bit counter wraps.
+   */
+  kWrapStartCounter = UINT32_MAX - 1,
+};
+
+// Message sizes for the throughput benchmark, in bytes.
+static const size_t kThroughputLens[] = {16, 64, 256, 1024, kThroughputMaxLen};
+
+// Buffers for the throughput benchmark.
+static uint8_t plaintext[kThroughputMaxLen];
+static uint8_t ciphertext[kThroughputMaxLen];
+static uint8_t ciphertext_ref[kThroughputMaxLen];
+static uint8_t ciphertext_stream[kThroughputMaxLen];
+static uint8_t decrypted[kThroughputMaxLen];
+
 /**
  * Checks that decryption takes the same number of cycles regardless of tag.
  *
@@ -99,6 +134,281 @@ static status_t test_decrypt_timing(void) {
   return OK_STATUS();
 }
 
+/**
+ * Measures AES-GCM encryption cycle counts across message sizes.
+ *
+ * The low security level overlaps the AES block with the software GHASH; the
+ * medium security level processes and verifies one block at a time. Both are
+ * timed, and their outputs must match each other and a streaming encryption
+ * fed in unaligned chunks.
+ */
+static status_t test_encrypt_throughput(void) {
+  uint32_t dummy_share[8] = {0};
+  aes_key_t aes_key = {
+      .mode = kAesCipherModeCtr,
+      .key_len = current_test->key_len,
+      .key_shares = {(uint32_t *)current_test->key, dummy_share},
+      .sideload = kHardenedBoolFalse,
+  };
+  aes_key.checksum = aes_key_integrity_checksum(&aes_key);
+
+  otcrypto_const_word32_buf_t iv_buf = otcrypto_make_const_word32_buf(
+      (const uint32_t *)current_test->iv,
+      current_test->iv_len / sizeof(uint32_t));
+  otcrypto_const_byte_buf_t aad_buf = otcrypto_make_const_byte_buf(NULL, 0);
+
+  for (size_t i = 0; i < sizeof(plaintext); i++) {
+    plaintext[i] = (uint8_t)(i * 31 + 7);
+  }
+
+  for (size_t i = 0; i < ARRAYSIZE(kThroughputLens); i++) {
+    size_t len = kThroughputLens[i];
+    otcrypto_const_byte_buf_t plaintext_buf =
+        otcrypto_make_const_byte_buf(plaintext, len);
+
+    // Low security level (pipelined).
+    uint32_t tag[kThroughputTagWords];
+    otcrypto_word32_buf_t tag_buf =
+        otcrypto_make_word32_buf(tag, ARRAYSIZE(tag));
+    otcrypto_byte_buf_t ciphertext_buf =
+        otcrypto_make_byte_buf(ciphertext, len);
+    uint64_t t_start = profile_start();
+    TRY(aes_gcm_encrypt(aes_key, &iv_buf, &plaintext_buf, &aad_buf, &tag_buf,
+                        kOtcryptoKeySecurityLevelLow, &ciphertext_buf));
+    uint32_t cycles_low = profile_end(t_start);
+
+    // Medium security level (one block at a time).
+    uint32_t tag_ref[kThroughputTagWords];
+    otcrypto_word32_buf_t tag_ref_buf =
+        otcrypto_make_word32_buf(tag_ref, ARRAYSIZE(tag_ref));
+    otcrypto_byte_buf_t ciphertext_ref_buf =
+        otcrypto_make_byte_buf(ciphertext_ref, len);
+    t_start = profile_start();
+    TRY(aes_gcm_encrypt(aes_key, &iv_buf, &plaintext_buf, &aad_buf,
+                        &tag_ref_buf, kOtcryptoKeySecurityLevelMedium,
+                        &ciphertext_ref_buf));
+    uint32_t cycles_medium = profile_end(t_start);
+
+    LOG_INFO("%d bytes: %d cycles (low), %d cycles (medium)", len, cycles_low,
+             cycles_medium);
+    TRY_CHECK(memcmp(ciphertext, ciphertext_ref, len) == 0,
+              "Ciphertext mismatch at %d bytes", len);
+    TRY_CHECK(memcmp(tag, tag_ref, sizeof(tag)) == 0,
+              "Tag mismatch at %d bytes", len);
+
+    // Streaming encryption in unaligned chunks at the low security level, so
+    // that the pipeline starts and stops mid-block.
+    aes_gcm_context_t ctx;
+    ctx.security_level = kOtcryptoKeySecurityLevelLow;
+    TRY(aes_gcm_encrypt_init(aes_key, &iv_buf, &ctx));
+    size_t offset = 0;
+    size_t written = 0;
+    while (offset < len) {
+      size_t chunk_len = len - offset;
+      if (chunk_len > kThroughputChunkLen) {
+        chunk_len = kThroughputChunkLen;
+      }
+      otcrypto_const_byte_buf_t chunk_buf =
+          otcrypto_make_const_byte_buf(plaintext + offset, chunk_len);
+      otcrypto_byte_buf_t out_buf = otcrypto_make_byte_buf(
+          ciphertext_stream + written, sizeof(ciphertext_stream) - written);
+      size_t chunk_written;
+      TRY(aes_gcm_update_encrypted_data(&ctx, &chunk_buf, &out_buf,
+                                        &chunk_written));
+      offset += chunk_len;
+      written += chunk_written;
+    }
+    uint32_t tag_stream[kThroughputTagWords];
+    otcrypto_word32_buf_t tag_stream_buf =
+        otcrypto_make_word32_buf(tag_stream, ARRAYSIZE(tag_stream));
+    otcrypto_byte_buf_t out_buf = otcrypto_make_byte_buf(
+        ciphertext_stream + written, sizeof(ciphertext_stream) - written);
+    size_t final_written;
+    TRY(aes_gcm_encrypt_final(&ctx, &tag_stream_buf, &out_buf,
+                              &final_written));
+    TRY_CHECK(written + final_written == len);
+    TRY_CHECK(memcmp(ciphertext_stream, ciphertext_ref, len) == 0,
+              "Streaming ciphertext mismatch at %d bytes", len);
+    TRY_CHECK(memcmp(tag_stream, tag_ref, sizeof(tag_stream)) == 0,
+              "Streaming tag mismatch at %d bytes", len);
+  }
+
+  return OK_STATUS();
+}
+
+/**
+ * Builds the AES-CTR key for the current test vector.
+ */
+static aes_key_t current_key(uint32_t *dummy_share) {
+  aes_key_t aes_key = {
+      .mode = kAesCipherModeCtr,
+      .key_len = current_test->key_len,
+      .key_shares = {(uint32_t *)current_test->key, dummy_share},
+      .sideload = kHardenedBoolFalse,
+  };
+  aes_key.checksum = aes_key_integrity_checksum(&aes_key);
+  return aes_key;
+}
+
+/**
+ * Checks that low-security decryption inverts low-security encryption.
+ *
+ * Decryption at the low security level uses the pipelined path, which saves
+ * the ciphertext block before the input buffer is reused. A corrupted tag
+ * must still be rejected.
+ */
+static status_t test_decrypt_roundtrip(void) {
+  uint32_t dummy_share[8] = {0};
+  aes_key_t aes_key = current_key(dummy_share);
+
+  otcrypto_const_word32_buf_t iv_buf = otcrypto_make_const_word32_buf(
+      (const uint32_t *)current_test->iv,
+      current_test->iv_len / sizeof(uint32_t));
+  otcrypto_const_byte_buf_t aad_buf = otcrypto_make_const_byte_buf(NULL, 0);
+
+  for (size_t i = 0; i < sizeof(plaintext); i++) {
+    plaintext[i] = (uint8_t)(i * 31 + 7);
+  }
+
+  for (size_t i = 0; i < ARRAYSIZE(kThroughputLens); i++) {
+    size_t len = kThroughputLens[i];
+    otcrypto_const_byte_buf_t plaintext_buf =
+        otcrypto_make_const_byte_buf(plaintext, len);
+    uint32_t tag[kThroughputTagWords];
+    otcrypto_word32_buf_t tag_buf =
+        otcrypto_make_word32_buf(tag, ARRAYSIZE(tag));
+    otcrypto_byte_buf_t ciphertext_buf =
+        otcrypto_make_byte_buf(ciphertext, len);
+    TRY(aes_gcm_encrypt(aes_key, &iv_buf, &plaintext_buf, &aad_buf, &tag_buf,
+                        kOtcryptoKeySecurityLevelLow, &ciphertext_buf));
+
+    otcrypto_const_byte_buf_t ciphertext_in =
+        otcrypto_make_const_byte_buf(ciphertext, len);
+    otcrypto_const_word32_buf_t tag_in =
+        otcrypto_make_const_word32_buf(tag, ARRAYSIZE(tag));
+    otcrypto_byte_buf_t decrypted_buf = otcrypto_make_byte_buf(decrypted, len);
+    hardened_bool_t valid;
+    uint64_t t_start = profile_start();
+    TRY(aes_gcm_decrypt(aes_key, &iv_buf, &ciphertext_in, &aad_buf, &tag_in,
+                        &decrypted_buf, kOtcryptoKeySecurityLevelLow, &valid));
+    uint32_t cycles = profile_end(t_start);
+    LOG_INFO("%d bytes: %d cycles (low, decrypt)", len, cycles);
+    TRY_CHECK(valid == kHardenedBoolTrue, "Tag rejected at %d bytes", len);
+    TRY_CHECK(memcmp(decrypted, plaintext, len) == 0,
+              "Plaintext mismatch at %d bytes", len);
+
+    tag[0] ^= 1;
+    TRY(aes_gcm_decrypt(aes_key, &iv_buf, &ciphertext_in, &aad_buf, &tag_in,
+                        &decrypted_buf, kOtcryptoKeySecurityLevelLow, &valid));
+    TRY_CHECK(valid == kHardenedBoolFalse, "Bad tag accepted at %d bytes",
+              len);
+  }
+
+  return OK_STATUS();
+}
+
+/**
+ * Runs a streaming operation whose counter word starts at `counter`.
+ *
+ * The counter block is overwritten after initialization so that the data
+ * crosses the 32-bit counter wrap without needing 2^32 blocks of input.
+ * Checks that only the last word of the counter block advanced.
+ *
+ * @param aes_key Key to use.
+ * @param security_level Security level of the operation.
+ * @param is_encrypt Whether to encrypt or decrypt.
+ * @param counter Starting value of the counter word.
+ * @param input Input data (`kWrapNumBlocks` blocks).
+ * @param[out] output Output data (`kWrapNumBlocks` blocks).
+ * @param[in,out] tag Tag; written for encryption, checked for decryption.
+ */
+static status_t run_from_counter(aes_key_t aes_key,
+                                 otcrypto_key_security_level_t security_level,
+                                 bool is_encrypt, uint32_t counter,
+                                 const uint8_t *input, uint8_t *output,
+                                 uint32_t *tag) {
+  otcrypto_const_word32_buf_t iv_buf = otcrypto_make_const_word32_buf(
+      (const uint32_t *)current_test->iv,
+      current_test->iv_len / sizeof(uint32_t));
+
+  aes_gcm_context_t ctx;
+  ctx.security_level = security_level;
+  if (is_encrypt) {
+    TRY(aes_gcm_encrypt_init(aes_key, &iv_buf, &ctx));
+  } else {
+    TRY(aes_gcm_decrypt_init(aes_key, &iv_buf, &ctx));
+  }
+  aes_block_t counter_block = ctx.gctr_iv;
+  ctx.gctr_iv.data[kAesBlockNumWords - 1] = __builtin_bswap32(counter);
+
+  size_t len = kWrapNumBlocks * kAesBlockNumBytes;
+  otcrypto_const_byte_buf_t input_buf =
+      otcrypto_make_const_byte_buf(input, len);
+  otcrypto_byte_buf_t output_buf = otcrypto_make_byte_buf(output, len);
+  size_t written;
+  TRY(aes_gcm_update_encrypted_data(&ctx, &input_buf, &output_buf, &written));
+  TRY_CHECK(written == len);
+
+  // inc32 leaves the first 96 bits of the counter block alone.
+  TRY_CHECK_ARRAYS_EQ(ctx.gctr_iv.data, counter_block.data,
+                      kAesBlockNumWords - 1);
+  TRY_CHECK(__builtin_bswap32(ctx.gctr_iv.data[kAesBlockNumWords - 1]) ==
+            counter + kWrapNumBlocks);
+
+  otcrypto_byte_buf_t final_buf = otcrypto_make_byte_buf(NULL, 0);
+  if (is_encrypt) {
+    otcrypto_word32_buf_t tag_buf =
+        otcrypto_make_word32_buf(tag, kThroughputTagWords);
+    TRY(aes_gcm_encrypt_final(&ctx, &tag_buf, &final_buf, &written));
+  } else {
+    otcrypto_const_word32_buf_t tag_buf =
+        otcrypto_make_const_word32_buf(tag, kThroughputTagWords);
+    hardened_bool_t valid;
+    TRY(aes_gcm_decrypt_final(&ctx, &tag_buf, &final_buf, &written, &valid));
+    TRY_CHECK(valid == kHardenedBoolTrue);
+  }
+  TRY_CHECK(written == 0);
+  return OK_STATUS();
+}
+
+/**
+ * Checks the pipelined path where the 32-bit counter word wraps mid-message.
+ *
+ * The hardware CTR mode increments all 128 bits of the counter, so the
+ * pipelined path splits its run at the wrap. The medium security level
+ * increments the counter in software one block at a time and serves as the
+ * reference.
+ */
+static status_t test_counter_wrap(void) {
+  uint32_t dummy_share[8] = {0};
+  aes_key_t aes_key = current_key(dummy_share);
+
+  for (size_t i = 0; i < kWrapNumBlocks * kAesBlockNumBytes; i++) {
+    plaintext[i] = (uint8_t)(i * 31 + 7);
+  }
+  size_t len = kWrapNumBlocks * kAesBlockNumBytes;
+
+  uint32_t tag[kThroughputTagWords];
+  TRY(run_from_counter(aes_key, kOtcryptoKeySecurityLevelLow,
+                       /*is_encrypt=*/true, kWrapStartCounter, plaintext,
+                       ciphertext, tag));
+  uint32_t tag_ref[kThroughputTagWords];
+  TRY(run_from_counter(aes_key, kOtcryptoKeySecurityLevelMedium,
+                       /*is_encrypt=*/true, kWrapStartCounter, plaintext,
+                       ciphertext_ref, tag_ref));
+  TRY_CHECK(memcmp(ciphertext, ciphertext_ref, len) == 0,
+            "Ciphertext mismatch across the counter wrap");
+  TRY_CHECK(memcmp(tag, tag_ref, sizeof(tag)) == 0,
+            "Tag mismatch across the counter wrap");
+
+  TRY(run_from_counter(aes_key, kOtcryptoKeySecurityLevelLow,
+                       /*is_encrypt=*/false, kWrapStartCounter, ciphertext,
+                       decrypted, tag));
+  TRY_CHECK(memcmp(decrypted, plaintext, len) == 0,
+            "Plaintext mismatch across the counter wrap");
+  return OK_STATUS();
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 bool test_main(void) {
   status_t result = OK_STATUS();
@@ -114,5 +424,10 @@ bool test_main(void) {
     EXECUTE_TEST(result, test_decrypt_timing);
   }
 
+  current_test = &kAesGcmTestvectors[0];
+  EXECUTE_TEST(result, test_encrypt_throughput);
+  EXECUTE_TEST(result, test_decrypt_roundtrip);
+  EXECUTE_TEST(result, test_counter_wrap);
+
   return status_ok(result);
 }
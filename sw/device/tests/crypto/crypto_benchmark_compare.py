@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+'''
+Compare two runs of the cryptolib benchmarks and fail on regressions.
+
+Each input is either a console log of one or more benchmark binaries (e.g. the
+test log of `bazel test //sw/device/tests/crypto:hash_benchmark_sim_verilator`)
+or a JSON file previously written with `--save`. Results are matched by
+operation, variant and message size; a result whose cycle count grew by more
+than the threshold is a regression.
+
+Example:
+    crypto_benchmark_compare.py --threshold 2 baseline.log current.log
+'''
+
+import argparse
+import json
+import re
+import sys
+
+# Must match `CRYPTO_BENCHMARK_TAG` in lib/crypto_benchmark.h.
+BENCH_RE = re.compile(r'CRYPTO_BENCH (\{.*\})')
+
+METRICS = ['mean', 'min', 'max']
+
+
+def result_key(result):
+    '''Key that identifies the same benchmark across runs.'''
+    return (result['op'], result['variant'], result['bytes'])
+
+
+def format_key(key):
+    op, variant, size = key
+    name = op if not variant else f'{op}[{variant}]'
+    return f'{name} {size}B'
+
+
+def load_results(path):
+    '''Load benchmark results from a console log or a saved JSON file.'''
+    with open(path) as f:
+        text = f.read()
+    if path.endswith('.json'):
+        results = json.loads(text)
+    else:
+        results = [json.loads(m.group(1)) for m in BENCH_RE.finditer(text)]
+    if not results:
+        raise ValueError(f'{path}: no benchmark results found')
+
+    by_key = {}
+    for result in results:
+        key = result_key(result)
+        if key in by_key:
+            raise ValueError(f'{path}: duplicate result for {format_key(key)}')
+        by_key[key] = result
+    return by_key
+
+
+def compare(baseline, current, metric, threshold):
+    '''Print a comparison table and return the list of regressed keys.'''
+    regressions = []
+    print(f'{"benchmark":<52} {"baseline":>10} {"current":>10} {"change":>8}')
+    for key in sorted(baseline.keys() | current.keys()):
+        if key not in current:
+            print(f'{format_key(key):<52} {"missing in current run":>30}')
+            continue
+        if key not in baseline:
+            print(f'{format_key(key):<52} {"new":>10} '
+                  f'{current[key][metric]:>10}')
+            continue
+        old = baseline[key][metric]
+        new = current[key][metric]
+        change = 0.0 if old == 0 else (new - old) * 100.0 / old
+        flag = ''
+        if change > threshold:
+            flag = '  REGRESSION'
+            regressions.append(key)
+        print(f'{format_key(key):<52} {old:>10} {new:>10} '
+              f'{change:>+7.2f}%{flag}')
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('baseline',
+                        help='console log or saved JSON of the baseline run')
+    parser.add_argument('current',
+                        help='console log or saved JSON of the current run')
+    parser.add_argument('--metric', choices=METRICS, default='mean',
+                        help='cycle count to compare (default: %(default)s)')
+    parser.add_argument('--threshold', type=float, default=1.0,
+                        help='allowed increase in percent before a result '
+                             'counts as a regression (default: %(default)s)')
+    parser.add_argument('--allow-missing', action='store_true',
+                        help='do not fail when a baseline result is missing '
+                             'from the current run')
+    parser.add_argument('--save', metavar='JSON',
+                        help='write the current results to this file, for use '
+                             'as a future baseline')
+    args = parser.parse_args()
+
+    try:
+        baseline = load_results(args.baseline)
+        current = load_results(args.current)
+    except (OSError, ValueError) as e:
+        print(f'error: {e}', file=sys.stderr)
+        return 2
+
+    if args.save:
+        with open(args.save, 'w') as f:
+            json.dump([current[k] for k in sorted(current)], f, indent=2)
+            f.write('\n')
+
+    regressions = compare(baseline, current, args.metric, args.threshold)
+    missing = baseline.keys() - current.keys()
+
+    failed = False
+    if regressions:
+        print(f'\n{len(regressions)} regression(s) above {args.threshold}% '
+              f'in {args.metric} cycles', file=sys.stderr)
+        failed = True
+    if missing and not args.allow_missing:
+        print(f'\n{len(missing)} result(s) missing from the current run',
+              file=sys.stderr)
+        failed = True
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
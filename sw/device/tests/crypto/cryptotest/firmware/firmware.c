@@ -73,6 +73,9 @@ status_t process_cmd(ujson_t *uj) {
       case kCryptotestCommandHash:
         RESP_ERR(uj, handle_hash(uj));
         break;
+      case kCryptotestCommandHashBatch:
+        RESP_ERR(uj, handle_hash_batch(uj));
+        break;
       case kCryptotestCommandHmac:
         RESP_ERR(uj, handle_hmac(uj));
         break;
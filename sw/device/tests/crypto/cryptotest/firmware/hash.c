@@ -13,28 +13,48 @@
 #include "sw/device/lib/ujson/ujson.h"
 #include "sw/device/tests/crypto/cryptotest/json/hash_commands.h"
 
-status_t handle_hash(ujson_t *uj) {
-  // Declare test arguments
-  cryptotest_hash_algorithm_t uj_algorithm;
-  cryptotest_hash_shake_digest_length_t uj_shake_digest_length;
-  cryptotest_hash_message_t uj_message;
-  // Deserialize test arguments from UART
-  TRY(ujson_deserialize_cryptotest_hash_algorithm_t(uj, &uj_algorithm));
-  TRY(ujson_deserialize_cryptotest_hash_shake_digest_length_t(
-      uj, &uj_shake_digest_length));
-  TRY(ujson_deserialize_cryptotest_hash_message_t(uj, &uj_message));
+static_assert(HASH_CMD_BATCH_BITMAP_WORDS * 32 >= HASH_CMD_MAX_BATCH_VECTORS,
+              "Batch pass bitmap must have one bit per vector");
+
+/**
+ * Hash a message with the oneshot API and, for SHA-2, the stepwise API.
+ *
+ * @param algorithm Hash algorithm.
+ * @param shake_digest_len Requested digest length in bytes (XOFs only).
+ * @param msg Message.
+ * @param msg_len Length of the message in bytes.
+ * @param customization_string cSHAKE customization string.
+ * @param customization_string_len Length of the customization string in
+ * bytes.
+ * @param[out] oneshot_digest Digest from the oneshot API.
+ * @param[out] stepwise_digest Digest from the stepwise API, if supported.
+ * @param[out] digest_len Length of the digests in bytes.
+ * @param[out] test_stepwise Whether `stepwise_digest` was computed.
+ * @return OK or error.
+ */
+static status_t hash_compute(cryptotest_hash_algorithm_t algorithm,
+                             size_t shake_digest_len, const uint8_t *msg,
+                             size_t msg_len,
+                             const uint8_t *customization_string,
+                             size_t customization_string_len,
+                             uint8_t *oneshot_digest, uint8_t *stepwise_digest,
+                             size_t *digest_len, bool *test_stepwise) {
+  if (msg_len > HASH_CMD_MAX_MESSAGE_BYTES ||
+      customization_string_len > HASH_CMD_MAX_CUSTOMIZATION_STRING_BYTES) {
+    return INVALID_ARGUMENT();
+  }
 
   // Create input message
-  uint8_t msg_buf[uj_message.message_len];
-  memcpy(msg_buf, uj_message.message, uj_message.message_len);
-  otcrypto_const_byte_buf_t input_message = OTCRYPTO_MAKE_BUF(
-      otcrypto_const_byte_buf_t, msg_buf, uj_message.message_len);
-  uint8_t customization_string_buf[uj_message.customization_string_len];
-  memcpy(customization_string_buf, uj_message.customization_string,
-         uj_message.customization_string_len);
-  otcrypto_const_byte_buf_t customization_string =
+  uint8_t msg_buf[msg_len];
+  memcpy(msg_buf, msg, msg_len);
+  otcrypto_const_byte_buf_t input_message =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, msg_buf, msg_len);
+  uint8_t customization_string_buf[customization_string_len];
+  memcpy(customization_string_buf, customization_string,
+         customization_string_len);
+  otcrypto_const_byte_buf_t customization_string_input =
       OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, customization_string_buf,
-                        uj_message.customization_string_len);
+                        customization_string_len);
   // If we are using cSHAKE, the empty function name tells cryptolib not to
   // apply any function on top of cSHAKE.
   otcrypto_const_byte_buf_t cshake_function_name =
@@ -45,88 +65,92 @@ status_t handle_hash(ujson_t *uj) {
                                     otcrypto_hash_digest_t *);
 
   // Digest length in 32-bit words
-  size_t digest_len;
-  uint8_t test_stepwise = false;
+  size_t digest_words;
+  *test_stepwise = false;
   otcrypto_hash_mode_t mode;
-  switch (uj_algorithm) {
+  switch (algorithm) {
     case kCryptotestHashAlgorithmSha256:
       mode = kOtcryptoHashModeSha256;
-      digest_len = 256 / 32;
+      digest_words = 256 / 32;
       hash_oneshot = otcrypto_sha2_256;
-      test_stepwise = true;
+      *test_stepwise = true;
       break;
     case kCryptotestHashAlgorithmSha384:
       mode = kOtcryptoHashModeSha384;
-      digest_len = 384 / 32;
+      digest_words = 384 / 32;
       hash_oneshot = otcrypto_sha2_384;
-      test_stepwise = true;
+      *test_stepwise = true;
       break;
     case kCryptotestHashAlgorithmSha512:
       mode = kOtcryptoHashModeSha512;
-      digest_len = 512 / 32;
+      digest_words = 512 / 32;
       hash_oneshot = otcrypto_sha2_512;
-      test_stepwise = true;
+      *test_stepwise = true;
       break;
     case kCryptotestHashAlgorithmSha3_224:
       mode = kOtcryptoHashModeSha3_224;
-      digest_len = 224 / 32;
+      digest_words = 224 / 32;
       hash_oneshot = otcrypto_sha3_224;
       break;
     case kCryptotestHashAlgorithmSha3_256:
       mode = kOtcryptoHashModeSha3_256;
-      digest_len = 256 / 32;
+      digest_words = 256 / 32;
       hash_oneshot = otcrypto_sha3_256;
       break;
     case kCryptotestHashAlgorithmSha3_384:
       mode = kOtcryptoHashModeSha3_384;
-      digest_len = 384 / 32;
+      digest_words = 384 / 32;
       hash_oneshot = otcrypto_sha3_384;
       break;
     case kCryptotestHashAlgorithmSha3_512:
       mode = kOtcryptoHashModeSha3_512;
-      digest_len = 512 / 32;
+      digest_words = 512 / 32;
       hash_oneshot = otcrypto_sha3_512;
       break;
     case kCryptotestHashAlgorithmShake128:
       mode = kOtcryptoHashXofModeShake128;
-      digest_len = ceil_div(uj_shake_digest_length.length, sizeof(uint32_t));
+      digest_words = ceil_div(shake_digest_len, sizeof(uint32_t));
       hash_oneshot = otcrypto_shake128;
       break;
     case kCryptotestHashAlgorithmShake256:
       mode = kOtcryptoHashXofModeShake256;
-      digest_len = ceil_div(uj_shake_digest_length.length, sizeof(uint32_t));
+      digest_words = ceil_div(shake_digest_len, sizeof(uint32_t));
       hash_oneshot = otcrypto_shake256;
       break;
     case kCryptotestHashAlgorithmCshake128:
       mode = kOtcryptoHashXofModeCshake128;
-      digest_len = ceil_div(uj_shake_digest_length.length, sizeof(uint32_t));
+      digest_words = ceil_div(shake_digest_len, sizeof(uint32_t));
       break;
     case kCryptotestHashAlgorithmCshake256:
       mode = kOtcryptoHashXofModeCshake256;
-      digest_len = ceil_div(uj_shake_digest_length.length, sizeof(uint32_t));
+      digest_words = ceil_div(shake_digest_len, sizeof(uint32_t));
       break;
     default:
-      LOG_ERROR("Unsupported hash algorithm: %d", uj_algorithm);
+      LOG_ERROR("Unsupported hash algorithm: %d", algorithm);
       return INVALID_ARGUMENT();
   }
+  if (digest_words * sizeof(uint32_t) > HASH_CMD_MAX_DIGEST_BYTES) {
+    return INVALID_ARGUMENT();
+  }
+  *digest_len = digest_words * sizeof(uint32_t);
 
   // Create digest skeleton
-  uint32_t digest_buf[digest_len];
-  memset(digest_buf, 0, digest_len * sizeof(uint32_t));
+  uint32_t digest_buf[digest_words];
+  memset(digest_buf, 0, digest_words * sizeof(uint32_t));
   otcrypto_hash_digest_t digest = {
       .data = digest_buf,
-      .len = digest_len,
+      .len = digest_words,
   };
   otcrypto_status_t status;
   // Test oneshot API
-  switch (uj_algorithm) {
+  switch (algorithm) {
     case kCryptotestHashAlgorithmCshake128:
       status = otcrypto_cshake128(&input_message, &cshake_function_name,
-                                  &customization_string, &digest);
+                                  &customization_string_input, &digest);
       break;
     case kCryptotestHashAlgorithmCshake256:
       status = otcrypto_cshake256(&input_message, &cshake_function_name,
-                                  &customization_string, &digest);
+                                  &customization_string_input, &digest);
       break;
     default:
       status = hash_oneshot(&input_message, &digest);
@@ -135,15 +159,12 @@ status_t handle_hash(ujson_t *uj) {
     LOG_ERROR("Bad status value: 0x%x", status.value);
     return INTERNAL(status.value);
   }
-  cryptotest_hash_output_t uj_output;
-  uj_output.digest_len = digest_len * sizeof(uint32_t);
-  // Copy oneshot digest to uJSON type
-  memcpy(uj_output.oneshot_digest, digest_buf, digest_len * sizeof(uint32_t));
+  memcpy(oneshot_digest, digest_buf, *digest_len);
   // Zero out digest_buf to mitigate chance of a false positive in the
   // stepwise test
-  memset(digest_buf, 0, digest_len * sizeof(uint32_t));
+  memset(digest_buf, 0, *digest_len);
   // Test the stepwise API for algorithms that support it
-  if (test_stepwise) {
+  if (*test_stepwise) {
     otcrypto_sha2_context_t ctx;
     status = otcrypto_sha2_init(mode, &ctx);
     if (status.value != kOtcryptoStatusValueOk) {
@@ -151,11 +172,11 @@ status_t handle_hash(ujson_t *uj) {
     }
     // Split up input mesasge into 2 shares for better coverage of stepwise
     // hashing
-    otcrypto_const_byte_buf_t input_message_share1 = OTCRYPTO_MAKE_BUF(
-        otcrypto_const_byte_buf_t, msg_buf, uj_message.message_len / 2);
-    otcrypto_const_byte_buf_t input_message_share2 = OTCRYPTO_MAKE_BUF(
-        otcrypto_const_byte_buf_t, &msg_buf[uj_message.message_len / 2],
-        ceil_div(uj_message.message_len, 2));
+    otcrypto_const_byte_buf_t input_message_share1 =
+        OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, msg_buf, msg_len / 2);
+    otcrypto_const_byte_buf_t input_message_share2 =
+        OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, &msg_buf[msg_len / 2],
+                          ceil_div(msg_len, 2));
     status = otcrypto_sha2_update(&ctx, &input_message_share1);
     if (status.value != kOtcryptoStatusValueOk) {
       return INTERNAL(status.value);
@@ -168,11 +189,92 @@ status_t handle_hash(ujson_t *uj) {
     if (status.value != kOtcryptoStatusValueOk) {
       return INTERNAL(status.value);
     }
-    // Copy stepwise result to uJSON type
-    memcpy(uj_output.stepwise_digest, digest_buf,
-           digest_len * sizeof(uint32_t));
+    memcpy(stepwise_digest, digest_buf, *digest_len);
   }
+  return OK_STATUS(0);
+}
+
+status_t handle_hash(ujson_t *uj) {
+  // Declare test arguments
+  cryptotest_hash_algorithm_t uj_algorithm;
+  cryptotest_hash_shake_digest_length_t uj_shake_digest_length;
+  cryptotest_hash_message_t uj_message;
+  // Deserialize test arguments from UART
+  TRY(ujson_deserialize_cryptotest_hash_algorithm_t(uj, &uj_algorithm));
+  TRY(ujson_deserialize_cryptotest_hash_shake_digest_length_t(
+      uj, &uj_shake_digest_length));
+  TRY(ujson_deserialize_cryptotest_hash_message_t(uj, &uj_message));
+
+  cryptotest_hash_output_t uj_output;
+  memset(&uj_output, 0, sizeof(uj_output));
+  bool test_stepwise;
+  TRY(hash_compute(uj_algorithm, uj_shake_digest_length.length,
+                   uj_message.message, uj_message.message_len,
+                   uj_message.customization_string,
+                   uj_message.customization_string_len,
+                   uj_output.oneshot_digest, uj_output.stepwise_digest,
+                   &uj_output.digest_len, &test_stepwise));
   // Send digest to host via UART
   RESP_OK(ujson_serialize_cryptotest_hash_output_t, uj, &uj_output);
   return OK_STATUS(0);
 }
+
+status_t handle_hash_batch(ujson_t *uj) {
+  cryptotest_hash_batch_t uj_batch;
+  TRY(ujson_deserialize_cryptotest_hash_batch_t(uj, &uj_batch));
+  if (uj_batch.count > HASH_CMD_MAX_BATCH_VECTORS) {
+    LOG_ERROR("Too many vectors in batch: %u", (uint32_t)uj_batch.count);
+    return INVALID_ARGUMENT();
+  }
+
+  cryptotest_hash_batch_output_t uj_output;
+  memset(&uj_output, 0, sizeof(uj_output));
+  uj_output.count = uj_batch.count;
+  for (size_t i = 0; i < uj_batch.count; ++i) {
+    // The host streams all vectors without waiting for a response, so each
+    // one is read, run and checked before the next is deserialized.
+    cryptotest_hash_batch_vector_t uj_vector;
+    TRY(ujson_deserialize_cryptotest_hash_batch_vector_t(uj, &uj_vector));
+
+    // A vector that cannot be hashed is reported in `errored` rather than
+    // returned as an error, so that the remaining vectors are still consumed.
+    uint8_t oneshot_digest[HASH_CMD_MAX_DIGEST_BYTES];
+    uint8_t stepwise_digest[HASH_CMD_MAX_DIGEST_BYTES];
+    size_t digest_len = 0;
+    bool test_stepwise = false;
+    status_t status = hash_compute(
+        uj_batch.algorithm, uj_vector.digest_len, uj_vector.message,
+        uj_vector.message_len, uj_vector.customization_string,
+        uj_vector.customization_string_len, oneshot_digest, stepwise_digest,
+        &digest_len, &test_stepwise);
+
+    // An error fails the vector even if a mismatch was expected: negative
+    // vectors must be rejected by the digest check, not by the hash failing.
+    bool passed = false;
+    if (status_ok(status)) {
+      // Some test cases only specify the beginning bytes of the expected
+      // digest, so only compare up to what the test specifies. A digest that
+      // is shorter than the expected one never matches.
+      bool match = uj_vector.digest_len <= digest_len &&
+                   memcmp(uj_vector.digest, oneshot_digest,
+                          uj_vector.digest_len) == 0;
+      if (test_stepwise) {
+        match = match && memcmp(uj_vector.digest, stepwise_digest,
+                                uj_vector.digest_len) == 0;
+      }
+      passed = match == uj_vector.result;
+    } else {
+      uj_output.errored[i / 32] |= 1u << (i % 32);
+    }
+    if (passed) {
+      uj_output.passed[i / 32] |= 1u << (i % 32);
+    } else {
+      if (uj_output.failure_count < HASH_CMD_MAX_BATCH_FAILURES) {
+        uj_output.failures[uj_output.failure_count] = (uint32_t)i;
+      }
+      uj_output.failure_count++;
+    }
+  }
+  RESP_OK(ujson_serialize_cryptotest_hash_batch_output_t, uj, &uj_output);
+  return OK_STATUS(0);
+}
@@ -10,4 +10,17 @@
 
 status_t handle_hash(ujson_t *uj);
 
+/**
+ * Run a batch of hash test vectors of the same algorithm.
+ *
+ * Reads a `cryptotest_hash_batch_t` header followed by `count`
+ * `cryptotest_hash_batch_vector_t` vectors, runs them back-to-back and replies
+ * once with a `cryptotest_hash_batch_output_t` holding a pass bitmap and the
+ * indices of the first failing vectors.
+ *
+ * @param uj An initialized uJSON context.
+ * @return OK or error.
+ */
+status_t handle_hash_batch(ujson_t *uj);
+
 #endif  // OPENTITAN_SW_DEVICE_TESTS_CRYPTO_CRYPTOTEST_FIRMWARE_HASH_H_
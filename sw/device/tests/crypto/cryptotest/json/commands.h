@@ -19,6 +19,7 @@ extern "C" {
     value(_, Ecdh) \
     value(_, Ed25519) \
     value(_, Hash) \
+    value(_, HashBatch) \
     value(_, Hmac) \
     value(_, Kmac) \
     value(_, Quit) \
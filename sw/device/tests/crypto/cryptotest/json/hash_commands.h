@@ -14,6 +14,10 @@ extern "C" {
 #define HASH_CMD_MAX_MESSAGE_BYTES 17068
 #define HASH_CMD_MAX_CUSTOMIZATION_STRING_BYTES 16
 #define HASH_CMD_MAX_DIGEST_BYTES 256
+#define HASH_CMD_MAX_BATCH_VECTORS 256
+// One bit per vector; a literal so that it is also a valid Rust const generic.
+#define HASH_CMD_BATCH_BITMAP_WORDS 8
+#define HASH_CMD_MAX_BATCH_FAILURES 32
 
 // clang-format off
 
@@ -48,6 +52,29 @@ UJSON_SERDE_STRUCT(CryptotestHashMessage, cryptotest_hash_message_t, HASH_MESSAG
     field(digest_len, size_t)
 UJSON_SERDE_STRUCT(CryptotestHashOutput, cryptotest_hash_output_t, HASH_OUTPUT);
 
+#define HASH_BATCH(field, string) \
+    field(algorithm, cryptotest_hash_algorithm_t) \
+    field(count, size_t)
+UJSON_SERDE_STRUCT(CryptotestHashBatch, cryptotest_hash_batch_t, HASH_BATCH);
+
+#define HASH_BATCH_VECTOR(field, string) \
+    field(message, uint8_t, HASH_CMD_MAX_MESSAGE_BYTES) \
+    field(message_len, size_t) \
+    field(customization_string, uint8_t, HASH_CMD_MAX_CUSTOMIZATION_STRING_BYTES) \
+    field(customization_string_len, size_t) \
+    field(digest, uint8_t, HASH_CMD_MAX_DIGEST_BYTES) \
+    field(digest_len, size_t) \
+    field(result, bool)
+UJSON_SERDE_STRUCT(CryptotestHashBatchVector, cryptotest_hash_batch_vector_t, HASH_BATCH_VECTOR);
+
+#define HASH_BATCH_OUTPUT(field, string) \
+    field(count, size_t) \
+    field(passed, uint32_t, HASH_CMD_BATCH_BITMAP_WORDS) \
+    field(errored, uint32_t, HASH_CMD_BATCH_BITMAP_WORDS) \
+    field(failure_count, size_t) \
+    field(failures, uint32_t, HASH_CMD_MAX_BATCH_FAILURES)
+UJSON_SERDE_STRUCT(CryptotestHashBatchOutput, cryptotest_hash_batch_output_t, HASH_BATCH_OUTPUT);
+
 #undef MODULE_ID
 
 // clang-format on
@@ -0,0 +1,307 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/config.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/ecc_p256.h"
+#include "sw/device/lib/crypto/include/ecc_p384.h"
+#include "sw/device/lib/crypto/include/integrity.h"
+#include "sw/device/lib/crypto/include/sha2.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/tests/crypto/lib/crypto_benchmark.h"
+
+// Benchmarks the ECDSA and ECDH entry points of the cryptolib. P-256 is always
+// measured; P-384 only when built with `ECC_BENCHMARK_P384`, since it takes
+// too long under Verilator to run in CI. Results are printed as
+// `CRYPTO_BENCH` lines; see `crypto_benchmark.h`.
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  /* Number of 32-bit words in the largest public key. */
+  kMaxPublicKeyWords = 768 / 32,
+  /* Number of 32-bit words in the largest signature. */
+  kMaxSignatureWords = 768 / 32,
+  /* Number of 32-bit words in the largest digest. */
+  kMaxDigestWords = 384 / 32,
+  /* Number of measured calls per operation. */
+  kIterations = 2,
+};
+
+static const char kMessage[] = "crypto benchmark message";
+
+typedef otcrypto_status_t (*keygen_fn_t)(otcrypto_blinded_key_t *private_key,
+                                         otcrypto_unblinded_key_t *public_key);
+typedef otcrypto_status_t (*sign_fn_t)(
+    const otcrypto_blinded_key_t *private_key,
+    const otcrypto_hash_digest_t message_digest,
+    otcrypto_word32_buf_t *signature);
+typedef otcrypto_status_t (*verify_fn_t)(
+    const otcrypto_unblinded_key_t *public_key,
+    const otcrypto_hash_digest_t message_digest,
+    const otcrypto_const_word32_buf_t *signature,
+    hardened_bool_t *verification_result);
+typedef otcrypto_status_t (*ecdh_fn_t)(
+    const otcrypto_blinded_key_t *private_key,
+    const otcrypto_unblinded_key_t *public_key,
+    otcrypto_blinded_key_t *shared_secret);
+typedef otcrypto_status_t (*hash_fn_t)(const otcrypto_const_byte_buf_t *msg,
+                                       otcrypto_hash_digest_t *digest);
+
+/**
+ * Parameters and entry points of one curve.
+ */
+typedef struct curve_benchmark {
+  const char *variant;
+  size_t private_key_bytes;
+  size_t public_key_words;
+  size_t signature_words;
+  size_t digest_words;
+  otcrypto_key_mode_t ecdsa_key_mode;
+  otcrypto_key_mode_t ecdh_key_mode;
+  hash_fn_t hash;
+  const char *ecdsa_keygen_op;
+  keygen_fn_t ecdsa_keygen;
+  const char *sign_op;
+  sign_fn_t sign;
+  const char *verify_op;
+  verify_fn_t verify;
+  const char *ecdh_keygen_op;
+  keygen_fn_t ecdh_keygen;
+  const char *ecdh_op;
+  ecdh_fn_t ecdh;
+} curve_benchmark_t;
+
+static const curve_benchmark_t kCurves[] = {
+    {
+        .variant = "p256",
+        .private_key_bytes = 256 / 8,
+        .public_key_words = 512 / 32,
+        .signature_words = 512 / 32,
+        .digest_words = 256 / 32,
+        .ecdsa_key_mode = kOtcryptoKeyModeEcdsaP256,
+        .ecdh_key_mode = kOtcryptoKeyModeEcdhP256,
+        .hash = otcrypto_sha2_256,
+        .ecdsa_keygen_op = "otcrypto_ecdsa_p256_keygen",
+        .ecdsa_keygen = otcrypto_ecdsa_p256_keygen,
+        .sign_op = "otcrypto_ecdsa_p256_sign",
+        .sign = otcrypto_ecdsa_p256_sign,
+        .verify_op = "otcrypto_ecdsa_p256_verify",
+        .verify = otcrypto_ecdsa_p256_verify,
+        .ecdh_keygen_op = "otcrypto_ecdh_p256_keygen",
+        .ecdh_keygen = otcrypto_ecdh_p256_keygen,
+        .ecdh_op = "otcrypto_ecdh_p256",
+        .ecdh = otcrypto_ecdh_p256,
+    },
+#ifdef ECC_BENCHMARK_P384
+    {
+        .variant = "p384",
+        .private_key_bytes = 384 / 8,
+        .public_key_words = 768 / 32,
+        .signature_words = 768 / 32,
+        .digest_words = 384 / 32,
+        .ecdsa_key_mode = kOtcryptoKeyModeEcdsaP384,
+        .ecdh_key_mode = kOtcryptoKeyModeEcdhP384,
+        .hash = otcrypto_sha2_384,
+        .ecdsa_keygen_op = "otcrypto_ecdsa_p384_keygen",
+        .ecdsa_keygen = otcrypto_ecdsa_p384_keygen,
+        .sign_op = "otcrypto_ecdsa_p384_sign",
+        .sign = otcrypto_ecdsa_p384_sign,
+        .verify_op = "otcrypto_ecdsa_p384_verify",
+        .verify = otcrypto_ecdsa_p384_verify,
+        .ecdh_keygen_op = "otcrypto_ecdh_p384_keygen",
+        .ecdh_keygen = otcrypto_ecdh_p384_keygen,
+        .ecdh_op = "otcrypto_ecdh_p384",
+        .ecdh = otcrypto_ecdh_p384,
+    },
+#endif
+};
+
+/**
+ * State shared by the benchmarks of one curve.
+ */
+typedef struct ecc_ctx {
+  const curve_benchmark_t *curve;
+  otcrypto_blinded_key_t *private_key;
+  otcrypto_unblinded_key_t *public_key;
+  otcrypto_unblinded_key_t *peer_public_key;
+  otcrypto_blinded_key_t *shared_secret;
+  otcrypto_hash_digest_t digest;
+  uint32_t signature[kMaxSignatureWords];
+} ecc_ctx_t;
+
+static status_t ecdsa_keygen_run(void *ctx) {
+  ecc_ctx_t *ecc = ctx;
+  return ecc->curve->ecdsa_keygen(ecc->private_key, ecc->public_key);
+}
+
+static status_t ecdh_keygen_run(void *ctx) {
+  ecc_ctx_t *ecc = ctx;
+  return ecc->curve->ecdh_keygen(ecc->private_key, ecc->public_key);
+}
+
+static status_t sign_run(void *ctx) {
+  ecc_ctx_t *ecc = ctx;
+  otcrypto_word32_buf_t signature = OTCRYPTO_MAKE_BUF(
+      otcrypto_word32_buf_t, ecc->signature, ecc->curve->signature_words);
+  return ecc->curve->sign(ecc->private_key, ecc->digest, &signature);
+}
+
+static status_t verify_run(void *ctx) {
+  ecc_ctx_t *ecc = ctx;
+  otcrypto_const_word32_buf_t signature = OTCRYPTO_MAKE_BUF(
+      otcrypto_const_word32_buf_t, ecc->signature, ecc->curve->signature_words);
+  hardened_bool_t result;
+  TRY(ecc->curve->verify(ecc->public_key, ecc->digest, &signature, &result));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  return OK_STATUS();
+}
+
+static status_t ecdh_run(void *ctx) {
+  ecc_ctx_t *ecc = ctx;
+  return ecc->curve->ecdh(ecc->private_key, ecc->peer_public_key,
+                          ecc->shared_secret);
+}
+
+/**
+ * Runs a fixed-size benchmark of one curve operation.
+ */
+static status_t run(const char *op, crypto_benchmark_fn_t fn, ecc_ctx_t *ctx) {
+  crypto_benchmark_t bench = {
+      .op = op,
+      .variant = ctx->curve->variant,
+      .bytes = 0,
+      .iterations = kIterations,
+      .fn = fn,
+      .ctx = ctx,
+  };
+  return crypto_benchmark_run(&bench);
+}
+
+static status_t ecdsa_benchmarks(const curve_benchmark_t *curve) {
+  otcrypto_key_config_t config = {
+      .version = kOtcryptoLibVersion1,
+      .key_mode = curve->ecdsa_key_mode,
+      .key_length = curve->private_key_bytes,
+      .hw_backed = kHardenedBoolFalse,
+      .exportable = kHardenedBoolFalse,
+      .security_level = kOtcryptoKeySecurityLevelLow,
+  };
+  uint32_t keyblob[keyblob_num_words(config)];
+  otcrypto_blinded_key_t private_key = {
+      .config = config,
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  uint32_t pk[kMaxPublicKeyWords];
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = curve->ecdsa_key_mode,
+      .key_length = curve->public_key_words * sizeof(uint32_t),
+      .key = pk,
+  };
+
+  uint32_t digest_data[kMaxDigestWords];
+  ecc_ctx_t ctx = {
+      .curve = curve,
+      .private_key = &private_key,
+      .public_key = &public_key,
+      .digest =
+          {
+              .data = digest_data,
+              .len = curve->digest_words,
+          },
+  };
+  otcrypto_const_byte_buf_t msg =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, (const uint8_t *)kMessage,
+                        sizeof(kMessage) - 1);
+  TRY(curve->hash(&msg, &ctx.digest));
+
+  // Each step leaves behind the inputs of the next: the key pair from the last
+  // keygen, and the signature from the last signing.
+  TRY(run(curve->ecdsa_keygen_op, ecdsa_keygen_run, &ctx));
+  TRY(run(curve->sign_op, sign_run, &ctx));
+  return run(curve->verify_op, verify_run, &ctx);
+}
+
+static status_t ecdh_benchmarks(const curve_benchmark_t *curve) {
+  otcrypto_key_config_t private_config = {
+      .version = kOtcryptoLibVersion1,
+      .key_mode = curve->ecdh_key_mode,
+      .key_length = curve->private_key_bytes,
+      .hw_backed = kHardenedBoolFalse,
+      .exportable = kHardenedBoolFalse,
+      .security_level = kOtcryptoKeySecurityLevelLow,
+  };
+  uint32_t keyblob[keyblob_num_words(private_config)];
+  otcrypto_blinded_key_t private_key = {
+      .config = private_config,
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  uint32_t peer_keyblob[keyblob_num_words(private_config)];
+  otcrypto_blinded_key_t peer_private_key = {
+      .config = private_config,
+      .keyblob_length = sizeof(peer_keyblob),
+      .keyblob = peer_keyblob,
+  };
+  uint32_t pk[kMaxPublicKeyWords];
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = curve->ecdh_key_mode,
+      .key_length = curve->public_key_words * sizeof(uint32_t),
+      .key = pk,
+  };
+  uint32_t peer_pk[kMaxPublicKeyWords];
+  otcrypto_unblinded_key_t peer_public_key = {
+      .key_mode = curve->ecdh_key_mode,
+      .key_length = curve->public_key_words * sizeof(uint32_t),
+      .key = peer_pk,
+  };
+
+  // The shared secret is used as an AES-CTR key, as in the ECDH functests.
+  otcrypto_key_config_t shared_config = {
+      .version = kOtcryptoLibVersion1,
+      .key_mode = kOtcryptoKeyModeAesCtr,
+      .key_length = curve->private_key_bytes,
+      .hw_backed = kHardenedBoolFalse,
+      .exportable = kHardenedBoolTrue,
+      .security_level = kOtcryptoKeySecurityLevelLow,
+  };
+  uint32_t shared_keyblob[keyblob_num_words(shared_config)];
+  otcrypto_blinded_key_t shared_secret = {
+      .config = shared_config,
+      .keyblob_length = sizeof(shared_keyblob),
+      .keyblob = shared_keyblob,
+  };
+
+  ecc_ctx_t ctx = {
+      .curve = curve,
+      .private_key = &private_key,
+      .public_key = &public_key,
+      .peer_public_key = &peer_public_key,
+      .shared_secret = &shared_secret,
+  };
+  TRY(curve->ecdh_keygen(&peer_private_key, &peer_public_key));
+  TRY(run(curve->ecdh_keygen_op, ecdh_keygen_run, &ctx));
+  return run(curve->ecdh_op, ecdh_run, &ctx);
+}
+
+static status_t ecc_benchmarks(void) {
+  for (size_t i = 0; i < ARRAYSIZE(kCurves); ++i) {
+    TRY(ecdsa_benchmarks(&kCurves[i]));
+    TRY(ecdh_benchmarks(&kCurves[i]));
+  }
+  return OK_STATUS();
+}
+
+bool test_main(void) {
+  CHECK_STATUS_OK(otcrypto_init(kOtcryptoKeySecurityLevelLow));
+
+  status_t result = OK_STATUS();
+  EXECUTE_TEST(result, ecc_benchmarks);
+  return status_ok(result);
+}
@@ -5,6 +5,7 @@
 #include "sw/device/lib/crypto/drivers/otbn.h"
 #include "sw/device/lib/crypto/impl/ecc/p256.h"
 #include "sw/device/lib/crypto/include/config.h"
+#include "sw/device/lib/crypto/include/ecc_p256.h"
 #include "sw/device/lib/crypto/include/entropy_src.h"
 #include "sw/device/lib/crypto/include/integrity.h"
 #include "sw/device/lib/crypto/include/sha2.h"
@@ -47,6 +48,70 @@ status_t ecdsa_p256_verify_test(
   return OTCRYPTO_OK;
 }
 
+enum {
+  // Number of test vectors handed to each batch verification call.
+  kBatchSize = 4,
+  // Length of a P-256 signature in words.
+  kSigWords = sizeof(p256_ecdsa_signature_t) / sizeof(uint32_t),
+};
+
+status_t ecdsa_p256_verify_batch_test(uint32_t start, uint32_t count) {
+  p256_point_t pks[kBatchSize];
+  p256_ecdsa_signature_t sigs[kBatchSize];
+  uint32_t digest_bufs[kBatchSize][256 / 32];
+  otcrypto_unblinded_key_t public_keys[kBatchSize];
+  otcrypto_hash_digest_t digests[kBatchSize];
+  hardened_bool_t results[kBatchSize];
+  // The buffer fields are const, so the array is set up in one go.
+  otcrypto_const_word32_buf_t signatures[kBatchSize] = {
+      OTCRYPTO_MAKE_BUF(otcrypto_const_word32_buf_t, (uint32_t *)&sigs[0],
+                        kSigWords),
+      OTCRYPTO_MAKE_BUF(otcrypto_const_word32_buf_t, (uint32_t *)&sigs[1],
+                        kSigWords),
+      OTCRYPTO_MAKE_BUF(otcrypto_const_word32_buf_t, (uint32_t *)&sigs[2],
+                        kSigWords),
+      OTCRYPTO_MAKE_BUF(otcrypto_const_word32_buf_t, (uint32_t *)&sigs[3],
+                        kSigWords),
+  };
+
+  for (uint32_t j = 0; j < count; j++) {
+    const ecdsa_p256_verify_test_vector_t *testvec =
+        &ecdsa_p256_verify_tests[start + j];
+    otcrypto_const_byte_buf_t msg_buf = OTCRYPTO_MAKE_BUF(
+        otcrypto_const_byte_buf_t, testvec->msg, testvec->msg_len);
+    digests[j] = (otcrypto_hash_digest_t){
+        .data = digest_bufs[j],
+        .len = ARRAYSIZE(digest_bufs[j]),
+    };
+    TRY(otcrypto_sha2_256(&msg_buf, &digests[j]));
+
+    pks[j] = testvec->public_key;
+    public_keys[j] = (otcrypto_unblinded_key_t){
+        .key_mode = kOtcryptoKeyModeEcdsaP256,
+        .key_length = sizeof(pks[j]),
+        .key = (uint32_t *)&pks[j],
+    };
+    public_keys[j].checksum =
+        otcrypto_integrity_unblinded_checksum(&public_keys[j]);
+
+    sigs[j] = testvec->signature;
+  }
+
+  TRY(otcrypto_ecdsa_p256_verify_batch(public_keys, digests, signatures, count,
+                                       results));
+
+  for (uint32_t j = 0; j < count; j++) {
+    bool valid = ecdsa_p256_verify_tests[start + j].valid;
+    if (valid != (results[j] == kHardenedBoolTrue) ||
+        (!valid && results[j] != kHardenedBoolFalse)) {
+      LOG_ERROR("Batch result mismatch on test vector %d.", start + j + 1);
+      return OTCRYPTO_RECOV_ERR;
+    }
+  }
+
+  return OTCRYPTO_OK;
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
@@ -78,5 +143,22 @@ bool test_main(void) {
   }
   LOG_INFO("Finished ecdsa_p256_verify_test:%s", RULE_NAME);
 
+  // Run the same vectors through the batch API, which must agree with the
+  // single-shot results.
+  LOG_INFO("Starting ecdsa_p256_verify_batch_test:%s", RULE_NAME);
+  for (uint32_t i = 0; i < kEcdsaP256VerifyNumTests; i += kBatchSize) {
+    uint32_t count = kEcdsaP256VerifyNumTests - i;
+    if (count > kBatchSize) {
+      count = kBatchSize;
+    }
+    status_t err = ecdsa_p256_verify_batch_test(i, count);
+    if (!status_ok(err)) {
+      LOG_ERROR("ecdsa_p256_verify_batch_test from test vector %d : error %r",
+                i + 1, err);
+      result = false;
+    }
+  }
+  LOG_INFO("Finished ecdsa_p256_verify_batch_test:%s", RULE_NAME);
+
   return result;
 }
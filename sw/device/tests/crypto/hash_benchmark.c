@@ -0,0 +1,179 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/config.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/hmac.h"
+#include "sw/device/lib/crypto/include/integrity.h"
+#include "sw/device/lib/crypto/include/sha2.h"
+#include "sw/device/lib/crypto/include/sha3.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/tests/crypto/lib/crypto_benchmark.h"
+
+// Benchmarks the one-shot hash, XOF and HMAC entry points of the cryptolib
+// across message sizes. Results are printed as `CRYPTO_BENCH` lines; see
+// `crypto_benchmark.h`.
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  kMaxMsgBytes = 4096,
+  kMaxDigestWords = 512 / 32,
+  kMaxHmacKeyBytes = 512 / 8,
+  kIterations = 4,
+};
+
+static const size_t kMsgSizes[] = {0, 64, 256, 1024, kMaxMsgBytes};
+
+static uint8_t msg_buf[kMaxMsgBytes];
+
+static const uint32_t kHmacKeyMask[kMaxHmacKeyBytes / sizeof(uint32_t)] = {
+    0x8cb847c3, 0xc6d34f36, 0x72edbf7b, 0x9bc0317f, 0x8f003c7f, 0x1d7ba049,
+    0xfd463b63, 0xbb720c44, 0x784c215e, 0xeb101d65, 0x35beb911, 0xab481345,
+    0xa7ebc3e3, 0x04b2a1b9, 0x764a9630, 0x78b8f9c5,
+};
+
+typedef otcrypto_status_t (*hash_fn_t)(const otcrypto_const_byte_buf_t *msg,
+                                       otcrypto_hash_digest_t *digest);
+
+typedef struct hash_benchmark {
+  const char *op;
+  hash_fn_t hash;
+  size_t digest_words;
+} hash_benchmark_t;
+
+static const hash_benchmark_t kHashBenchmarks[] = {
+    {"otcrypto_sha2_256", otcrypto_sha2_256, 256 / 32},
+    {"otcrypto_sha2_384", otcrypto_sha2_384, 384 / 32},
+    {"otcrypto_sha2_512", otcrypto_sha2_512, 512 / 32},
+    {"otcrypto_sha3_224", otcrypto_sha3_224, 224 / 32},
+    {"otcrypto_sha3_256", otcrypto_sha3_256, 256 / 32},
+    {"otcrypto_sha3_384", otcrypto_sha3_384, 384 / 32},
+    {"otcrypto_sha3_512", otcrypto_sha3_512, 512 / 32},
+    // The XOFs squeeze as much output as the digest buffer holds.
+    {"otcrypto_shake128", otcrypto_shake128, 256 / 32},
+    {"otcrypto_shake256", otcrypto_shake256, 512 / 32},
+};
+
+typedef struct hmac_benchmark {
+  const char *variant;
+  otcrypto_key_mode_t key_mode;
+  size_t key_bytes;
+  size_t tag_words;
+} hmac_benchmark_t;
+
+static const hmac_benchmark_t kHmacBenchmarks[] = {
+    {"sha256", kOtcryptoKeyModeHmacSha256, 256 / 8, 256 / 32},
+    {"sha384", kOtcryptoKeyModeHmacSha384, 384 / 8, 384 / 32},
+    {"sha512", kOtcryptoKeyModeHmacSha512, 512 / 8, 512 / 32},
+};
+
+typedef struct hash_ctx {
+  const hash_benchmark_t *bench;
+  otcrypto_const_byte_buf_t msg;
+} hash_ctx_t;
+
+static status_t hash_run(void *ctx) {
+  hash_ctx_t *hash_ctx = ctx;
+  uint32_t digest_data[kMaxDigestWords];
+  otcrypto_hash_digest_t digest = {
+      .data = digest_data,
+      .len = hash_ctx->bench->digest_words,
+  };
+  return hash_ctx->bench->hash(&hash_ctx->msg, &digest);
+}
+
+typedef struct hmac_ctx {
+  const otcrypto_blinded_key_t *key;
+  size_t tag_words;
+  otcrypto_const_byte_buf_t msg;
+} hmac_ctx_t;
+
+static status_t hmac_run(void *ctx) {
+  hmac_ctx_t *hmac_ctx = ctx;
+  uint32_t tag_data[kMaxDigestWords];
+  otcrypto_word32_buf_t tag =
+      OTCRYPTO_MAKE_BUF(otcrypto_word32_buf_t, tag_data, hmac_ctx->tag_words);
+  return otcrypto_hmac(hmac_ctx->key, &hmac_ctx->msg, &tag);
+}
+
+static status_t hash_benchmarks(void) {
+  for (size_t i = 0; i < ARRAYSIZE(kHashBenchmarks); ++i) {
+    for (size_t j = 0; j < ARRAYSIZE(kMsgSizes); ++j) {
+      hash_ctx_t ctx = {
+          .bench = &kHashBenchmarks[i],
+          .msg = OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, msg_buf,
+                                   kMsgSizes[j]),
+      };
+      crypto_benchmark_t bench = {
+          .op = kHashBenchmarks[i].op,
+          .variant = "",
+          .bytes = kMsgSizes[j],
+          .iterations = kIterations,
+          .fn = hash_run,
+          .ctx = &ctx,
+      };
+      TRY(crypto_benchmark_run(&bench));
+    }
+  }
+  return OK_STATUS();
+}
+
+static status_t hmac_benchmarks(void) {
+  uint32_t key_data[kMaxHmacKeyBytes / sizeof(uint32_t)];
+  crypto_benchmark_fill((uint8_t *)key_data, sizeof(key_data));
+
+  for (size_t i = 0; i < ARRAYSIZE(kHmacBenchmarks); ++i) {
+    const hmac_benchmark_t *hmac = &kHmacBenchmarks[i];
+    otcrypto_key_config_t config = {
+        .version = kOtcryptoLibVersion1,
+        .key_mode = hmac->key_mode,
+        .key_length = hmac->key_bytes,
+        .hw_backed = kHardenedBoolFalse,
+        .exportable = kHardenedBoolFalse,
+        .security_level = kOtcryptoKeySecurityLevelLow,
+    };
+    uint32_t keyblob[keyblob_num_words(config)];
+    TRY(keyblob_from_key_and_mask(key_data, kHmacKeyMask, config, keyblob));
+    otcrypto_blinded_key_t key = {
+        .config = config,
+        .keyblob_length = sizeof(keyblob),
+        .keyblob = keyblob,
+    };
+    key.checksum = otcrypto_integrity_blinded_checksum(&key);
+
+    for (size_t j = 0; j < ARRAYSIZE(kMsgSizes); ++j) {
+      hmac_ctx_t ctx = {
+          .key = &key,
+          .tag_words = hmac->tag_words,
+          .msg = OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, msg_buf,
+                                   kMsgSizes[j]),
+      };
+      crypto_benchmark_t bench = {
+          .op = "otcrypto_hmac",
+          .variant = hmac->variant,
+          .bytes = kMsgSizes[j],
+          .iterations = kIterations,
+          .fn = hmac_run,
+          .ctx = &ctx,
+      };
+      TRY(crypto_benchmark_run(&bench));
+    }
+  }
+  return OK_STATUS();
+}
+
+bool test_main(void) {
+  CHECK_STATUS_OK(otcrypto_init(kOtcryptoKeySecurityLevelLow));
+  crypto_benchmark_fill(msg_buf, sizeof(msg_buf));
+
+  status_t result = OK_STATUS();
+  EXECUTE_TEST(result, hash_benchmarks);
+  EXECUTE_TEST(result, hmac_benchmarks);
+  return status_ok(result);
+}
@@ -0,0 +1,57 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/tests/crypto/lib/crypto_benchmark.h"
+
+#include "sw/device/lib/base/math.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+
+#define MODULE_ID MAKE_MODULE_ID('c', 'b', 'm')
+
+status_t crypto_benchmark_run(const crypto_benchmark_t *bench) {
+  TRY_CHECK(bench->iterations > 0);
+
+  // Warm-up call; not measured.
+  TRY(bench->fn(bench->ctx));
+
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+  uint64_t total = 0;
+  for (size_t i = 0; i < bench->iterations; ++i) {
+    uint64_t start = profile_start();
+    TRY(bench->fn(bench->ctx));
+    uint32_t cycles = profile_end(start);
+    min = cycles < min ? cycles : min;
+    max = cycles > max ? cycles : max;
+    total += cycles;
+  }
+
+  uint32_t mean = (uint32_t)udiv64_slow(total, bench->iterations, NULL);
+  uint32_t mcpb = 0;
+  if (bench->bytes > 0) {
+    mcpb = (uint32_t)udiv64_slow(
+        total * 1000, (uint64_t)bench->bytes * bench->iterations, NULL);
+  }
+
+  LOG_INFO(CRYPTO_BENCHMARK_TAG
+           " {\"op\":\"%s\",\"variant\":\"%s\",\"bytes\":%u,"
+           "\"iterations\":%u,\"min\":%u,\"max\":%u,\"mean\":%u,\"mcpb\":%u}",
+           bench->op, bench->variant, (uint32_t)bench->bytes,
+           (uint32_t)bench->iterations, min, max, mean, mcpb);
+  return OK_STATUS();
+}
+
+void crypto_benchmark_fill(uint8_t *buf, size_t len) {
+  // xorshift32 with a fixed seed.
+  uint32_t state = 0x2545f491;
+  for (size_t i = 0; i < len; ++i) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    buf[i] = (uint8_t)state;
+  }
+}
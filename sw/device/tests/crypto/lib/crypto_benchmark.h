@@ -0,0 +1,103 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_TESTS_CRYPTO_LIB_CRYPTO_BENCHMARK_H_
+#define OPENTITAN_SW_DEVICE_TESTS_CRYPTO_LIB_CRYPTO_BENCHMARK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Prefix of every benchmark result line on the console.
+ *
+ * The rest of the line is a single JSON object; see
+ * `crypto_benchmark_run()` for its fields. The host-side tool
+ * `//sw/device/tests/crypto:crypto_benchmark_compare` extracts these lines
+ * from a console log.
+ */
+#define CRYPTO_BENCHMARK_TAG "CRYPTO_BENCH"
+
+/**
+ * Operation under benchmark.
+ *
+ * @param ctx Benchmark-specific context.
+ * @return OK or error.
+ */
+typedef status_t (*crypto_benchmark_fn_t)(void *ctx);
+
+/**
+ * A single benchmark: one cryptolib entry point with fixed parameters.
+ */
+typedef struct crypto_benchmark {
+  /**
+   * Name of the measured `otcrypto_*` entry point.
+   */
+  const char *op;
+  /**
+   * Parameters that distinguish this benchmark from others of the same
+   * operation and size, e.g. "aes128-cbc-enc". May be empty.
+   */
+  const char *variant;
+  /**
+   * Number of message bytes processed per call, or zero for operations with
+   * a fixed-size input such as key generation.
+   */
+  size_t bytes;
+  /**
+   * Number of measured calls. Must be at least one.
+   */
+  size_t iterations;
+  /**
+   * Function that performs one call of the operation.
+   */
+  crypto_benchmark_fn_t fn;
+  /**
+   * Context passed to `fn`.
+   */
+  void *ctx;
+} crypto_benchmark_t;
+
+/**
+ * Runs a benchmark and prints its result.
+ *
+ * The operation is called once to warm up the instruction cache, and then
+ * `iterations` more times with each call timed separately with the Ibex cycle
+ * counter. Any error from the operation aborts the benchmark.
+ *
+ * The result is printed as one console line:
+ *
+ *   CRYPTO_BENCH {"op":"otcrypto_sha2_256","variant":"","bytes":1024,
+ *                 "iterations":4,"min":..,"max":..,"mean":..,"mcpb":..}
+ *
+ * where `min`, `max` and `mean` are cycles per call and `mcpb` is the mean
+ * in thousandths of a cycle per byte (zero when `bytes` is zero). All values
+ * are integers, since the device-side printer has no floating point.
+ *
+ * @param bench The benchmark to run.
+ * @return OK or error.
+ */
+status_t crypto_benchmark_run(const crypto_benchmark_t *bench);
+
+/**
+ * Fills a buffer with a fixed pseudo-random pattern.
+ *
+ * The pattern only depends on `len`, so that runs are comparable with each
+ * other.
+ *
+ * @param[out] buf Buffer to fill.
+ * @param len Length of the buffer in bytes.
+ */
+void crypto_benchmark_fill(uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_TESTS_CRYPTO_LIB_CRYPTO_BENCHMARK_H_
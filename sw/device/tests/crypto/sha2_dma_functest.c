@@ -0,0 +1,230 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hw/top/dt/dma.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/crypto/drivers/dma.h"
+#include "sw/device/lib/crypto/drivers/hmac.h"
+#include "sw/device/lib/crypto/impl/status.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/integrity.h"
+#include "sw/device/lib/crypto/include/sha2.h"
+#include "sw/device/lib/dif/dif_dma.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#include "hw/top/dma_regs.h"  // Generated.
+#include "hw/top_darjeeling/sw/autogen/top_darjeeling.h"
+
+/**
+ * Checks that SHA-2 digests computed inline by the DMA match the HMAC block.
+ *
+ * `otcrypto_sha2_*` hands large, word-aligned messages to the DMA when it is
+ * free and falls back to the HMAC block otherwise. Both paths must produce
+ * the same digest, and the DMA path must leave the configuration of another
+ * DMA user untouched.
+ */
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  kMaxDigestWords = 512 / 32,
+  kMessageWords = (2 * kDmaSha2MinMessageBytes + 64) / sizeof(uint32_t),
+};
+
+static uint32_t message[kMessageWords];
+static dif_dma_t dma;
+
+/**
+ * Message lengths to test, in bytes.
+ *
+ * Covers the smallest length the DMA accepts, a length that is not a whole
+ * number of SHA-512 blocks, and the full buffer.
+ */
+static const size_t kMessageLens[] = {
+    kDmaSha2MinMessageBytes,
+    kDmaSha2MinMessageBytes + 4,
+    sizeof(message),
+};
+
+typedef struct sha2_case {
+  const char *name;
+  dma_sha2_mode_t dma_mode;
+  size_t digest_words;
+} sha2_case_t;
+
+static const sha2_case_t kSha2Cases[] = {
+    {.name = "SHA-256", .dma_mode = kDmaSha2Mode256, .digest_words = 8},
+    {.name = "SHA-384", .dma_mode = kDmaSha2Mode384, .digest_words = 12},
+    {.name = "SHA-512", .dma_mode = kDmaSha2Mode512, .digest_words = 16},
+};
+
+/**
+ * Computes the reference digest with the HMAC block.
+ */
+static status_t hmac_digest(const sha2_case_t *test,
+                            const otcrypto_const_byte_buf_t *msg,
+                            uint32_t *digest) {
+  switch (test->dma_mode) {
+    case kDmaSha2Mode256:
+      return hmac_hash_sha256(msg, digest);
+    case kDmaSha2Mode384:
+      return hmac_hash_sha384(msg, digest);
+    case kDmaSha2Mode512:
+      return hmac_hash_sha512(msg, digest);
+    default:
+      return INVALID_ARGUMENT();
+  }
+}
+
+/**
+ * Computes the digest through the public one-shot API.
+ */
+static status_t otcrypto_digest(const sha2_case_t *test,
+                                const otcrypto_const_byte_buf_t *msg,
+                                uint32_t *digest) {
+  otcrypto_hash_digest_t digest_buf = {
+      .data = digest,
+      .len = test->digest_words,
+  };
+  switch (test->dma_mode) {
+    case kDmaSha2Mode256:
+      return otcrypto_sha2_256(msg, &digest_buf);
+    case kDmaSha2Mode384:
+      return otcrypto_sha2_384(msg, &digest_buf);
+    case kDmaSha2Mode512:
+      return otcrypto_sha2_512(msg, &digest_buf);
+    default:
+      return INVALID_ARGUMENT();
+  }
+}
+
+/**
+ * Compares the DMA driver and the public API against the HMAC block.
+ *
+ * @param dma_expected Whether the DMA is expected to accept the messages.
+ */
+static status_t compare_digests(bool dma_expected) {
+  for (size_t i = 0; i < ARRAYSIZE(kSha2Cases); ++i) {
+    const sha2_case_t *test = &kSha2Cases[i];
+    for (size_t j = 0; j < ARRAYSIZE(kMessageLens); ++j) {
+      LOG_INFO("%s, %d bytes", test->name, kMessageLens[j]);
+      otcrypto_const_byte_buf_t msg = OTCRYPTO_MAKE_BUF(
+          otcrypto_const_byte_buf_t, (const uint8_t *)message, kMessageLens[j]);
+      uint32_t exp_digest[kMaxDigestWords];
+      TRY(hmac_digest(test, &msg, exp_digest));
+
+      hardened_bool_t usable =
+          dma_sha2_usable((const uint8_t *)message, kMessageLens[j]);
+      TRY_CHECK(usable == (dma_expected ? kHardenedBoolTrue
+                                        : kHardenedBoolFalse));
+      if (dma_expected) {
+        uint32_t dma_digest[kMaxDigestWords];
+        TRY(dma_sha2(test->dma_mode, (const uint8_t *)message, kMessageLens[j],
+                     dma_digest));
+        TRY_CHECK_ARRAYS_EQ(dma_digest, exp_digest, test->digest_words);
+      }
+
+      uint32_t act_digest[kMaxDigestWords];
+      TRY(otcrypto_digest(test, &msg, act_digest));
+      TRY_CHECK_ARRAYS_EQ(act_digest, exp_digest, test->digest_words);
+    }
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Before the enabled memory range is set, every message takes the HMAC path.
+ */
+static status_t fallback_test(void) { return compare_digests(false); }
+
+/**
+ * With the range set, large aligned messages are hashed by the DMA.
+ */
+static status_t dma_path_test(void) { return compare_digests(true); }
+
+/**
+ * Messages the DMA cannot take still hash correctly through the HMAC block.
+ */
+static status_t unaligned_test(void) {
+  const uint8_t *unaligned = (const uint8_t *)message + 1;
+  size_t len = kDmaSha2MinMessageBytes;
+  TRY_CHECK(dma_sha2_usable(unaligned, len) == kHardenedBoolFalse);
+  TRY_CHECK(dma_sha2_usable((const uint8_t *)message, len - 4) ==
+            kHardenedBoolFalse);
+
+  otcrypto_const_byte_buf_t msg =
+      OTCRYPTO_MAKE_BUF(otcrypto_const_byte_buf_t, unaligned, len);
+  uint32_t exp_digest[kMaxDigestWords];
+  uint32_t act_digest[kMaxDigestWords];
+  TRY(hmac_digest(&kSha2Cases[0], &msg, exp_digest));
+  TRY(otcrypto_digest(&kSha2Cases[0], &msg, act_digest));
+  TRY_CHECK_ARRAYS_EQ(act_digest, exp_digest, kSha2Cases[0].digest_words);
+  return OK_STATUS();
+}
+
+/**
+ * Hashing with the DMA preserves a transfer that another user configured.
+ */
+static status_t config_preserved_test(void) {
+  static uint32_t src[4] = {0x00112233, 0x44556677, 0x8899aabb, 0xccddeeff};
+  static uint32_t dst[4];
+  dif_dma_transaction_t transaction = {
+      .source = {.address = (uintptr_t)src,
+                 .asid = kDifDmaOpentitanInternalBus},
+      .destination = {.address = (uintptr_t)dst,
+                      .asid = kDifDmaOpentitanInternalBus},
+      .src_config = {.wrap = false, .increment = true},
+      .dst_config = {.wrap = false, .increment = true},
+      .total_size = sizeof(src),
+      .chunk_size = sizeof(src),
+      .width = kDifDmaTransWidth4Bytes,
+  };
+  TRY(dif_dma_configure(&dma, transaction));
+
+  uint32_t src_lo =
+      mmio_region_read32(dma.base_addr, DMA_SRC_ADDR_LO_REG_OFFSET);
+  uint32_t dst_lo =
+      mmio_region_read32(dma.base_addr, DMA_DST_ADDR_LO_REG_OFFSET);
+  uint32_t total =
+      mmio_region_read32(dma.base_addr, DMA_TOTAL_DATA_SIZE_REG_OFFSET);
+
+  uint32_t digest[kMaxDigestWords];
+  TRY(dma_sha2(kDmaSha2Mode256, (const uint8_t *)message,
+               kDmaSha2MinMessageBytes, digest));
+
+  TRY_CHECK(mmio_region_read32(dma.base_addr, DMA_SRC_ADDR_LO_REG_OFFSET) ==
+            src_lo);
+  TRY_CHECK(mmio_region_read32(dma.base_addr, DMA_DST_ADDR_LO_REG_OFFSET) ==
+            dst_lo);
+  TRY_CHECK(mmio_region_read32(dma.base_addr,
+                               DMA_TOTAL_DATA_SIZE_REG_OFFSET) == total);
+
+  // The configured transfer must still run to completion.
+  TRY(dif_dma_start(&dma, kDifDmaCopyOpcode));
+  TRY(dif_dma_status_poll(&dma, kDifDmaStatusDone));
+  TRY(dif_dma_status_clear(&dma));
+  TRY_CHECK_ARRAYS_EQ(dst, src, ARRAYSIZE(src));
+  return OK_STATUS();
+}
+
+bool test_main(void) {
+  for (size_t i = 0; i < ARRAYSIZE(message); ++i) {
+    message[i] = 0x9e3779b9 * (i + 1);
+  }
+  CHECK_DIF_OK(dif_dma_init_from_dt(kDtDma, &dma));
+
+  status_t test_result = OK_STATUS();
+  EXECUTE_TEST(test_result, fallback_test);
+
+  CHECK_DIF_OK(dif_dma_memory_range_set(
+      &dma, TOP_DARJEELING_SRAM_CTRL_MAIN_RAM_BASE_ADDR,
+      TOP_DARJEELING_SRAM_CTRL_MAIN_RAM_SIZE_BYTES));
+  EXECUTE_TEST(test_result, dma_path_test);
+  EXECUTE_TEST(test_result, unaligned_test);
+  EXECUTE_TEST(test_result, config_preserved_test);
+  return status_ok(test_result);
+}
@@ -47,6 +47,13 @@ pub trait ConsoleDevice {
     fn as_coverage_console(&self) -> Option<&dyn CoverageConsole> {
         None
     }
+
+    /// Returns whether ujson byte arrays sent on this console are hex strings.
+    ///
+    /// See [`crate::test_utils::ujson_bytes::CompactBytes`].
+    fn ujson_compact_bytes(&self) -> bool {
+        false
+    }
 }
 
 /// Interface for objects that can wait for coverage extraction to complete.
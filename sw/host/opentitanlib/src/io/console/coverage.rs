@@ -298,6 +298,10 @@ impl<T: ConsoleDevice> ConsoleDevice for CoverageMiddleware<T> {
     fn as_coverage_console(&self) -> Option<&dyn CoverageConsole> {
         self.inner.as_coverage_console().or(Some(self))
     }
+
+    fn ujson_compact_bytes(&self) -> bool {
+        self.inner.ujson_compact_bytes()
+    }
 }
 
 impl<T: ConsoleDevice> CoverageConsole for CoverageMiddleware<T> {
@@ -32,6 +32,10 @@ where
     fn as_coverage_console_impl(&self) -> Option<&dyn CoverageConsole> {
         self.inner().as_coverage_console()
     }
+
+    fn ujson_compact_bytes_impl(&self) -> bool {
+        self.inner().ujson_compact_bytes()
+    }
 }
 
 impl<T: ConsoleMiddleware> ConsoleDevice for T
@@ -49,6 +53,10 @@ where
     fn as_coverage_console(&self) -> Option<&dyn CoverageConsole> {
         self.as_coverage_console_impl()
     }
+
+    fn ujson_compact_bytes(&self) -> bool {
+        self.ujson_compact_bytes_impl()
+    }
 }
 
 impl<T: ConsoleMiddleware> CoverageConsole for T
@@ -47,7 +47,7 @@ impl MemReadReq {
             };
             op.send_with_crc(device)?;
             let resp = MemReadResp::recv(device, Duration::from_secs(300), false, false)?;
-            data[bytes_read..(bytes_read + op_size)].copy_from_slice(resp.data.as_slice());
+            data[bytes_read..(bytes_read + op_size)].copy_from_slice(&resp.data[..op_size]);
             bytes_read += op_size;
         }
         Ok(())
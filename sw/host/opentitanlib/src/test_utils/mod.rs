@@ -31,6 +31,7 @@ pub mod rpc;
 pub mod spi_passthru;
 pub mod status;
 pub mod test_status;
+pub mod ujson_bytes;
 
 /// The `execute_test` macro should be used in end-to-end tests to
 /// invoke each test from the `main` function.
@@ -10,11 +10,43 @@ use std::time::Duration;
 use crate::io::console::ext::{PassFail, PassFailResult};
 use crate::io::console::{ConsoleDevice, ConsoleError, ConsoleExt};
 use crate::regex;
+use crate::test_utils::e2e_command::TestCommand;
 use crate::test_utils::status::Status;
 
 // Bring in the auto-generated sources.
 include!(env!("ottf"));
 
+impl UjsonConfig {
+    /// Selects the encoding of byte buffers the device exchanges on `device`.
+    ///
+    /// With `compact_bytes` set, the device sends and expects byte buffers as
+    /// hex strings instead of arrays of integers, which roughly halves the
+    /// console traffic for memory dumps and provisioning data.  This only
+    /// changes the device side; use [`ujson_bytes::CompactBytes::negotiate`]
+    /// to switch both ends of a connection.
+    pub fn execute<T>(device: &T, compact_bytes: bool) -> Result<()>
+    where
+        T: ConsoleDevice + ?Sized,
+    {
+        TestCommand::UjsonConfig.send_with_crc(device)?;
+        UjsonConfig { compact_bytes }.send_with_crc(device)?;
+        Status::recv(device, Duration::from_secs(300), false, false)?;
+        Ok(())
+    }
+}
+
+/// Serializes `value` with the byte-array encoding selected for `device`.
+fn to_json<T, U>(device: &T, value: &U) -> Result<String>
+where
+    T: ConsoleDevice + ?Sized,
+    U: Serialize + ?Sized,
+{
+    Ok(ujson_bytes::with_compact(
+        device.ujson_compact_bytes(),
+        || serde_json::to_string(value),
+    )?)
+}
+
 pub trait ConsoleSend<T>
 where
     T: ConsoleDevice + ?Sized,
@@ -32,14 +64,14 @@ where
     U: Serialize,
 {
     fn send(&self, device: &T) -> Result<String> {
-        let s = serde_json::to_string(self)?;
+        let s = to_json(device, self)?;
         log::info!("Sending: {}", s);
         device.write(s.as_bytes())?;
         Ok(s)
     }
 
     fn send_with_crc(&self, device: &T) -> Result<String> {
-        let s = serde_json::to_string(self)?;
+        let s = to_json(device, self)?;
         log::info!("Sending: {}", s);
         device.write(s.as_bytes())?;
         let actual_crc = OttfCrc {
@@ -50,7 +82,7 @@ where
     }
 
     fn send_with_padding(&self, device: &T, max_size: usize) -> Result<String> {
-        let mut s = serde_json::to_string(self)?;
+        let mut s = to_json(device, self)?;
         let pad_len = max_size - s.len();
         let pad_str = ' '.to_string().repeat(pad_len);
         s.insert_str(s.len() - 1, &pad_str);
@@ -65,7 +97,7 @@ where
         quiet: bool,
     ) -> Result<String> {
         // Craft the UJSON string and pad with whitespace.
-        let mut s = serde_json::to_string(self)?;
+        let mut s = to_json(device, self)?;
         let pad_len = max_size - s.len();
         let pad_str = ' '.to_string().repeat(pad_len);
         s.insert_str(s.len() - 1, &pad_str);
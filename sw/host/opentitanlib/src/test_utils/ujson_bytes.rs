@@ -0,0 +1,227 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Serde helpers for ujson byte arrays.
+//!
+//! The ujson code generator applies this module (via `#[serde(with = ...)]`) to
+//! every one-dimensional `uint8_t` array field.  Such fields deserialize from
+//! either a JSON array of integers or a hex string, matching the device-side
+//! parser.  They serialize as an array of integers unless the console they are
+//! sent on is wrapped in [`CompactBytes`], which should only be done once the
+//! device has agreed to it (see [`CompactBytes::negotiate`]).
+//!
+//! The encoding is a property of the connection, not of the process: a test
+//! may talk to several devices, and only some of them may have switched to
+//! hex strings.
+
+use anyhow::Result;
+use arrayvec::ArrayVec;
+use serde::de::{self, SeqAccess, Visitor};
+use serde::{Deserializer, Serializer};
+use std::cell::Cell;
+use std::fmt;
+
+use crate::io::console::ConsoleDevice;
+use crate::io::middleware::{ConsoleMiddleware, Middleware, UartMiddleware};
+use crate::io::uart::Uart;
+use crate::test_utils::rpc::UjsonConfig;
+
+thread_local! {
+    // Encoding used by `serialize` on this thread; only set for the duration
+    // of `with_compact`.
+    static COMPACT: Cell<bool> = const { Cell::new(false) };
+}
+
+/// Runs `f` with byte arrays serialized as hex strings if `compact` is set.
+///
+/// Used by the console send helpers to apply the encoding of the console a
+/// message is sent on.
+pub fn with_compact<R>(compact: bool, f: impl FnOnce() -> R) -> R {
+    // Restore the previous encoding even if `f` unwinds.
+    struct Restore(bool);
+    impl Drop for Restore {
+        fn drop(&mut self) {
+            COMPACT.with(|c| c.set(self.0));
+        }
+    }
+    let _restore = Restore(COMPACT.with(|c| c.replace(compact)));
+    f()
+}
+
+fn compact() -> bool {
+    COMPACT.with(|c| c.get())
+}
+
+/// Console middleware that marks a connection as using hex-string byte arrays.
+///
+/// Messages sent through this wrapper encode byte arrays as hex strings; all
+/// other console and UART operations are forwarded to the inner device.
+pub struct CompactBytes<T> {
+    inner: T,
+}
+
+impl<T: ConsoleDevice> CompactBytes<T> {
+    /// Asks the device to switch to hex-string byte arrays.
+    ///
+    /// The device is only wrapped once it has acknowledged the request, so
+    /// firmware that does not know the command makes this fail instead of
+    /// leaving the two ends with different encodings.
+    pub fn negotiate(inner: T) -> Result<CompactBytes<T>> {
+        UjsonConfig::execute(&inner, true)?;
+        Ok(CompactBytes { inner })
+    }
+
+    /// Asks the device to switch back to integer byte arrays.
+    pub fn into_inner(self) -> Result<T> {
+        UjsonConfig::execute(&self.inner, false)?;
+        Ok(self.inner)
+    }
+}
+
+impl<T: ConsoleDevice> Middleware for CompactBytes<T> {
+    type Inner = T;
+    fn inner(&self) -> &T {
+        &self.inner
+    }
+}
+
+impl<T: ConsoleDevice> ConsoleMiddleware for CompactBytes<T> {
+    fn ujson_compact_bytes_impl(&self) -> bool {
+        true
+    }
+}
+
+impl<T: ConsoleDevice + Uart> UartMiddleware for CompactBytes<T> {}
+
+pub fn serialize<S, const N: usize>(
+    bytes: &ArrayVec<u8, N>,
+    serializer: S,
+) -> Result<S::Ok, S::Error>
+where
+    S: Serializer,
+{
+    if compact() {
+        serializer.serialize_str(&hex::encode(bytes))
+    } else {
+        serializer.collect_seq(bytes)
+    }
+}
+
+pub fn deserialize<'de, D, const N: usize>(deserializer: D) -> Result<ArrayVec<u8, N>, D::Error>
+where
+    D: Deserializer<'de>,
+{
+    deserializer.deserialize_any(BytesVisitor::<N>)
+}
+
+struct BytesVisitor<const N: usize>;
+
+impl<'de, const N: usize> Visitor<'de> for BytesVisitor<N> {
+    type Value = ArrayVec<u8, N>;
+
+    fn expecting(&self, formatter: &mut fmt::Formatter) -> fmt::Result {
+        write!(formatter, "an array of at most {N} bytes or a hex string")
+    }
+
+    fn visit_str<E>(self, value: &str) -> Result<Self::Value, E>
+    where
+        E: de::Error,
+    {
+        let bytes = hex::decode(value).map_err(E::custom)?;
+        ArrayVec::try_from(bytes.as_slice()).map_err(|_| E::invalid_length(bytes.len(), &self))
+    }
+
+    fn visit_seq<A>(self, mut seq: A) -> Result<Self::Value, A::Error>
+    where
+        A: SeqAccess<'de>,
+    {
+        let mut bytes = ArrayVec::new();
+        while let Some(byte) = seq.next_element::<u8>()? {
+            bytes
+                .try_push(byte)
+                .map_err(|_| de::Error::invalid_length(bytes.len() + 1, &self))?;
+        }
+        Ok(bytes)
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use super::*;
+    use crate::test_utils::rpc::ConsoleSend;
+    use serde::{Deserialize, Serialize};
+    use std::cell::RefCell;
+    use std::task::{Context, Poll};
+
+    // Console that records everything written to it.
+    #[derive(Default)]
+    struct Recorder(RefCell<Vec<u8>>);
+
+    impl ConsoleDevice for Recorder {
+        fn poll_read(&self, _cx: &mut Context<'_>, _buf: &mut [u8]) -> Poll<Result<usize>> {
+            Poll::Ready(Ok(0))
+        }
+
+        fn write(&self, buf: &[u8]) -> Result<()> {
+            self.0.borrow_mut().extend_from_slice(buf);
+            Ok(())
+        }
+    }
+
+    #[derive(Debug, Serialize, Deserialize, PartialEq)]
+    struct Blob {
+        #[serde(with = "super")]
+        data: ArrayVec<u8, 4>,
+    }
+
+    #[test]
+    fn test_deserialize_both_encodings() {
+        let expected = Blob {
+            data: ArrayVec::from([0x00, 0x7f, 0x80, 0xff]),
+        };
+        let from_seq: Blob = serde_json::from_str(r#"{"data":[0,127,128,255]}"#).unwrap();
+        let from_hex: Blob = serde_json::from_str(r#"{"data":"007F80ff"}"#).unwrap();
+        assert_eq!(from_seq, expected);
+        assert_eq!(from_hex, expected);
+    }
+
+    #[test]
+    fn test_deserialize_too_long() {
+        assert!(serde_json::from_str::<Blob>(r#"{"data":[0,1,2,3,4]}"#).is_err());
+        assert!(serde_json::from_str::<Blob>(r#"{"data":"0001020304"}"#).is_err());
+        assert!(serde_json::from_str::<Blob>(r#"{"data":"abc"}"#).is_err());
+    }
+
+    #[test]
+    fn test_serialize() {
+        let blob = Blob {
+            data: ArrayVec::from([0x00, 0x7f, 0x80, 0xff]),
+        };
+        assert_eq!(
+            serde_json::to_string(&blob).unwrap(),
+            r#"{"data":[0,127,128,255]}"#
+        );
+        let compact = with_compact(true, || serde_json::to_string(&blob));
+        assert_eq!(compact.unwrap(), r#"{"data":"007f80ff"}"#);
+        // The encoding only applies inside `with_compact`.
+        assert_eq!(
+            serde_json::to_string(&blob).unwrap(),
+            r#"{"data":[0,127,128,255]}"#
+        );
+    }
+
+    #[test]
+    fn test_encoding_per_console() {
+        let blob = Blob {
+            data: ArrayVec::from([0x00, 0x7f, 0x80, 0xff]),
+        };
+        let plain = Recorder::default();
+        let compact = Recorder::default();
+        let compact_console = CompactBytes { inner: &compact };
+        blob.send(&compact_console).unwrap();
+        blob.send(&plain).unwrap();
+        assert_eq!(&*compact.0.borrow(), br#"{"data":"007f80ff"}"#);
+        assert_eq!(&*plain.0.borrow(), br#"{"data":[0,127,128,255]}"#);
+    }
+}
@@ -13,7 +13,8 @@ use serde::Deserialize;
 
 use cryptotest_commands::commands::CryptotestCommand;
 use cryptotest_commands::hash_commands::{
-    CryptotestHashAlgorithm, CryptotestHashMessage, CryptotestHashOutput,
+    CryptotestHashAlgorithm, CryptotestHashBatch, CryptotestHashBatchOutput,
+    CryptotestHashBatchVector, CryptotestHashMessage, CryptotestHashOutput,
     CryptotestHashShakeDigestLength,
 };
 
@@ -47,6 +48,11 @@ struct Opts {
     #[arg(long)]
     seed: Option<u64>,
 
+    // Maximum number of test vectors sent to the device in a single batch
+    // command. Vectors are run one command at a time if set to 0.
+    #[arg(long, default_value_t = 64usize)]
+    batch_size: usize,
+
     #[arg(long, num_args = 1..)]
     hash_json: Vec<String>,
 }
@@ -66,6 +72,40 @@ struct HashTestCase {
 
 const HASH_CMD_MAX_MESSAGE_BYTES: usize = 17068;
 const HASH_CMD_MAX_CUSTOMIZATION_STRING_BYTES: usize = 16;
+const HASH_CMD_MAX_BATCH_VECTORS: usize = 256;
+const HASH_CMD_MAX_BATCH_FAILURES: usize = 32;
+
+fn hash_algorithm(algorithm: &str) -> CryptotestHashAlgorithm {
+    match algorithm {
+        "sha-256" => CryptotestHashAlgorithm::Sha256,
+        "sha-384" => CryptotestHashAlgorithm::Sha384,
+        "sha-512" => CryptotestHashAlgorithm::Sha512,
+        "sha3-224" => CryptotestHashAlgorithm::Sha3_224,
+        "sha3-256" => CryptotestHashAlgorithm::Sha3_256,
+        "sha3-384" => CryptotestHashAlgorithm::Sha3_384,
+        "sha3-512" => CryptotestHashAlgorithm::Sha3_512,
+        "shake-128" => CryptotestHashAlgorithm::Shake128,
+        "shake-256" => CryptotestHashAlgorithm::Shake256,
+        "cshake-128" => CryptotestHashAlgorithm::Cshake128,
+        "cshake-256" => CryptotestHashAlgorithm::Cshake256,
+        _ => panic!("Unsupported hash algorithm"),
+    }
+}
+
+fn check_hash_testcase_size(test_case: &HashTestCase) {
+    assert!(
+        test_case.message.len() <= HASH_CMD_MAX_MESSAGE_BYTES,
+        "Message too long for device firmware configuration (got = {}, max = {})",
+        test_case.message.len(),
+        HASH_CMD_MAX_MESSAGE_BYTES,
+    );
+    assert!(
+        test_case.customization_string.len() <= HASH_CMD_MAX_CUSTOMIZATION_STRING_BYTES,
+        "Customization string too long for device firmware configuration (got = {}, max = {})",
+        test_case.customization_string.len(),
+        HASH_CMD_MAX_CUSTOMIZATION_STRING_BYTES,
+    );
+}
 
 fn run_hash_testcase(
     test_case: &HashTestCase,
@@ -81,35 +121,10 @@ fn run_hash_testcase(
     );
     CryptotestCommand::Hash.send(spi_console)?;
 
-    assert!(
-        test_case.message.len() <= HASH_CMD_MAX_MESSAGE_BYTES,
-        "Message too long for device firmware configuration (got = {}, max = {})",
-        test_case.message.len(),
-        HASH_CMD_MAX_MESSAGE_BYTES,
-    );
-    assert!(
-        test_case.customization_string.len() <= HASH_CMD_MAX_CUSTOMIZATION_STRING_BYTES,
-        "Customization string too long for device firmware configuration (got = {}, max = {})",
-        test_case.customization_string.len(),
-        HASH_CMD_MAX_CUSTOMIZATION_STRING_BYTES,
-    );
+    check_hash_testcase_size(test_case);
 
     // Send algorithm type
-    match test_case.algorithm.as_str() {
-        "sha-256" => CryptotestHashAlgorithm::Sha256,
-        "sha-384" => CryptotestHashAlgorithm::Sha384,
-        "sha-512" => CryptotestHashAlgorithm::Sha512,
-        "sha3-224" => CryptotestHashAlgorithm::Sha3_224,
-        "sha3-256" => CryptotestHashAlgorithm::Sha3_256,
-        "sha3-384" => CryptotestHashAlgorithm::Sha3_384,
-        "sha3-512" => CryptotestHashAlgorithm::Sha3_512,
-        "shake-128" => CryptotestHashAlgorithm::Shake128,
-        "shake-256" => CryptotestHashAlgorithm::Shake256,
-        "cshake-128" => CryptotestHashAlgorithm::Cshake128,
-        "cshake-256" => CryptotestHashAlgorithm::Cshake256,
-        _ => panic!("Unsupported hash algorithm"),
-    }
-    .send(spi_console)?;
+    hash_algorithm(test_case.algorithm.as_str()).send(spi_console)?;
 
     // Send required digest size for SHAKE tests (this value is
     // ignored for SHA2/3)
@@ -171,6 +186,79 @@ fn run_hash_testcase(
     Ok(())
 }
 
+// Runs a batch of test cases that all use the same algorithm with a single
+// command, so that the device runs them back-to-back and replies once.
+fn run_hash_batch(
+    test_cases: &[&HashTestCase],
+    opts: &Opts,
+    spi_console: &SpiConsoleDevice,
+    fail_counter: &mut u32,
+) -> Result<()> {
+    assert!(test_cases.len() <= HASH_CMD_MAX_BATCH_VECTORS);
+    log::info!(
+        "vendor: {}, algorithm: {}, test cases: {}..={}",
+        test_cases[0].vendor,
+        test_cases[0].algorithm,
+        test_cases[0].test_case_id,
+        test_cases[test_cases.len() - 1].test_case_id
+    );
+    CryptotestCommand::HashBatch.send(spi_console)?;
+    CryptotestHashBatch {
+        algorithm: hash_algorithm(test_cases[0].algorithm.as_str()),
+        count: test_cases.len(),
+    }
+    .send(spi_console)?;
+    for test_case in test_cases {
+        check_hash_testcase_size(test_case);
+        CryptotestHashBatchVector {
+            message: ArrayVec::try_from(test_case.message.as_slice()).unwrap(),
+            message_len: test_case.message.len(),
+            customization_string: ArrayVec::try_from(test_case.customization_string.as_slice())
+                .unwrap(),
+            customization_string_len: test_case.customization_string.len(),
+            digest: ArrayVec::try_from(test_case.digest.as_slice()).unwrap(),
+            digest_len: test_case.digest.len(),
+            result: test_case.result,
+        }
+        .send(spi_console)?;
+    }
+
+    // Each vector takes at most as long as a single command would, so scale
+    // the timeout with the batch size.
+    let batch_output = CryptotestHashBatchOutput::recv(
+        spi_console,
+        opts.timeout * test_cases.len() as u32,
+        false,
+        false,
+    )?;
+    assert_eq!(batch_output.count, test_cases.len());
+    for (i, test_case) in test_cases.iter().enumerate() {
+        if batch_output.errored[i / 32] & (1 << (i % 32)) != 0 {
+            log::info!(
+                "FAILED {} test #{}: device returned an error",
+                test_case.algorithm,
+                test_case.test_case_id
+            );
+        } else if batch_output.passed[i / 32] & (1 << (i % 32)) == 0 {
+            log::info!(
+                "FAILED {} test #{}: expected = {}",
+                test_case.algorithm,
+                test_case.test_case_id,
+                test_case.result
+            );
+        }
+    }
+    if batch_output.failure_count > HASH_CMD_MAX_BATCH_FAILURES {
+        log::info!(
+            "{} failures in batch, only the first {} were reported by index",
+            batch_output.failure_count,
+            HASH_CMD_MAX_BATCH_FAILURES
+        );
+    }
+    *fail_counter += batch_output.failure_count as u32;
+    Ok(())
+}
+
 fn test_hash(opts: &Opts, transport: &TransportWrapper) -> Result<()> {
     let spi = transport.spi("BOOTSTRAP")?;
     let spi_console_device = SpiConsoleDevice::new(&*spi, None, /*ignore_frame_num=*/ false)?;
@@ -200,6 +288,8 @@ fn test_hash(opts: &Opts, transport: &TransportWrapper) -> Result<()> {
         let offset = start_offset % stride;
         log::info!("Tests options: skip_stride: {}, offset: {}", stride, offset);
 
+        let batch_size = min(opts.batch_size, HASH_CMD_MAX_BATCH_VECTORS);
+        let mut batch: Vec<&HashTestCase> = Vec::new();
         for hash_test in &hash_tests {
             test_counter += 1;
 
@@ -208,8 +298,25 @@ fn test_hash(opts: &Opts, transport: &TransportWrapper) -> Result<()> {
                 continue;
             }
 
-            log::info!("Test counter: {}", test_counter);
-            run_hash_testcase(hash_test, opts, &spi_console_device, &mut fail_counter)?;
+            if batch_size == 0 {
+                log::info!("Test counter: {}", test_counter);
+                run_hash_testcase(hash_test, opts, &spi_console_device, &mut fail_counter)?;
+                continue;
+            }
+
+            // A batch holds test cases of a single algorithm only.
+            if batch.len() == batch_size
+                || batch
+                    .first()
+                    .is_some_and(|first| first.algorithm != hash_test.algorithm)
+            {
+                run_hash_batch(&batch, opts, &spi_console_device, &mut fail_counter)?;
+                batch.clear();
+            }
+            batch.push(hash_test);
+        }
+        if !batch.is_empty() {
+            run_hash_batch(&batch, opts, &spi_console_device, &mut fail_counter)?;
         }
     }
     CryptotestCommand::Quit.send(&spi_console_device)?;
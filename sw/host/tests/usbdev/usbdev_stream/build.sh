@@ -11,4 +11,4 @@ g++ -Wall -Werror -std=c++17 -c -o usbdev_stream.o -DSTREAMTEST_LIBUSB=1 usbdev_
 g++ -Wall -Werror -std=c++17 -c -o usbdev_utils.o -DSTREAMTEST_LIBUSB=1 usbdev_utils.cc
 g++ -Wall -Werror -std=c++17 -c -o usb_device.o -DSTREAMTEST_LIBUSB=1 usb_device.cc
 
-g++ -g -O2 -o stream_test stream_test.o usbdev_iso.o usbdev_int.o usbdev_serial.o usbdev_stream.o usbdev_utils.o usb_device.o -lusb-1.0
+g++ -g -O2 -o stream_test stream_test.o usbdev_iso.o usbdev_int.o usbdev_serial.o usbdev_stream.o usbdev_utils.o usb_device.o -lusb-1.0 -pthread
@@ -25,15 +25,20 @@
 // overridden using command line parameters.
 //
 // Usage:
-//   stream [-v<bool>][-c<bool>][-r<bool>][-s<bool>]
+//   stream [-v<bool>][-c<bool>][-e<bool>][-q<depth>][-r<bool>][-s<bool>]
 //          [[-d<bus>:<address>] | [--device <bus>:<address>]]
+//          [--bench <file>]
 //          [<input port>[ <output port>]]
 //
 //   --device   programmatically specify a particular USB device by bus number
 //              and device address (see 'lsusb' output).
+//   --bench    write throughput and latency percentiles for each stream to
+//              the given file ('-' for stdout) in JSON format.
 //
 //   -c   check any retrieved data against expectations
 //   -d   specify a particular USB device by bus number and device address
+//   -e   handle libusb events on a dedicated thread
+//   -q   number of transfers kept in flight in each direction, per stream
 //   -r   retrieve data from device
 //   -s   send data to device
 //   -t   use serial ports (ttyUSBx) in preference to libusb Bulk Transfer
@@ -153,16 +158,23 @@ void PortNext(char *next, size_t n, const char *curr) {
 void ReportSyntax(void) {
   fputs(
       "Usage:\n"
-      "  stream [-n<streams>][-v<bool>][-c<bool>][-r<bool>][-s<bool>][-t][-z]\n"
+      "  stream [-n<streams>][-v<bool>][-c<bool>][-e<bool>][-q<depth>]\n"
+      "         [-r<bool>][-s<bool>][-t][-z]\n"
       "         [[-d<bus>:<address>] | [--device <bus>:<address>]]\n"
+      "         [--bench <file>]\n"
       "         [<input port>[ <output port>]]"
       "\n\n"
       "   --device   programmatically specify a particular USB device by bus\n"
       "              number and device address (see 'lsusb' output).\n"
+      "   --bench    write throughput and latency percentiles for each stream\n"
+      "              to the given file ('-' for stdout) in JSON format.\n"
       "\n\n"
       "  -c   check any retrieved data against expectations\n"
       "  -d   specify a particular USB device by bus number"
       " and device address\n"
+      "  -e   handle libusb events on a dedicated thread\n"
+      "  -q   number of transfers kept in flight in each direction,"
+      " per stream\n"
       "  -r   retrieve data from device\n"
       "  -s   send data to device\n"
       "  -t   use serial ports (ttyUSBx) in preference to libusb Bulk\n"
@@ -174,6 +186,33 @@ void ReportSyntax(void) {
       stderr);
 }
 
+// Write the benchmark results of all streams in JSON format.
+static bool WriteBench(const char *filename, uint8_t testNum,
+                       unsigned nstreams, uint64_t elapsed_time) {
+  FILE *out = stdout;
+  if (strcmp(filename, "-")) {
+    out = fopen(filename, "w");
+    if (!out) {
+      std::cerr << "ERROR: Unable to write '" << filename << "'" << std::endl;
+      return false;
+    }
+  }
+  fprintf(out,
+          "{\"test\": %u, \"queue_depth\": %u, \"event_thread\": %s, "
+          "\"elapsed_us\": %" PRIu64 ",\n \"streams\": [",
+          testNum, cfg.queue_depth, cfg.event_thread ? "true" : "false",
+          elapsed_time);
+  for (unsigned idx = 0U; idx < nstreams; idx++) {
+    fprintf(out, "%s\n  %s", idx ? "," : "",
+            streams[idx]->StatsJSON().c_str());
+  }
+  fputs("\n ]}\n", out);
+  if (out != stdout) {
+    fclose(out);
+  }
+  return true;
+}
+
 static int RunTest(USBDevice *dev, const char *in_port, const char *out_port) {
   // We need to modify the port names for each non-initial stream.
   char out_name[FILENAME_MAX];
@@ -292,6 +331,7 @@ static int RunTest(USBDevice *dev, const char *in_port, const char *out_port) {
         iso = new USBDevIso(dev, idx, transfer_bytes, cfg.retrieve, cfg.check,
                             cfg.send, cfg.verbose);
         if (iso) {
+          iso->SetQueueDepth(cfg.queue_depth);
           opened = iso->Open(idx);
           if (opened) {
             streams[idx] = iso;
@@ -308,6 +348,7 @@ static int RunTest(USBDevice *dev, const char *in_port, const char *out_port) {
         interrupt = new USBDevInt(dev, bulk, idx, transfer_bytes, cfg.retrieve,
                                   cfg.check, cfg.send, cfg.verbose);
         if (interrupt) {
+          interrupt->SetQueueDepth(cfg.queue_depth);
           opened = interrupt->Open(idx);
           if (opened) {
             streams[idx] = interrupt;
@@ -332,6 +373,19 @@ static int RunTest(USBDevice *dev, const char *in_port, const char *out_port) {
     }
   }
 
+  if (cfg.verbose) {
+    for (unsigned idx = 0U; idx < nstreams; idx++) {
+      std::cout << streams[idx]->Report();
+    }
+  }
+
+  // Transfer completions are handled on a dedicated thread, if requested, so
+  // that they are not delayed by the servicing of other streams.
+  if (cfg.event_thread && !dev->StartEventThread()) {
+    std::cerr << "Failed to start event thread" << std::endl;
+    return 4;
+  }
+
   std::cout << "Streaming..." << std::endl;
 
   // Times are in microseconds.
@@ -445,6 +499,7 @@ static int RunTest(USBDevice *dev, const char *in_port, const char *out_port) {
 
     // Tidy up if something went wrong.
     if (failed) {
+      dev->StopEventThread();
       for (unsigned idx = 0U; idx < nstreams; idx++) {
         (void)streams[idx]->Stop();
       }
@@ -468,17 +523,24 @@ static int RunTest(USBDevice *dev, const char *in_port, const char *out_port) {
   uint64_t elapsed_time = time_us() - start_time;
 
   // Report time elapsed from the start of data transfer.
+  dev->StopEventThread();
   for (unsigned idx = 0U; idx < nstreams; idx++) {
     streams[idx]->Stop();
   }
 
-  // TODO: introduce a crude estimate of the performance being achieved,
-  // for profiling the performance of IN and OUT traffic; totals and individual
-  // endpoints?
+  // Report the throughput and latency of IN and OUT traffic on each stream.
+  for (unsigned idx = 0U; idx < nstreams; idx++) {
+    std::cout << streams[idx]->Report(true, cfg.verbose);
+  }
+
   double elapsed_secs = elapsed_time / 1e6;
   printf("Test completed in %.2lf seconds (%" PRIu64 "us)\n", elapsed_secs,
          elapsed_time);
 
+  if (cfg.bench && !WriteBench(cfg.bench, testNum, nstreams, elapsed_time)) {
+    return 5;
+  }
+
   return 0;
 }
 
@@ -508,6 +570,21 @@ int main(int argc, char *argv[]) {
             return 7;
           }
           break;
+        case 'e':
+          cfg.event_thread = GetBool(&argv[i][2]);
+          break;
+        case 'q': {
+          const char *p = &argv[i][2];
+          uint8_t depth;
+          if (!GetByte(&p, depth) || *p != '\0' || !depth ||
+              depth > USBDevStream::kMaxQueueDepth) {
+            std::cerr << "ERROR: Invalid queue depth '" << argv[i] << "'"
+                      << std::endl;
+            ReportSyntax();
+            return 7;
+          }
+          cfg.queue_depth = depth;
+        } break;
         case 'r':
           cfg.retrieve = GetBool(&argv[i][2]);
           cfg.override_flags = true;
@@ -533,6 +610,9 @@ int main(int argc, char *argv[]) {
             if (GetDevice(argv[++i], busNumber, devAddress)) {
               break;
             }
+          } else if (!strcmp(&argv[i][2], "bench") && i < argc - 1) {
+            cfg.bench = argv[++i];
+            break;
           }
           // no break
         default:
@@ -30,7 +30,14 @@ struct TestConfig {
 #else
         serial(true),
 #endif
-        suspending(false) {
+        suspending(false),
+#if STREAMTEST_LIBUSB
+        event_thread(true),
+#else
+        event_thread(false),
+#endif
+        queue_depth(1U),
+        bench(nullptr) {
   }
   /**
    * Verbose logging/diagnostic reporting.
@@ -60,6 +67,18 @@ struct TestConfig {
    * Are we performing suspend-resume testing whilst streaming?
    */
   bool suspending;
+  /**
+   * Handle libusb events on a dedicated thread?
+   */
+  bool event_thread;
+  /**
+   * Number of transfers kept in flight in each direction, per stream.
+   */
+  unsigned queue_depth;
+  /**
+   * Benchmark results file ("-" for stdout), or nullptr if not benchmarking.
+   */
+  const char *bench;
 };
 
 // Has any data yet been received from the device?
@@ -41,6 +41,9 @@ bool USBDevice::Init(uint16_t vendorID, uint16_t productID, uint8_t devAddress,
 
 // Finalize use of the device.
 bool USBDevice::Fin() {
+#if STREAMTEST_LIBUSB
+  StopEventThread();
+#endif
   (void)Close();
 #if STREAMTEST_LIBUSB
   if (parenth_) {
@@ -229,6 +232,10 @@ bool USBDevice::Close() {
 
 bool USBDevice::Service() {
 #if STREAMTEST_LIBUSB
+  if (eventRun_) {
+    // Events are being handled by the dedicated thread.
+    return !eventFailed_;
+  }
   struct timeval tv = {0};
   int rc = libusb_handle_events_timeout(ctx_, &tv);
   if (rc < 0) {
@@ -238,6 +245,91 @@ bool USBDevice::Service() {
   return true;
 }
 
+bool USBDevice::StartEventThread() {
+#if STREAMTEST_LIBUSB
+  if (!eventRun_) {
+    eventFailed_ = false;
+    eventRun_ = true;
+    eventThread_ = std::thread(&USBDevice::EventThread, this);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void USBDevice::StopEventThread() {
+#if STREAMTEST_LIBUSB
+  if (eventRun_) {
+    eventRun_ = false;
+    eventThread_.join();
+  }
+#endif
+}
+
+#if STREAMTEST_LIBUSB
+// Body of the dedicated event-handling thread.
+void USBDevice::EventThread() {
+  while (eventRun_) {
+    struct timeval tv = {0, kEventTimeoutUs};
+    int rc = libusb_handle_events_timeout_completed(ctx_, &tv, nullptr);
+    if (rc < 0 && rc != LIBUSB_ERROR_INTERRUPTED) {
+      ErrorUSB("ERROR: Handling events", rc);
+      eventFailed_ = true;
+      break;
+    }
+  }
+}
+
+// Allocate a transfer descriptor together with a data buffer.
+USBDevice::Xfr *USBDevice::AllocXfr(void *owner, unsigned iso_packets,
+                                    size_t len) {
+  Xfr *x = new Xfr;
+  x->xfr = libusb_alloc_transfer((int)iso_packets);
+  if (!x->xfr) {
+    delete x;
+    return nullptr;
+  }
+  x->owner = owner;
+  x->len = len;
+  x->submitted = 0u;
+  x->devMem = false;
+  x->buf = nullptr;
+#if defined(LIBUSB_API_VERSION) && (LIBUSB_API_VERSION >= 0x01000105)
+  // Prefer memory that the kernel may use directly for DMA, avoiding a copy
+  // of the data on each transfer; not all platforms/drivers support this.
+  if (devh_) {
+    x->buf = libusb_dev_mem_alloc(devh_, len);
+    x->devMem = (x->buf != nullptr);
+  }
+#endif
+  if (!x->buf) {
+    x->buf = new uint8_t[len];
+  }
+  return x;
+}
+
+// Free a transfer descriptor and its data buffer.
+void USBDevice::FreeXfr(Xfr *x) {
+  if (!x) {
+    return;
+  }
+#if defined(LIBUSB_API_VERSION) && (LIBUSB_API_VERSION >= 0x01000105)
+  if (x->devMem) {
+    // Device memory can be released only whilst the device remains open.
+    if (devh_) {
+      libusb_dev_mem_free(devh_, x->buf, x->len);
+    }
+  } else
+#endif
+  {
+    delete[] x->buf;
+  }
+  libusb_free_transfer(x->xfr);
+  delete x;
+}
+#endif
+
 // Return the name of a test phase
 const char *USBDevice::PhaseName(usbdev_suspend_phase_t phase) {
   switch (phase) {
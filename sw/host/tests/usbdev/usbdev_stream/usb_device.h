@@ -3,13 +3,18 @@
 // SPDX-License-Identifier: Apache-2.0
 #ifndef OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USB_DEVICE_H_
 #define OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USB_DEVICE_H_
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 
 // The 'usbdev_serial' class may be used on platforms where libusb support is
 // not available; libusb is required to exercise Isochronous streams, Interrupt
 // streams and Control Transfers.
 #if STREAMTEST_LIBUSB
+#include <atomic>
 #include <libusb-1.0/libusb.h>
+#include <mutex>
+#include <thread>
 #endif
 
 class USBDevice {
@@ -20,7 +25,10 @@ class USBDevice {
         manual_(manual),
         state_(StateStreaming),
         ctx_(nullptr),
-        devh_(nullptr) {}
+        devh_(nullptr),
+        parenth_(nullptr),
+        eventRun_(false),
+        eventFailed_(false) {}
 #else
   USBDevice(bool verbose = false, bool manual = false)
       : verbose_(verbose),
@@ -133,6 +141,39 @@ class USBDevice {
   // Isochronous transfers; this may one day be increased.
   static constexpr unsigned kDevIsoMaxPacketSize = 0x40U;
 
+#if STREAMTEST_LIBUSB
+  /**
+   * Transfer descriptor with a pre-allocated data buffer, for use by streams
+   * that keep multiple transfers in flight.
+   */
+  struct Xfr {
+    /**
+     * libusb transfer descriptor; its `user_data` refers to this Xfr.
+     */
+    struct libusb_transfer *xfr;
+    /**
+     * Stream that owns this transfer.
+     */
+    void *owner;
+    /**
+     * Pre-allocated data buffer.
+     */
+    uint8_t *buf;
+    /**
+     * Size of the data buffer, in bytes.
+     */
+    size_t len;
+    /**
+     * Buffer was obtained from libusb_dev_mem_alloc.
+     */
+    bool devMem;
+    /**
+     * Time of submission, in microseconds.
+     */
+    uint64_t submitted;
+  };
+#endif
+
   /**
    * Initialize USB device before test; called once at startup.
    *
@@ -165,11 +206,27 @@ class USBDevice {
    */
   bool Close();
   /**
-   * Service the device; keep libusb transfers being processed.
+   * Service the device; keep libusb transfers being processed. If the
+   * dedicated event thread is running, this just reports its status.
    *
    * @return true iff the device is still operational.
    */
   bool Service();
+  /**
+   * Start a dedicated thread to handle libusb events, so that transfer
+   * completions are not delayed by the servicing of streams.
+   *
+   * Once started, stream state must be accessed only whilst holding the
+   * lock returned by Mutex(); transfer callbacks are invoked on the event
+   * thread.
+   *
+   * @return true iff the thread is running.
+   */
+  bool StartEventThread();
+  /**
+   * Stop the dedicated event thread, if running.
+   */
+  void StopEventThread();
 
 #if STREAMTEST_LIBUSB
   /**
@@ -290,6 +347,30 @@ class USBDevice {
   int CancelTransfer(struct libusb_transfer *xfr) const {
     return libusb_cancel_transfer(xfr);
   }
+  /**
+   * Allocate a transfer descriptor together with a data buffer; the buffer
+   * is DMA-able device memory where the platform supports it.
+   *
+   * @param  owner       Stream that shall own the transfer.
+   * @param  iso_packets Number of Isochronous packets.
+   * @param  len         Size of data buffer required, in bytes.
+   * @return Pointer to transfer, or nullptr if allocation failed.
+   */
+  Xfr *AllocXfr(void *owner, unsigned iso_packets, size_t len);
+  /**
+   * Free a transfer descriptor and its data buffer.
+   *
+   * @param  x       The transfer to be freed.
+   */
+  void FreeXfr(Xfr *x);
+  /**
+   * Return the lock that serializes stream servicing with transfer callbacks.
+   */
+  std::mutex &Mutex() { return lock_; }
+  /**
+   * Is the dedicated event thread running?
+   */
+  bool EventThreadRunning() const { return eventRun_; }
 #endif
   /**
    * Is test progress being directed/controlled manually?
@@ -426,6 +507,25 @@ class USBDevice {
 
   // Device descriptor.
   libusb_device_descriptor devDesc_;
+
+  // Body of the dedicated event-handling thread.
+  void EventThread();
+
+  // Dedicated event-handling thread.
+  std::thread eventThread_;
+
+  // Event thread shall keep running.
+  std::atomic<bool> eventRun_;
+
+  // Event thread encountered an error.
+  std::atomic<bool> eventFailed_;
+
+  // Serializes stream servicing with transfer callbacks.
+  std::mutex lock_;
+
+  // Timeout on each event handling call in the event thread; this bounds the
+  // time taken to stop the thread.
+  static constexpr unsigned kEventTimeoutUs = 10000u;
 #else
   // Device handle; just retain whether open/closed.
   bool devh_;
@@ -5,18 +5,23 @@
 
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 
 #include "usbdev_utils.h"
 
 // Stub callback function supplied to libusb.
 void LIBUSB_CALL USBDevInt::CbStubIN(struct libusb_transfer *xfr) {
-  USBDevInt *self = reinterpret_cast<USBDevInt *>(xfr->user_data);
-  self->CallbackIN(xfr);
+  USBDevice::Xfr *x = reinterpret_cast<USBDevice::Xfr *>(xfr->user_data);
+  USBDevInt *self = reinterpret_cast<USBDevInt *>(x->owner);
+  std::lock_guard<std::mutex> lock(self->dev_->Mutex());
+  self->CallbackIN(x);
 }
 
 void LIBUSB_CALL USBDevInt::CbStubOUT(struct libusb_transfer *xfr) {
-  USBDevInt *self = reinterpret_cast<USBDevInt *>(xfr->user_data);
-  self->CallbackOUT(xfr);
+  USBDevice::Xfr *x = reinterpret_cast<USBDevice::Xfr *>(xfr->user_data);
+  USBDevInt *self = reinterpret_cast<USBDevInt *>(x->owner);
+  std::lock_guard<std::mutex> lock(self->dev_->Mutex());
+  self->CallbackOUT(x);
 }
 
 bool USBDevInt::Open(unsigned interface) {
@@ -32,19 +37,53 @@ bool USBDevInt::Open(unsigned interface) {
   epOut_ = interface + 1U;
   epIn_ = 0x80U | epOut_;
 
-  // No transfers in progress.
-  xfrIn_ = nullptr;
-
-  xfrOut_ = nullptr;
-
   maxPacketSize_ = USBDevice::kDevDataMaxPacketSize;
 
+  // Allocate the transfers; none is yet in progress.
+  return AllocXfrs();
+}
+
+bool USBDevInt::AllocXfrs() {
+  for (unsigned idx = 0U; idx < depth_; idx++) {
+    USBDevice::Xfr *in = dev_->AllocXfr(this, 0U, maxPacketSize_);
+    USBDevice::Xfr *out = dev_->AllocXfr(this, 0U, kOutXfrSize);
+    if (!in || !out) {
+      dev_->FreeXfr(in);
+      dev_->FreeXfr(out);
+      FreeXfrs();
+      return false;
+    }
+    freeIn_.push_back(in);
+    freeOut_.push_back(out);
+  }
+  inFlightIn_ = 0U;
+  inFlightOut_ = 0U;
+  inRequested_ = 0U;
   return true;
 }
 
+void USBDevInt::FreeXfrs() {
+  assert(!inFlightIn_ && !inFlightOut_);
+  for (USBDevice::Xfr *x : freeIn_) {
+    dev_->FreeXfr(x);
+  }
+  for (USBDevice::Xfr *x : freeOut_) {
+    dev_->FreeXfr(x);
+  }
+  freeIn_.clear();
+  freeOut_.clear();
+}
+
+bool USBDevInt::Busy() {
+  std::lock_guard<std::mutex> lock(dev_->Mutex());
+  return inFlightIn_ || inFlightOut_;
+}
+
 void USBDevInt::Stop() {
   SetClosing(true);
 
+  // Note: any transfers still in flight are not freed because the test is
+  // terminating.
   int rc = dev_->ReleaseInterface(interface_);
   if (rc < 0) {
     std::cerr << "" << std::endl;
@@ -57,13 +96,16 @@ void USBDevInt::Pause() {
   if (verbose_) {
     std::cout << PrefixID() << "waiting to close" << std::endl;
   }
-  while (inActive_ || outActive_) {
+  while (Busy()) {
     dev_->Service();
   }
   if (verbose_) {
     std::cout << PrefixID() << " closed" << std::endl;
   }
 
+  // Device memory buffers do not survive the device being closed.
+  FreeXfrs();
+
   int rc = dev_->ReleaseInterface(interface_);
   if (rc < 0) {
     std::cerr << "" << std::endl;
@@ -77,11 +119,17 @@ bool USBDevInt::Resume() {
   if (rc < 0) {
     return dev_->ErrorUSB("ERROR: Claiming interface", rc);
   }
-  return true;
+  return AllocXfrs();
 }
 
 // Return a summary report of the stream settings of status.
-std::string USBDevInt::Report(bool status, bool verbose) const { return ""; }
+std::string USBDevInt::Report(bool status, bool verbose) const {
+  if (status) {
+    return StatsReport(verbose);
+  }
+  return PrefixID() + (bulk_ ? "Bulk" : "Interrupt") + " depth " +
+         std::to_string(depth_) + "\n";
+}
 
 void USBDevInt::DumpIntTransfer(struct libusb_transfer *xfr) const {
   const void *buf = reinterpret_cast<void *>(xfr->buffer);
@@ -92,38 +140,42 @@ void USBDevInt::DumpIntTransfer(struct libusb_transfer *xfr) const {
 
 // Retrieving of IN traffic from device.
 bool USBDevInt::ServiceIN() {
-  // Ensure that we have enough space available for a full packet; the device
-  // software decides upon the length of each packet.
-  uint8_t *space;
-  bool ok = ProvisionSpace(&space, maxPacketSize_);
-  if (ok) {
-    uint32_t to_fetch = maxPacketSize_;
-    if (to_fetch > transfer_bytes_ - bytes_recvd_) {
-      to_fetch = transfer_bytes_ - bytes_recvd_;
+  while (!freeIn_.empty() && CanSchedule()) {
+    // Ensure that there will be enough space in the circular buffer for a full
+    // packet from each of the IN transfers in flight; the device software
+    // decides upon the length of each packet. Allow for the circular buffer
+    // wrapping early.
+    if (FreeSpace() < (inFlightIn_ + 2U) * maxPacketSize_) {
+      break;
     }
 
-    if (!xfrIn_) {
-      xfrIn_ = dev_->AllocTransfer(0U);
-      if (!xfrIn_) {
-        return false;
-      }
+    // Do not request more data than remains to be transferred.
+    uint32_t pending = bytes_recvd_ + inRequested_;
+    uint32_t to_fetch = maxPacketSize_;
+    if (pending >= transfer_bytes_) {
+      break;
+    }
+    if (to_fetch > transfer_bytes_ - pending) {
+      to_fetch = transfer_bytes_ - pending;
     }
 
+    USBDevice::Xfr *x = freeIn_.back();
     if (bulk_) {
-      dev_->FillBulkTransfer(xfrIn_, epIn_, space, to_fetch, CbStubIN, this,
+      dev_->FillBulkTransfer(x->xfr, epIn_, x->buf, to_fetch, CbStubIN, x,
                              kDataTimeout);
     } else {
-      dev_->FillIntTransfer(xfrIn_, epIn_, space, to_fetch, CbStubIN, this,
+      dev_->FillIntTransfer(x->xfr, epIn_, x->buf, to_fetch, CbStubIN, x,
                             kDataTimeout);
     }
 
-    int rc = dev_->SubmitTransfer(xfrIn_);
+    x->submitted = time_us();
+    int rc = dev_->SubmitTransfer(x->xfr);
     if (rc < 0) {
       return dev_->ErrorUSB("ERROR: Submitting IN transfer", rc);
     }
-    inActive_ = true;
-  } else {
-    inActive_ = false;
+    freeIn_.pop_back();
+    inRequested_ += to_fetch;
+    StatsSubmit(statsIn_, ++inFlightIn_);
   }
 
   return true;
@@ -131,35 +183,39 @@ bool USBDevInt::ServiceIN() {
 
 // Sending of OUT traffic to device.
 bool USBDevInt::ServiceOUT() {
-  // Do we have any data ready to send?
-  uint8_t *data;
-  uint32_t num_bytes = DataAvailable(&data);
-  if (num_bytes > 0U) {
-    // Supply details of the single OUT packet.
-    if (!xfrOut_) {
-      xfrOut_ = dev_->AllocTransfer(0U);
-      if (!xfrOut_) {
-        // Stream is not operational.
-        return false;
-      }
+  while (!freeOut_.empty() && CanSchedule()) {
+    // Do we have any data ready to send?
+    uint8_t *data;
+    uint32_t num_bytes = DataAvailable(&data);
+    if (!num_bytes) {
+      // Nothing to propagate at this time.
+      break;
+    }
+
+    // Copy the data into the transfer buffer, releasing the space in the
+    // circular buffer for further IN traffic.
+    USBDevice::Xfr *x = freeOut_.back();
+    if (num_bytes > x->len) {
+      num_bytes = (uint32_t)x->len;
     }
+    memcpy(x->buf, data, num_bytes);
+    DiscardData(num_bytes);
 
     if (bulk_) {
-      dev_->FillBulkTransfer(xfrOut_, epOut_, data, num_bytes, CbStubOUT, this,
+      dev_->FillBulkTransfer(x->xfr, epOut_, x->buf, num_bytes, CbStubOUT, x,
                              kDataTimeout);
     } else {
-      dev_->FillIntTransfer(xfrOut_, epOut_, data, num_bytes, CbStubOUT, this,
+      dev_->FillIntTransfer(x->xfr, epOut_, x->buf, num_bytes, CbStubOUT, x,
                             kDataTimeout);
     }
 
-    int rc = dev_->SubmitTransfer(xfrOut_);
+    x->submitted = time_us();
+    int rc = dev_->SubmitTransfer(x->xfr);
     if (rc < 0) {
       return dev_->ErrorUSB("ERROR: Submitting OUT transfer", rc);
     }
-    outActive_ = true;
-  } else {
-    // Nothing to propagate at this time.
-    outActive_ = false;
+    freeOut_.pop_back();
+    StatsSubmit(statsOut_, ++inFlightOut_);
   }
   // Stream remains operational, even if it presently has no work on the OUT
   // side.
@@ -167,23 +223,32 @@ bool USBDevInt::ServiceOUT() {
 }
 
 bool USBDevInt::Service() {
+  std::lock_guard<std::mutex> lock(dev_->Mutex());
   if (failed_) {
     return false;
   }
-  // (Re)start IN traffic if not already in progress.
-  if (!inActive_ && !ServiceIN()) {
+  // Keep as many IN transfers in flight as we can.
+  if (!ServiceIN()) {
     return false;
   }
-  // (Re)start OUT traffic if not already in progress and there is
-  // data available to be transmitted.
-  if (!outActive_ && !ServiceOUT()) {
+  // Keep OUT transfers in flight whilst there is data available to be
+  // transmitted.
+  if (!ServiceOUT()) {
     return false;
   }
   return true;
 }
 
 // Callback function supplied to libusb for IN transfers.
-void USBDevInt::CallbackIN(struct libusb_transfer *xfr) {
+void USBDevInt::CallbackIN(USBDevice::Xfr *x) {
+  struct libusb_transfer *xfr = x->xfr;
+
+  // This transfer is no longer in flight.
+  assert(inFlightIn_ > 0U);
+  inFlightIn_--;
+  inRequested_ -= xfr->length;
+  freeIn_.push_back(x);
+
   if (xfr->status != LIBUSB_TRANSFER_COMPLETED) {
     std::cerr << PrefixID() << " Invalid/unexpected IN transfer status "
               << xfr->status << std::endl;
@@ -198,13 +263,12 @@ void USBDevInt::CallbackIN(struct libusb_transfer *xfr) {
     DumpIntTransfer(xfr);
   }
 
+  StatsRecord(statsIn_, xfr->actual_length, x->submitted);
+
   // Collect and parse signature bytes at the start of the IN stream.
   uint8_t *dp = xfr->buffer;
   int nrecvd = xfr->actual_length;
 
-  // Update the circular buffer with the amount of data that we've received
-  CommitData(nrecvd);
-
   if (!SigReceived()) {
     if (nrecvd > 0 && !SigReceived()) {
       uint32_t dropped = SigDetect(&sig_, dp, (uint32_t)nrecvd);
@@ -220,10 +284,6 @@ void USBDevInt::CallbackIN(struct libusb_transfer *xfr) {
       // are additional bytes we may process them.
       nrecvd = ((uint32_t)nrecvd > dropped) ? ((uint32_t)nrecvd - dropped) : 0;
       dp += dropped;
-
-      if (dropped) {
-        DiscardData(dropped);
-      }
     }
   }
 
@@ -232,22 +292,36 @@ void USBDevInt::CallbackIN(struct libusb_transfer *xfr) {
     // Check the received LFSR-generated byte(s) and combine them with the
     // output of our host-side LFSR.
     ok = ProcessData(dp, nrecvd);
+
+    // Update the circular buffer with the data that we've received; space was
+    // reserved when the transfer was submitted.
+    uint8_t *space;
+    if (ok && ProvisionSpace(&space, nrecvd)) {
+      memcpy(space, dp, nrecvd);
+      CommitData(nrecvd);
+    } else if (ok) {
+      std::cerr << PrefixID() << " Circular buffer overflow" << std::endl;
+      ok = false;
+    }
   }
 
   if (ok) {
-    if (CanSchedule()) {
-      // Attempt to set up another IN transfer.
-      failed_ = !ServiceIN();
-    } else {
-      inActive_ = false;
-    }
+    // Attempt to set up another IN transfer.
+    failed_ = !ServiceIN();
   } else {
     failed_ = true;
   }
 }
 
 // Callback function supplied to libusb for OUT transfers.
-void USBDevInt::CallbackOUT(struct libusb_transfer *xfr) {
+void USBDevInt::CallbackOUT(USBDevice::Xfr *x) {
+  struct libusb_transfer *xfr = x->xfr;
+
+  // This transfer is no longer in flight.
+  assert(inFlightOut_ > 0U);
+  inFlightOut_--;
+  freeOut_.push_back(x);
+
   if (xfr->status != LIBUSB_TRANSFER_COMPLETED) {
     std::cerr << PrefixID() << " Invalid/unexpected OUT transfer status "
               << xfr->status << std::endl;
@@ -264,12 +338,9 @@ void USBDevInt::CallbackOUT(struct libusb_transfer *xfr) {
 
   // Note: we're not expecting any truncation on OUT transfers.
   assert(xfr->actual_length == xfr->length);
-  ConsumeData(xfr->actual_length);
+  bytes_sent_ += xfr->actual_length;
+  StatsRecord(statsOut_, xfr->actual_length, x->submitted);
 
-  if (CanSchedule()) {
-    // Attempt to set up another OUT transfer.
-    failed_ = !ServiceOUT();
-  } else {
-    outActive_ = false;
-  }
+  // Attempt to set up another OUT transfer.
+  failed_ = !ServiceOUT();
 }
@@ -4,6 +4,7 @@
 #ifndef OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USBDEV_INT_H_
 #define OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USBDEV_INT_H_
 #include <queue>
+#include <vector>
 
 #include "usb_device.h"
 #include "usbdev_stream.h"
@@ -21,10 +22,9 @@ class USBDevInt : public USBDevStream {
         dev_(dev),
         bulk_(bulk),
         failed_(false),
-        inActive_(false),
-        outActive_(false),
-        xfrIn_(nullptr),
-        xfrOut_(nullptr) {}
+        inFlightIn_(0U),
+        inFlightOut_(0U),
+        inRequested_(0U) {}
   /**
    * Open an Interrupt connection to specified device interface.
    *
@@ -52,6 +52,12 @@ class USBDevInt : public USBDevStream {
    * @return Status report
    */
   virtual std::string Report(bool status = false, bool verbose = false) const;
+  /**
+   * Return the implementation type of this stream.
+   */
+  virtual StreamType Type() const {
+    return bulk_ ? StreamType_Bulk : StreamType_Interrupt;
+  }
   /**
    * Service this Interrupt stream.
    *
@@ -60,6 +66,22 @@ class USBDevInt : public USBDevStream {
   virtual bool Service();
 
  private:
+  /**
+   * Allocate the IN and OUT transfers, according to the queue depth.
+   *
+   * @return true iff the transfers were allocated successfully.
+   */
+  bool AllocXfrs();
+  /**
+   * Free all IN and OUT transfers; none may be in flight.
+   */
+  void FreeXfrs();
+  /**
+   * Indicates whether any transfers are in flight.
+   *
+   * @return true iff one or more transfers are in flight.
+   */
+  bool Busy();
   /**
    * Diagnostic utility function to display the content of libusb Bulk/Interrupt
    * transfer.
@@ -68,13 +90,15 @@ class USBDevInt : public USBDevStream {
    */
   void DumpIntTransfer(struct libusb_transfer *xfr) const;
   /**
-   * Retrieving of IN traffic from device.
+   * Retrieving of IN traffic from device; submits IN transfers until the
+   * queue depth is reached or buffer space is exhausted.
    *
    * @return true iff the stream is still operational.
    */
   bool ServiceIN();
   /**
-   * Sending of OUT traffic to device.
+   * Sending of OUT traffic to device; submits OUT transfers until the queue
+   * depth is reached or there is no more data to be sent.
    *
    * @return true iff the stream is still operational.
    */
@@ -83,16 +107,16 @@ class USBDevInt : public USBDevStream {
    * Callback function supplied to libusb for IN transfers; transfer has
    * completed and requires attention.
    *
-   * @param  xfr     The transfer that has completed.
+   * @param  x       The transfer that has completed.
    */
-  void CallbackIN(struct libusb_transfer *xfr);
+  void CallbackIN(USBDevice::Xfr *x);
   /**
    * Callback function supplied to libusb for OUT transfers; transfer has
    * completed and requires attention.
    *
-   * @param  xfr     The transfer that has completed.
+   * @param  x       The transfer that has completed.
    */
-  void CallbackOUT(struct libusb_transfer *xfr);
+  void CallbackOUT(USBDevice::Xfr *x);
   /**
    * Stub callback function supplied to libusb for IN transfers.
    *
@@ -118,17 +142,20 @@ class USBDevInt : public USBDevStream {
   // Has this stream experienced a failure?
   bool failed_;
 
-  // Is an IN transfer in progress?
-  bool inActive_;
+  // IN transfers not presently in flight.
+  std::vector<USBDevice::Xfr *> freeIn_;
+
+  // OUT transfers not presently in flight.
+  std::vector<USBDevice::Xfr *> freeOut_;
 
-  // Is an OUT transfer in progress?
-  bool outActive_;
+  // Number of IN transfers in flight.
+  unsigned inFlightIn_;
 
-  // Do we currently have an IN transfer?
-  struct libusb_transfer *xfrIn_;
+  // Number of OUT transfers in flight.
+  unsigned inFlightOut_;
 
-  // Do we currently have an OUT transfer?
-  struct libusb_transfer *xfrOut_;
+  // Number of bytes requested by the IN transfers in flight.
+  uint32_t inRequested_;
 
   // Maximum packet size for this stream.
   uint8_t maxPacketSize_;
@@ -145,6 +172,9 @@ class USBDevInt : public USBDevStream {
   // No timeout at present; the device-side code is responsible for signaling
   // test completion/failure. This may need to change for CI tests.
   static constexpr unsigned kDataTimeout = 0U;
+
+  // Size of the data buffer of each OUT transfer.
+  static constexpr unsigned kOutXfrSize = 0x400U;
 };
 
 #endif  // OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USBDEV_INT_H_
@@ -5,18 +5,23 @@
 
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 
 #include "usbdev_utils.h"
 
 // Stub callback function supplied to libusb.
 void LIBUSB_CALL USBDevIso::CbStubIN(struct libusb_transfer *xfr) {
-  USBDevIso *self = reinterpret_cast<USBDevIso *>(xfr->user_data);
-  self->CallbackIN(xfr);
+  USBDevice::Xfr *x = reinterpret_cast<USBDevice::Xfr *>(xfr->user_data);
+  USBDevIso *self = reinterpret_cast<USBDevIso *>(x->owner);
+  std::lock_guard<std::mutex> lock(self->dev_->Mutex());
+  self->CallbackIN(x);
 }
 
 void LIBUSB_CALL USBDevIso::CbStubOUT(struct libusb_transfer *xfr) {
-  USBDevIso *self = reinterpret_cast<USBDevIso *>(xfr->user_data);
-  self->CallbackOUT(xfr);
+  USBDevice::Xfr *x = reinterpret_cast<USBDevice::Xfr *>(xfr->user_data);
+  USBDevIso *self = reinterpret_cast<USBDevIso *>(x->owner);
+  std::lock_guard<std::mutex> lock(self->dev_->Mutex());
+  self->CallbackOUT(x);
 }
 
 bool USBDevIso::Open(unsigned interface) {
@@ -32,22 +37,57 @@ bool USBDevIso::Open(unsigned interface) {
   epOut_ = interface + 1U;
   epIn_ = 0x80U | epOut_;
 
-  // No transfers in progress.
-  xfrIn_ = nullptr;
-  xfrOut_ = nullptr;
-
   // Expected sequence number of first packet.
   tst_seq_ = 0U;
 
   // Maximum size of a packet in bytes.
   maxPacketSize_ = USBDevice::kDevIsoMaxPacketSize;
 
+  // Allocate the transfers; none is yet in progress.
+  return AllocXfrs();
+}
+
+bool USBDevIso::AllocXfrs() {
+  for (unsigned idx = 0U; idx < depth_; idx++) {
+    USBDevice::Xfr *in = dev_->AllocXfr(this, kNumIsoPackets, maxPacketSize_);
+    USBDevice::Xfr *out = dev_->AllocXfr(this, kNumIsoPackets, maxPacketSize_);
+    if (!in || !out) {
+      dev_->FreeXfr(in);
+      dev_->FreeXfr(out);
+      FreeXfrs();
+      return false;
+    }
+    freeIn_.push_back(in);
+    freeOut_.push_back(out);
+  }
+  inFlightIn_ = 0U;
+  inFlightOut_ = 0U;
   return true;
 }
 
+void USBDevIso::FreeXfrs() {
+  assert(!inFlightIn_ && !inFlightOut_);
+  for (USBDevice::Xfr *x : freeIn_) {
+    dev_->FreeXfr(x);
+  }
+  for (USBDevice::Xfr *x : freeOut_) {
+    dev_->FreeXfr(x);
+  }
+  freeIn_.clear();
+  freeOut_.clear();
+}
+
+bool USBDevIso::Busy() {
+  std::lock_guard<std::mutex> lock(dev_->Mutex());
+  return inFlightIn_ || inFlightOut_;
+}
+
 void USBDevIso::Stop() {
   SetClosing(true);
 
+  // Note: any transfers still in flight are not freed because the test is
+  // terminating.
+
   int rc = dev_->ReleaseInterface(interface_);
   if (rc < 0) {
     std::cerr << "" << std::endl;
@@ -57,10 +97,13 @@ void USBDevIso::Stop() {
 void USBDevIso::Pause() {
   SetClosing(true);
 
-  while (inActive_ || outActive_) {
+  while (Busy()) {
     dev_->Service();
   }
 
+  // Device memory buffers do not survive the device being closed.
+  FreeXfrs();
+
   int rc = dev_->ReleaseInterface(interface_);
   if (rc < 0) {
     std::cerr << "" << std::endl;
@@ -74,7 +117,7 @@ bool USBDevIso::Resume() {
   if (rc < 0) {
     return dev_->ErrorUSB("ERROR: Claiming interface", rc);
   }
-  return true;
+  return AllocXfrs();
 }
 
 // Return an indication of whether this stream has completed its transfer.
@@ -89,11 +132,16 @@ bool USBDevIso::Completed() const {
 }
 
 // Return a summary report of the stream settings of status.
-std::string USBDevIso::Report(bool status, bool verbose) const { return ""; }
+std::string USBDevIso::Report(bool status, bool verbose) const {
+  if (status) {
+    return StatsReport(verbose);
+  }
+  return PrefixID() + "Isochronous depth " + std::to_string(depth_) + "\n";
+}
 
 void USBDevIso::DumpIsoTransfer(struct libusb_transfer *xfr) const {
   for (int idx = 0U; idx < xfr->num_iso_packets; idx++) {
-    struct libusb_iso_packet_descriptor *pack = &xfrIn_->iso_packet_desc[idx];
+    struct libusb_iso_packet_descriptor *pack = &xfr->iso_packet_desc[idx];
     std::cout << "Requested " << pack->length << " actual "
               << pack->actual_length << std::endl;
     // Buffer dumping works only because we have just a single Iso packet per
@@ -104,29 +152,27 @@ void USBDevIso::DumpIsoTransfer(struct libusb_transfer *xfr) const {
 
 // Retrieving of IN traffic from device.
 bool USBDevIso::ServiceIN() {
-  // Ensure that we have enough space available for a full packet; the device
-  // software decides upon the length of each packet.
-  uint8_t *space;
-  bool ok = ProvisionSpace(&space, maxPacketSize_);
-  if (ok) {
-    if (!xfrIn_) {
-      xfrIn_ = dev_->AllocTransfer(kNumIsoPackets);
-      if (!xfrIn_) {
-        return false;
-      }
+  while (!freeIn_.empty() && CanSchedule()) {
+    // Ensure that there will be enough space in the circular buffer for a full
+    // packet from each of the IN transfers in flight; the device software
+    // decides upon the length of each packet. Allow for the circular buffer
+    // wrapping early.
+    if (FreeSpace() < (inFlightIn_ + 2U) * maxPacketSize_) {
+      break;
     }
 
-    dev_->FillIsoTransfer(xfrIn_, epIn_, space, maxPacketSize_, kNumIsoPackets,
-                          CbStubIN, this, kIsoTimeout);
-    dev_->SetIsoPacketLengths(xfrIn_, maxPacketSize_);
+    USBDevice::Xfr *x = freeIn_.back();
+    dev_->FillIsoTransfer(x->xfr, epIn_, x->buf, maxPacketSize_,
+                          kNumIsoPackets, CbStubIN, x, kIsoTimeout);
+    dev_->SetIsoPacketLengths(x->xfr, maxPacketSize_);
 
-    int rc = dev_->SubmitTransfer(xfrIn_);
+    x->submitted = time_us();
+    int rc = dev_->SubmitTransfer(x->xfr);
     if (rc < 0) {
       return dev_->ErrorUSB("ERROR: Submitting IN transfer", rc);
     }
-    inActive_ = true;
-  } else {
-    inActive_ = false;
+    freeIn_.pop_back();
+    StatsSubmit(statsIn_, ++inFlightIn_);
   }
   return true;
 }
@@ -134,10 +180,7 @@ bool USBDevIso::ServiceIN() {
 // Sending of OUT traffic to device.
 bool USBDevIso::ServiceOUT() {
   // Do we have one or more packets ready for sending?
-  if (pktLen_.empty()) {
-    // Nothing to propagate at this time.
-    outActive_ = false;
-  } else {
+  while (!pktLen_.empty() && !freeOut_.empty() && CanSchedule()) {
     uint32_t len = pktLen_.front();
     pktLen_.pop();
     // We should have propagated only valid packets to the OUT side ready for
@@ -149,23 +192,25 @@ bool USBDevIso::ServiceOUT() {
     assert(num_bytes >= len);
     (void)num_bytes;
 
+    // Copy the packet into the transfer buffer, releasing the space in the
+    // circular buffer for further IN traffic.
+    USBDevice::Xfr *x = freeOut_.back();
+    assert(len <= x->len);
+    memcpy(x->buf, data, len);
+    DiscardData(len);
+
     // Supply details of the single OUT packet.
-    if (!xfrOut_) {
-      xfrOut_ = dev_->AllocTransfer(kNumIsoPackets);
-      if (!xfrOut_) {
-        // Stream is not operational.
-        return false;
-      }
-    }
-    dev_->FillIsoTransfer(xfrOut_, epOut_, data, len, kNumIsoPackets, CbStubOUT,
-                          this, kIsoTimeout);
-    dev_->SetIsoPacketLengths(xfrOut_, len);
+    dev_->FillIsoTransfer(x->xfr, epOut_, x->buf, len, kNumIsoPackets,
+                          CbStubOUT, x, kIsoTimeout);
+    dev_->SetIsoPacketLengths(x->xfr, len);
 
-    int rc = dev_->SubmitTransfer(xfrOut_);
+    x->submitted = time_us();
+    int rc = dev_->SubmitTransfer(x->xfr);
     if (rc < 0) {
       return dev_->ErrorUSB("ERROR: Submitting OUT transfer", rc);
     }
-    outActive_ = true;
+    freeOut_.pop_back();
+    StatsSubmit(statsOut_, ++inFlightOut_);
   }
   // Stream remains operational, even if it presently has no work on the OUT
   // side.
@@ -173,23 +218,31 @@ bool USBDevIso::ServiceOUT() {
 }
 
 bool USBDevIso::Service() {
+  std::lock_guard<std::mutex> lock(dev_->Mutex());
   if (failed_) {
     return false;
   }
-  // (Re)start Isochronous IN traffic if not already in progress.
-  if (!inActive_ && !ServiceIN()) {
+  // Keep as many Isochronous IN transfers in flight as we can.
+  if (!ServiceIN()) {
     return false;
   }
-  // (Re)start Isochronous OUT traffic if not already in progress and there is
-  // data available to be transmitted.
-  if (!outActive_ && !ServiceOUT()) {
+  // Keep Isochronous OUT transfers in flight whilst there are packets
+  // available to be transmitted.
+  if (!ServiceOUT()) {
     return false;
   }
   return true;
 }
 
 // Callback function supplied to libusb for IN transfers.
-void USBDevIso::CallbackIN(struct libusb_transfer *xfr) {
+void USBDevIso::CallbackIN(USBDevice::Xfr *x) {
+  struct libusb_transfer *xfr = x->xfr;
+
+  // This transfer is no longer in flight.
+  assert(inFlightIn_ > 0U);
+  inFlightIn_--;
+  freeIn_.push_back(x);
+
   if (xfr->status != LIBUSB_TRANSFER_COMPLETED) {
     std::cerr << PrefixID() << " Invalid/unexpected IN transfer status "
               << xfr->status << std::endl;
@@ -208,10 +261,12 @@ void USBDevIso::CallbackIN(struct libusb_transfer *xfr) {
     if (pack->status != LIBUSB_TRANSFER_COMPLETED) {
       std::cerr << "ERROR: pack " << idx << " status " << pack->status
                 << std::endl;
-      inActive_ = false;
+      failed_ = true;
       return;
     }
 
+    StatsRecord(statsIn_, pack->actual_length, x->submitted);
+
     if (pack->actual_length) {
       // Reset signature detection, because a new signature is included at the
       // start of each Isochronous packet.
@@ -230,7 +285,6 @@ void USBDevIso::CallbackIN(struct libusb_transfer *xfr) {
         // Valid packet received; payload includes the signature which we
         // retain and propagate to the caller to permit synchronization.
         uint32_t payload = pack->actual_length - dropped;
-        pktLen_.push(payload);
 
         // Since packets may have been dropped we must use the supplied values
         // of the device-side LFSR
@@ -240,14 +294,14 @@ void USBDevIso::CallbackIN(struct libusb_transfer *xfr) {
             std::cerr << "ERROR: Unexpected device-side LFSR value (expected 0x"
                       << std::hex << tst_lfsr_ << " received 0x"
                       << sig.init_lfsr << ")" << std::dec << std::endl;
-            inActive_ = false;
+            failed_ = true;
             return;
           }
         } else if (seq < tst_seq_) {
           std::cerr << "ERROR: Iso stream packets out of order (expected seq 0x"
                     << std::hex << tst_seq_ << " received 0x" << seq << ")"
                     << std::dec << std::endl;
-          inActive_ = false;
+          failed_ = true;
           return;
         } else {
           // One or more packets has disappeared; use the supplied LFSR to
@@ -265,7 +319,18 @@ void USBDevIso::CallbackIN(struct libusb_transfer *xfr) {
         dp[offsetof(usbdev_stream_sig_t, init_lfsr)] = dpi_lfsr_;
         ProcessData(dp + sig_size, payload - sig_size);
 
-        CommitData(payload);
+        // Update the circular buffer with the packet; space was reserved when
+        // the transfer was submitted.
+        uint8_t *space;
+        if (ProvisionSpace(&space, payload)) {
+          memcpy(space, dp, payload);
+          CommitData(payload);
+          pktLen_.push(payload);
+        } else {
+          std::cerr << PrefixID() << " Circular buffer overflow" << std::endl;
+          failed_ = true;
+          return;
+        }
       } else {
         std::cerr << PrefixID() << " received invalid Iso packet of "
                   << pack->actual_length << " bytes" << std::endl;
@@ -273,16 +338,19 @@ void USBDevIso::CallbackIN(struct libusb_transfer *xfr) {
     }
   }
 
-  if (CanSchedule()) {
-    // Attempt to set up another IN transfer.
-    failed_ = !ServiceIN();
-  } else {
-    inActive_ = false;
-  }
+  // Attempt to set up another IN transfer.
+  failed_ = !ServiceIN();
 }
 
 // Callback function supplied to libusb for OUT transfers.
-void USBDevIso::CallbackOUT(struct libusb_transfer *xfr) {
+void USBDevIso::CallbackOUT(USBDevice::Xfr *x) {
+  struct libusb_transfer *xfr = x->xfr;
+
+  // This transfer is no longer in flight.
+  assert(inFlightOut_ > 0U);
+  inFlightOut_--;
+  freeOut_.push_back(x);
+
   if (xfr->status != LIBUSB_TRANSFER_COMPLETED) {
     std::cerr << PrefixID() << " Invalid/unexpected OUT transfer status "
               << xfr->status << std::endl;
@@ -302,20 +370,16 @@ void USBDevIso::CallbackOUT(struct libusb_transfer *xfr) {
     if (pack->status != LIBUSB_TRANSFER_COMPLETED) {
       std::cout << "ERROR: pack " << idx << " status " << pack->status
                 << std::endl;
-      outActive_ = false;
       exit(0);
       return;
     }
 
     if (pack->actual_length) {
-      ConsumeData(pack->actual_length);
+      bytes_sent_ += pack->actual_length;
     }
+    StatsRecord(statsOut_, pack->actual_length, x->submitted);
   }
 
-  if (CanSchedule()) {
-    // Attempt to set up another OUT transfer.
-    failed_ = !ServiceOUT();
-  } else {
-    outActive_ = false;
-  }
+  // Attempt to set up another OUT transfer.
+  failed_ = !ServiceOUT();
 }
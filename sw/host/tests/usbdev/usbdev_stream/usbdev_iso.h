@@ -4,6 +4,7 @@
 #ifndef OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USBDEV_ISO_H_
 #define OPENTITAN_SW_HOST_TESTS_USBDEV_USBDEV_STREAM_USBDEV_ISO_H_
 #include <queue>
+#include <vector>
 
 #include "usb_device.h"
 #include "usbdev_stream.h"
@@ -15,10 +16,8 @@ class USBDevIso : public USBDevStream {
       : USBDevStream(id, transfer_bytes, retrieve, check, send, verbose),
         dev_(dev),
         failed_(false),
-        inActive_(false),
-        outActive_(false),
-        xfrIn_(nullptr),
-        xfrOut_(nullptr) {}
+        inFlightIn_(0U),
+        inFlightOut_(0U) {}
   /**
    * Open an Isochronous connection to specified device interface.
    *
@@ -46,6 +45,10 @@ class USBDevIso : public USBDevStream {
    * @return Status report.
    */
   virtual std::string Report(bool status = false, bool verbose = false) const;
+  /**
+   * Return the implementation type of this stream.
+   */
+  virtual StreamType Type() const { return StreamType_Isochronous; }
   /**
    * Indicates whether this stream has completed its transfer.
    *
@@ -60,6 +63,22 @@ class USBDevIso : public USBDevStream {
   virtual bool Service();
 
  private:
+  /**
+   * Allocate the IN and OUT transfers, according to the queue depth.
+   *
+   * @return true iff the transfers were allocated successfully.
+   */
+  bool AllocXfrs();
+  /**
+   * Free all IN and OUT transfers; none may be in flight.
+   */
+  void FreeXfrs();
+  /**
+   * Indicates whether any transfers are in flight.
+   *
+   * @return true iff one or more transfers are in flight.
+   */
+  bool Busy();
   /**
    * Diagnostic utility function to display the content of libusb Iso transfer.
    *
@@ -67,13 +86,15 @@ class USBDevIso : public USBDevStream {
    */
   void DumpIsoTransfer(struct libusb_transfer *xfr) const;
   /**
-   * Retrieving of IN traffic from device.
+   * Retrieving of IN traffic from device; submits IN transfers until the
+   * queue depth is reached or buffer space is exhausted.
    *
    * @return true iff the stream is still operational.
    */
   bool ServiceIN();
   /**
-   * Sending of OUT traffic to device.
+   * Sending of OUT traffic to device; submits OUT transfers until the queue
+   * depth is reached or there are no more packets to be sent.
    *
    * @return true iff the stream is still operational.
    */
@@ -82,16 +103,16 @@ class USBDevIso : public USBDevStream {
    * Callback function supplied to libusb for IN transfers; transfer has
    * completed and requires attention.
    *
-   * @param  xfr     The transfer that has completed.
+   * @param  x       The transfer that has completed.
    */
-  void CallbackIN(struct libusb_transfer *xfr);
+  void CallbackIN(USBDevice::Xfr *x);
   /**
    * Callback function supplied to libusb for OUT transfers; transfer has
    * completed and requires attention.
    *
-   * @param  xfr     The transfer that has completed.
+   * @param  x       The transfer that has completed.
    */
-  void CallbackOUT(struct libusb_transfer *xfr);
+  void CallbackOUT(USBDevice::Xfr *x);
   /**
    * Stub callback function supplied to libusb for IN transfers.
    *
@@ -114,17 +135,17 @@ class USBDevIso : public USBDevStream {
   // Has this stream experienced a failure?
   bool failed_;
 
-  // Is an IN transfer in progress?
-  bool inActive_;
+  // IN transfers not presently in flight.
+  std::vector<USBDevice::Xfr *> freeIn_;
 
-  // Is an OUT transfer in progress?
-  bool outActive_;
+  // OUT transfers not presently in flight.
+  std::vector<USBDevice::Xfr *> freeOut_;
 
-  // Do we currently have an IN transfer?
-  struct libusb_transfer *xfrIn_;
+  // Number of IN transfers in flight.
+  unsigned inFlightIn_;
 
-  // Do we currently have an OUT transfer?
-  struct libusb_transfer *xfrOut_;
+  // Number of OUT transfers in flight.
+  unsigned inFlightOut_;
 
   // Maximum packet size for this stream.
   uint8_t maxPacketSize_;
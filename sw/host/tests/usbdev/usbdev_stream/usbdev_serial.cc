@@ -66,7 +66,9 @@ bool USBDevSerial::Resume() {
 }
 
 // Return a summary report of the stream settings of status.
-std::string USBDevSerial::Report(bool status, bool verbose) const { return ""; }
+std::string USBDevSerial::Report(bool status, bool verbose) const {
+  return status ? StatsReport(verbose) : "";
+}
 
 // Sending of OUT traffic to device.
 bool USBDevSerial::ServiceOUT() {
@@ -79,11 +81,16 @@ bool USBDevSerial::ServiceOUT() {
         std::cout << PrefixID() << "Trying to send " << to_send << "byte(s)"
                   << std::endl;
       }
-      // Propagate the modified bytes to the output port.
+      // Propagate the modified bytes to the output port; there are no
+      // transfers as such, so the statistics describe each write() call.
+      uint64_t submitted = time_us();
       nsent = send_bytes(out_, &buf_.data[buf_.rd_idx], to_send);
       if (nsent < 0) {
         return false;
       }
+      if (nsent > 0) {
+        StatsRecord(statsOut_, (uint32_t)nsent, submitted);
+      }
     } else {
       nsent = to_send;
     }
@@ -113,10 +120,14 @@ bool USBDevSerial::ServiceIN() {
   ssize_t nrecvd;
   if (!SigReceived() || retrieve_) {
     // Read as many bytes as we can from the input port.
+    uint64_t submitted = time_us();
     nrecvd = recv_bytes(in_, dp, to_fetch);
     if (nrecvd < 0) {
       return false;
     }
+    if (nrecvd > 0) {
+      StatsRecord(statsIn_, (uint32_t)nrecvd, submitted);
+    }
 
     // Update the circular buffer with the amount of data that we've written.
     CommitData(nrecvd);
@@ -43,6 +43,10 @@ class USBDevSerial : public USBDevStream {
    * @return Status report
    */
   virtual std::string Report(bool status = false, bool verbose = false) const;
+  /**
+   * Return the implementation type of this stream.
+   */
+  virtual StreamType Type() const { return StreamType_Serial; }
   /**
    * Service this serial stream.
    *
@@ -4,6 +4,7 @@
 #include "usbdev_stream.h"
 
 #include <cassert>
+#include <cinttypes>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
@@ -26,6 +27,28 @@
   (((lfsr) << 1) ^         \
    ((((lfsr) >> 1) ^ ((lfsr) >> 2) ^ ((lfsr) >> 3) ^ ((lfsr) >> 7)) & 1u))
 
+// Construct the LFSR tables used to generate and check kLfsrStep bytes of the
+// byte streams at a time.
+const USBDevStream::LfsrTables &USBDevStream::Lfsr() {
+  static const LfsrTables tables = [] {
+    LfsrTables t;
+    for (unsigned state = 0U; state < 0x100U; state++) {
+      uint8_t bytes[kLfsrStep];
+      uint8_t lfsr = (uint8_t)state;
+      for (unsigned idx = 0U; idx < kLfsrStep; idx++) {
+        bytes[idx] = lfsr;
+        lfsr = LFSR_ADVANCE(lfsr);
+      }
+      // Words are held in memory order, so that they may be compared directly
+      // against the received data irrespective of host endianness.
+      memcpy(&t.words[state], bytes, kLfsrStep);
+      t.next[state] = lfsr;
+    }
+    return t;
+  }();
+  return tables;
+}
+
 USBDevStream::USBDevStream(unsigned id, uint32_t transfer_bytes, bool retrieve,
                            bool check, bool send, bool verbose) {
   // Remember Stream IDentifier and flags.
@@ -53,6 +76,13 @@ USBDevStream::USBDevStream(unsigned id, uint32_t transfer_bytes, bool retrieve,
   // Total counts of bytes received and sent.
   bytes_recvd_ = 0U;
   bytes_sent_ = 0U;
+
+  // Single transfer in flight per direction by default.
+  depth_ = 1U;
+
+  // No transfers completed.
+  memset(&statsIn_, 0, sizeof(statsIn_));
+  memset(&statsOut_, 0, sizeof(statsOut_));
 }
 
 // Detect a stream signature within the byte stream;
@@ -66,6 +96,47 @@ uint32_t USBDevStream::SigDetect(usbdev_stream_sig_t *sig, const uint8_t *sp,
                                  uint32_t nrecv) {
   uint32_t dropped = 0U;
   assert(nrecv > 0);
+
+  // Whilst we are not part way through a signature, search for the first byte
+  // of the header and then attempt to match the entire signature at once.
+  // Signatures split across reads, or truncated, are left to the restartable
+  // parser below.
+  const uint8_t head0 = (uint8_t)STREAM_SIGNATURE_HEAD;
+  while (sig_recvd_ == kSigStateStart &&
+         nrecv >= sizeof(usbdev_stream_sig_t)) {
+    const uint8_t *hp = (const uint8_t *)memchr(sp, head0, nrecv);
+    uint32_t skip = hp ? (uint32_t)(hp - sp) : nrecv;
+    dropped += skip;
+    sp += skip;
+    nrecv -= skip;
+    if (nrecv < sizeof(usbdev_stream_sig_t)) {
+      break;
+    }
+    memcpy(sig, sp, sizeof(usbdev_stream_sig_t));
+    if (sig->head_sig == STREAM_SIGNATURE_HEAD &&
+        sig->tail_sig == STREAM_SIGNATURE_TAIL) {
+      // Same sanity checks as the parser below.
+      uint8_t stream = sig->stream & USBDevice::kUsbdevStreamFlagID;
+      if (sig->num_bytes > 0U && sig->num_bytes < 0x10000000U &&
+          stream < STREAMS_MAX) {
+        if (verbose_) {
+          std::cout << PrefixID() << "Signature accepted" << std::endl;
+        }
+        sig_recvd_ = kSigStateReceived;
+        return dropped;
+      }
+      std::cout << PrefixID() << "Signature rejected" << std::endl;
+      SigReport(*sig);
+    }
+    // Not a valid signature; skip this byte and keep searching.
+    dropped++;
+    sp++;
+    nrecv--;
+  }
+  if (!nrecv || sig_recvd_ == kSigStateReceived) {
+    return dropped;
+  }
+
   do {
     if (sig_recvd_ == kSigStateStart) {
       sig_recvd_ = kSigStateCheckHead;
@@ -174,8 +245,7 @@ void USBDevStream::SigProcess(const usbdev_stream_sig_t &sig) {
 void USBDevStream::SigReport(const usbdev_stream_sig_t &sig) {
   // Sequence number; important for unreliable packet-based streams
   // (Isochronous streams).
-  uint16_t seq = sig_read8(offsetof(usbdev_stream_sig_t, seq_lo)) |
-                 (sig_read8(offsetof(usbdev_stream_sig_t, seq_hi)) << 8);
+  uint16_t seq = sig.seq_lo | (sig.seq_hi << 8);
 
   // Stream IDentifier and flags.
   uint8_t stream = sig.stream & USBDevice::kUsbdevStreamFlagID;
@@ -236,6 +306,17 @@ uint32_t USBDevStream::SpaceAvailable(uint8_t **space) {
   return space_bytes;
 }
 
+uint32_t USBDevStream::FreeSpace() const {
+  uint32_t used_bytes;
+  if (buf_.wr_idx >= buf_.rd_idx) {
+    used_bytes = buf_.wr_idx - buf_.rd_idx;
+  } else {
+    used_bytes = (buf_.end_idx - buf_.rd_idx) + buf_.wr_idx;
+  }
+  // Leave one unused byte to distinguish between full and empty.
+  return kBufferSize - 1U - used_bytes;
+}
+
 bool USBDevStream::AddData(const uint8_t *data, uint32_t len) {
   // Ascertain the amount of space available.
   uint32_t space_bytes = SpaceAvailable(nullptr);
@@ -269,9 +350,16 @@ bool USBDevStream::AddData(const uint8_t *data, uint32_t len) {
 void USBDevStream::GenerateData(uint8_t *dp, uint32_t len) {
   // Generate a stream of bytes _as if_ we'd received them correctly from
   // the device
+  const LfsrTables &t = Lfsr();
   uint8_t next_lfsr = tst_lfsr_;
-  for (unsigned idx = 0U; idx < len; idx++) {
-    dp[idx] = next_lfsr;
+  while (len >= kLfsrStep) {
+    memcpy(dp, &t.words[next_lfsr], kLfsrStep);
+    next_lfsr = t.next[next_lfsr];
+    dp += kLfsrStep;
+    len -= kLfsrStep;
+  }
+  while (len-- > 0U) {
+    *dp++ = next_lfsr;
     next_lfsr = LFSR_ADVANCE(next_lfsr);
   }
 }
@@ -292,14 +380,36 @@ bool USBDevStream::ProcessData(uint8_t *dp, uint32_t len) {
                 << " byte(s)" << std::endl;
     }
 
-    // We can just check and overwrite the input data in-situ.
+    // We can just check and overwrite the input data in-situ, a word at a
+    // time; any mismatched word, and verbose reporting, is handled by the
+    // byte-wise loop below.
+    const LfsrTables &t = Lfsr();
+    const bool checking = retrieve_ && check_;
+    uint32_t idx = 0U;
+    if (!verbose_) {
+      for (; len - idx >= kLfsrStep; idx += kLfsrStep) {
+        uint64_t recvd;
+        memcpy(&recvd, &dp[idx], kLfsrStep);
+        if (checking && recvd != t.words[tst_lfsr_]) {
+          break;
+        }
+        // Simply XOR the two LFSR-generated streams together.
+        recvd ^= t.words[dpi_lfsr_];
+        memcpy(&dp[idx], &recvd, kLfsrStep);
+
+        // Advance our LFSRs.
+        tst_lfsr_ = t.next[tst_lfsr_];
+        dpi_lfsr_ = t.next[dpi_lfsr_];
+      }
+    }
+
     const uint8_t *sp = dp;
-    for (uint32_t idx = 0U; idx < len; idx++) {
+    for (; idx < len; idx++) {
       uint8_t expected = tst_lfsr_;
       uint8_t recvd = sp[idx];
 
       // Check whether the received byte is as expected.
-      if (retrieve_ && check_) {
+      if (checking) {
         if (recvd != expected) {
           printf("S%u: Mismatched data from device 0x%02x, expected 0x%02x\n",
                  id_, recvd, expected);
@@ -381,6 +491,109 @@ void USBDevStream::ClearBuffer() {
   buf_.rd_idx = buf_.wr_idx;
 }
 
+void USBDevStream::StatsRecord(XfrStats &stats, uint32_t len,
+                               uint64_t submitted) {
+  uint64_t now = time_us();
+  uint32_t latency = (uint32_t)(now - submitted);
+  if (!stats.count) {
+    stats.first_us = now;
+    stats.min_us = latency;
+  }
+  stats.count++;
+  stats.hist[StatsBucket(latency)]++;
+  stats.bytes += len;
+  stats.total_us += latency;
+  if (latency < stats.min_us) {
+    stats.min_us = latency;
+  }
+  if (latency > stats.max_us) {
+    stats.max_us = latency;
+  }
+  stats.last_us = now;
+}
+
+std::string USBDevStream::StatsReport(bool verbose) const {
+  std::string s;
+  const XfrStats *stats[] = {&statsIn_, &statsOut_};
+  const char *dir[] = {"IN ", "OUT"};
+  for (unsigned idx = 0U; idx < 2U; idx++) {
+    const XfrStats &st = *stats[idx];
+    char line[200];
+    if (!st.count) {
+      snprintf(line, sizeof(line), "S%u: %s no transfers\n", id_, dir[idx]);
+    } else {
+      // Throughput is measured from the first completion to the last, so
+      // that any delay in the device starting to stream is excluded.
+      uint64_t interval = st.last_us - st.first_us;
+      double kbps = interval ? (st.bytes * 1e6 / 1024.0) / interval : 0.0;
+      snprintf(line, sizeof(line),
+               "S%u: %s %u xfrs %" PRIu64 " bytes %.1lf KiB/s latency (us) "
+               "min %u avg %" PRIu64 " p50 %u p99 %u max %u\n",
+               id_, dir[idx], st.count, st.bytes, kbps, st.min_us,
+               st.total_us / st.count, StatsPercentile(st, 50U),
+               StatsPercentile(st, 99U), st.max_us);
+      if (verbose) {
+        s += line;
+        snprintf(line, sizeof(line), "S%u: %s depth %u max in flight %u\n",
+                 id_, dir[idx], depth_, st.max_in_flight);
+      }
+    }
+    s += line;
+  }
+  return s;
+}
+
+unsigned USBDevStream::StatsBucket(uint32_t us) {
+  if (us < 8U) {
+    return us;
+  }
+  unsigned octave = 31U - __builtin_clz(us);
+  return ((octave - 2U) << 3) | ((us >> (octave - 3U)) & 7U);
+}
+
+uint32_t USBDevStream::StatsPercentile(const XfrStats &stats, unsigned pc) {
+  // Rank of the required sample, rounded up.
+  uint64_t rank = ((uint64_t)stats.count * pc + 99U) / 100U;
+  uint64_t seen = 0U;
+  for (unsigned b = 0U; b < kStatsBuckets; b++) {
+    seen += stats.hist[b];
+    if (seen && seen >= rank) {
+      if (b < 8U) {
+        return b;
+      }
+      // Upper bound of the bucket, but no more than the observed maximum.
+      unsigned sh = (b >> 3) - 1U;
+      uint64_t upper = ((uint64_t)((b & 7U) | 8U) << sh) + (1U << sh) - 1U;
+      return (upper < stats.max_us) ? (uint32_t)upper : stats.max_us;
+    }
+  }
+  return stats.max_us;
+}
+
+std::string USBDevStream::StatsJSON() const {
+  std::string s;
+  char text[200];
+  snprintf(text, sizeof(text), "{\"stream\": %u, \"type\": \"%s\", ", id_,
+           StreamTypeName(Type()));
+  s += text;
+  const XfrStats *stats[] = {&statsIn_, &statsOut_};
+  const char *dir[] = {"in", "out"};
+  for (unsigned idx = 0U; idx < 2U; idx++) {
+    const XfrStats &st = *stats[idx];
+    uint64_t interval = st.last_us - st.first_us;
+    double kbps = interval ? (st.bytes * 1e6 / 1024.0) / interval : 0.0;
+    snprintf(text, sizeof(text),
+             "\"%s\": {\"xfrs\": %u, \"bytes\": %" PRIu64
+             ", \"kib_per_s\": %.1lf, \"min_us\": %u, \"p50_us\": %u, "
+             "\"p99_us\": %u, \"max_us\": %u}%s",
+             dir[idx], st.count, st.bytes, kbps, st.count ? st.min_us : 0U,
+             StatsPercentile(st, 50U), StatsPercentile(st, 99U), st.max_us,
+             idx ? "}" : ", ");
+    s += text;
+  }
+  return s;
+}
+
 // Service the given data stream; this base class implementation just provides
 // some generic progress reporting.
 bool USBDevStream::Service() {
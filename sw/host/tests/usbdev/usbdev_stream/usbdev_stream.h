@@ -99,7 +99,7 @@ class USBDevStream {
   /**
    * Return a Stream IDentifier prefix suitable for logging/reporting.
    */
-  std::string PrefixID() {
+  std::string PrefixID() const {
     std::string s("S");
     s += std::to_string(id_);
     s += ": ";
@@ -114,6 +114,39 @@ class USBDevStream {
    */
   virtual std::string Report(bool status = false,
                              bool verbose = false) const = 0;
+  /**
+   * Return the implementation type of this stream.
+   */
+  virtual StreamType Type() const = 0;
+  /**
+   * Return a JSON object describing the throughput and latency distribution
+   * of each direction, for benchmarking.
+   *
+   * @return JSON text.
+   */
+  std::string StatsJSON() const;
+  /**
+   * Set the number of transfers that may be in flight in each direction;
+   * this must be set before the stream is opened.
+   *
+   * @param  depth   Number of concurrent transfers per direction.
+   */
+  void SetQueueDepth(unsigned depth) {
+    if (depth < 1U) {
+      depth = 1U;
+    } else if (depth > kMaxQueueDepth) {
+      depth = kMaxQueueDepth;
+    }
+    depth_ = depth;
+  }
+  /**
+   * Returns the number of transfers that may be in flight in each direction.
+   */
+  unsigned QueueDepth() const { return depth_; }
+  /**
+   * Maximum number of transfers that may be in flight in each direction.
+   */
+  static constexpr unsigned kMaxQueueDepth = 32U;
   /**
    * Set Stream IDentifier and flags.
    */
@@ -272,7 +305,7 @@ class USBDevStream {
   void SigReport(const usbdev_stream_sig_t &sig);
   /**
    * Generate a sequence of bytes _as if_ we'd received them correctly from the
-   * device.
+   * device; this does not advance the LFSR state.
    */
   void GenerateData(uint8_t *dp, uint32_t len);
   /**
@@ -306,49 +339,121 @@ class USBDevStream {
   bool ConsumeData(uint32_t len);
 
   /**
-   * Size of circular buffer used for streaming.
+   * Returns the total amount of free space in the circular buffer, which
+   * may not be contiguous.
+   *
+   * @return The free space available (in bytes).
    */
-  static constexpr uint32_t kBufferSize = 0x10000U;
+  uint32_t FreeSpace() const;
 
-  // Utility function for collecting a byte from the stream signature, handling
-  // wrap around at the end of the circular buffer.
-  inline uint8_t sig_read8(size_t offset) {
-    uint32_t rd_idx = buf_.rd_idx + offset;
-    if (rd_idx >= kBufferSize) {
-      rd_idx -= kBufferSize;
+  /**
+   * Number of buckets in each latency histogram.
+   */
+  static constexpr unsigned kStatsBuckets = 240U;
+  /**
+   * Transfer statistics for one direction of the stream.
+   */
+  struct XfrStats {
+    /**
+     * Number of transfers completed.
+     */
+    uint32_t count;
+    /**
+     * Number of bytes transferred.
+     */
+    uint64_t bytes;
+    /**
+     * Sum, minimum and maximum of submission-to-completion latencies, in
+     * microseconds.
+     */
+    uint64_t total_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    /**
+     * Time of first and most recent completion.
+     */
+    uint64_t first_us;
+    uint64_t last_us;
+    /**
+     * Maximum number of transfers observed in flight.
+     */
+    unsigned max_in_flight;
+    /**
+     * Histogram of latencies; see StatsBucket().
+     */
+    uint32_t hist[kStatsBuckets];
+  };
+  /**
+   * Record the submission of a transfer.
+   *
+   * @param  stats      Statistics to be updated.
+   * @param  in_flight  Number of transfers now in flight.
+   */
+  static void StatsSubmit(XfrStats &stats, unsigned in_flight) {
+    if (in_flight > stats.max_in_flight) {
+      stats.max_in_flight = in_flight;
     }
-    return buf_.data[rd_idx];
   }
+  /**
+   * Record the completion of a transfer.
+   *
+   * @param  stats      Statistics to be updated.
+   * @param  len        Number of bytes transferred.
+   * @param  submitted  Time of submission, in microseconds.
+   */
+  static void StatsRecord(XfrStats &stats, uint32_t len, uint64_t submitted);
+  /**
+   * Return a textual report of the throughput and latency of each direction.
+   *
+   * @param  verbose   true iff a more verbose report is required.
+   * @return Statistics report.
+   */
+  std::string StatsReport(bool verbose) const;
+  /**
+   * Return the histogram bucket for the given latency. Latencies below 8us
+   * are recorded exactly, and thereafter each power of two is divided into
+   * eight buckets, giving a resolution of better than 12.5%.
+   *
+   * @param  us        Latency in microseconds.
+   * @return Bucket number.
+   */
+  static unsigned StatsBucket(uint32_t us);
+  /**
+   * Return an estimate of the given percentile of the recorded latencies;
+   * this is the upper bound of the histogram bucket in which it lies.
+   *
+   * @param  stats     Statistics.
+   * @param  pc        Percentile required (1-100).
+   * @return Latency in microseconds.
+   */
+  static uint32_t StatsPercentile(const XfrStats &stats, unsigned pc);
 
-  // Utility function for collecting a 16-bit word from the stream signature,
-  // handling wrap around at the end of the circular buffer.
-  inline uint16_t sig_read16(size_t offset) {
-    uint32_t rd_idx = buf_.rd_idx + offset;
-    if (rd_idx >= kBufferSize) {
-      rd_idx -= kBufferSize;
-    }
-    uint16_t d = buf_.data[rd_idx++];
-    if (rd_idx >= kBufferSize) {
-      rd_idx -= kBufferSize;
-    }
-    return d | (buf_.data[rd_idx++] << 8);
-  }
+  /**
+   * Size of circular buffer used for streaming.
+   */
+  static constexpr uint32_t kBufferSize = 0x10000U;
+  /**
+   * Number of LFSR output bytes generated/checked at a time.
+   */
+  static constexpr unsigned kLfsrStep = 8U;
+  /**
+   * Precomputed LFSR tables, indexed by the current LFSR state.
+   */
+  struct LfsrTables {
+    /**
+     * Next kLfsrStep output bytes, in memory order.
+     */
+    uint64_t words[0x100U];
+    /**
+     * LFSR state after kLfsrStep advances.
+     */
+    uint8_t next[0x100U];
+  };
+  /**
+   * Return the LFSR tables, constructing them on first use.
+   */
+  static const LfsrTables &Lfsr();
 
-  // Utility function for collecting a 32-bit word from the stream signature,
-  // handling wrap around at the end of the circular buffer.
-  inline uint32_t sig_read32(size_t offset) {
-    uint32_t rd_idx = buf_.rd_idx + offset;
-    unsigned n = 4U;
-    uint32_t d = 0U;
-    while (n-- > 0U) {
-      if (rd_idx >= kBufferSize) {
-        rd_idx -= kBufferSize;
-      }
-      // Transmission of multi-byte value is little endian.
-      d = (d >> 8) | (buf_.data[rd_idx++] << 24);
-    }
-    return d;
-  }
   /**
    * Stream IDentifier.
    */
@@ -398,6 +503,15 @@ class USBDevStream {
    * Number of bytes to be transferred.
    */
   uint32_t transfer_bytes_;
+  /**
+   * Number of transfers that may be in flight in each direction.
+   */
+  unsigned depth_;
+  /**
+   * Statistics for IN and OUT transfers.
+   */
+  XfrStats statsIn_;
+  XfrStats statsOut_;
   /**
    * Circular buffer of streamed data.
    */